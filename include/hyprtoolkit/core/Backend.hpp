@@ -12,6 +12,7 @@
 
 #include "LogTypes.hpp"
 #include "SessionLock.hpp"
+#include "Prefetch.hpp"
 #include "../palette/Palette.hpp"
 
 #include "CoreMacros.hpp"
@@ -96,6 +97,37 @@ namespace Hyprtoolkit {
         */
         virtual std::expected<Hyprutils::Memory::CSharedPointer<ISessionLockState>, eSessionLockError> aquireSessionLock() = 0;
 
+        // newer than the above, kept after them so that their vtable slots don't move
+
+        /*
+            Start loading something that's about to be shown, e.g. the next page of a list,
+            so that it's ready once an element shows it. Done when idle, at the lowest priority.
+            Icons need a size.
+        */
+        virtual void prefetch(const SPrefetchRequest& request) = 0;
+
+        struct SGPUMemoryStats {
+            size_t textures = 0, bytes = 0;
+            size_t limit    = 0; // 0 for none
+        };
+
+        /*
+            Gpu memory taken by textures, including storage kept around for reuse.
+        */
+        virtual SGPUMemoryStats gpuMemory() = 0;
+
+        /*
+            Past this, textures nothing draws are let go of. 0 for no limit.
+            Overrides gpu_memory_limit_mb until the config is reloaded.
+        */
+        virtual void setGPUMemoryLimit(size_t bytes) = 0;
+
+        /*
+            Run fn, holding back what its changes redraw until it returns: each window then gets
+            one merged damage region and one frame, laid out once. Can be nested, the outermost one lets go.
+        */
+        virtual void batch(const std::function<void()>& fn) = 0;
+
         struct {
             /*
                 Get notified when a new output was added.
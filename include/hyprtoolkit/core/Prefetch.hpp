@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <hyprutils/math/Vector2D.hpp>
+
+#include "../types/FontTypes.hpp"
+#include "../types/ImageTypes.hpp"
+
+namespace Hyprtoolkit {
+
+    /*
+        Something that's about to be shown, see IBackend::prefetch().
+        It should describe it the way the element showing it will, so that both end up on the same cache entries.
+    */
+    struct SPrefetchRequest {
+        enum eType : uint8_t {
+            HT_PREFETCH_IMAGE = 0, // source is a path, or data is set
+            HT_PREFETCH_ICON,      // source is an icon name for the system icon theme
+            HT_PREFETCH_TEXT,      // source is the text
+        };
+
+        eType                     type = HT_PREFETCH_IMAGE;
+        std::string               source;
+
+        // images only: the encoded image, used instead of source if set
+        std::vector<uint8_t>      data;
+        eImageFitMode             fitMode = IMAGE_FIT_MODE_STRETCH;
+
+        // logical size it'll be shown at. 0x0 for an image shown at its own size (an auto size).
+        Hyprutils::Math::Vector2D size;
+
+        // of the window it'll be shown in
+        float                     scale = 1.F;
+
+        // text only. An empty family is the palette's.
+        std::string               fontFamily;
+        CFontSize                 fontSize{CFontSize::HT_FONT_TEXT};
+    };
+};
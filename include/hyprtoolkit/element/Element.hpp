@@ -77,7 +77,8 @@ namespace Hyprtoolkit {
 
         HT_HIDDEN :
 
-            /* Sizes for auto positioning in layouts */
+            /* Sizes for auto positioning in layouts. parent is the space offered: what grows taller when narrower,
+               like wrapping text, answers for parent's width, so it's laid out in one pass (height for width) */
             virtual std::optional<Hyprutils::Math::Vector2D>
                                                          preferredSize(const Hyprutils::Math::Vector2D& parent);
         virtual std::optional<Hyprutils::Math::Vector2D> minimumSize(const Hyprutils::Math::Vector2D& parent);
@@ -99,6 +100,18 @@ namespace Hyprtoolkit {
 
         Hyprutils::Memory::CUniquePointer<SElementInternalData> impl;
 
+      public:
+        // declared last, the virtuals above keep their vtable slots
+
+        /*
+            How this element and everything in it is drawn, on top of where it's laid out. Doesn't lay anything out again,
+            nor moves where it gets mouse input. Scale and rotation (radians) are around its center. Animated, unless animate is false.
+        */
+        virtual void setRenderTranslate(const Hyprutils::Math::Vector2D& offset, bool animate = true);
+        virtual void setRenderScale(float scale, bool animate = true);
+        virtual void setRenderRotation(float radians, bool animate = true);
+        virtual void setOpacity(float opacity, bool animate = true);
+
       protected:
         IElement();
     };
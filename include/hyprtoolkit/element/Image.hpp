@@ -14,6 +14,7 @@ namespace Hyprtoolkit {
     struct SImageData;
     class CImageElement;
     class ISystemIconDescription;
+    class CPrefetcher;
 
     class CImageBuilder {
       public:
@@ -48,8 +49,7 @@ namespace Hyprtoolkit {
         Hyprutils::Memory::CSharedPointer<CImageBuilder> rebuild();
         virtual Hyprutils::Math::Vector2D                size();
 
-      private:
-        CImageElement(const SImageData& data);
+        HT_HIDDEN : CImageElement(const SImageData& data);
         static Hyprutils::Memory::CSharedPointer<CImageElement> create(const SImageData& data);
 
         void                                                    replaceData(const SImageData& data);
@@ -67,5 +67,7 @@ namespace Hyprtoolkit {
         Hyprutils::Memory::CUniquePointer<SImageImpl>    m_impl;
 
         friend class CImageBuilder;
+        friend class CPrefetcher;
+        friend struct SImageImpl;
     };
 };
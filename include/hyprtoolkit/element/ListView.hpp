@@ -0,0 +1,80 @@
+#pragma once
+
+#include <functional>
+
+#include "Element.hpp"
+#include "../types/SizeType.hpp"
+
+namespace Hyprtoolkit {
+
+    struct SListViewImpl;
+    struct SListViewData;
+    class CListViewElement;
+
+    // Where a list view gets its items from. Items are elements made by create(), and reused: bind() shows
+    // the item at an index in one, unbind() is called before it's reused for another or let go.
+    struct SListViewDataSource {
+        std::function<size_t()>                                                    count;
+        std::function<Hyprutils::Memory::CSharedPointer<IElement>()>               create;
+        std::function<void(Hyprutils::Memory::CSharedPointer<IElement>, size_t)> bind;
+        std::function<void(Hyprutils::Memory::CSharedPointer<IElement>, size_t)> unbind; // optional
+    };
+
+    // A list, or with more than one column a grid, of any number of items, meant to be put in a scroll area.
+    // Only the rows visible in the parent, plus some overscan, have elements. Rows are laid out at the estimated
+    // height until their items are measured, and the scroll area is kept where it was when estimates are corrected.
+    class CListViewBuilder {
+      public:
+        ~CListViewBuilder() = default;
+
+        static Hyprutils::Memory::CSharedPointer<CListViewBuilder> begin();
+        Hyprutils::Memory::CSharedPointer<CListViewBuilder>        source(SListViewDataSource&&);
+        Hyprutils::Memory::CSharedPointer<CListViewBuilder>        estimatedHeight(float); // of a row not measured yet
+        Hyprutils::Memory::CSharedPointer<CListViewBuilder>        columns(size_t);
+        Hyprutils::Memory::CSharedPointer<CListViewBuilder>        gap(size_t);
+        Hyprutils::Memory::CSharedPointer<CListViewBuilder>        overscan(size_t); // rows with elements above and below the visible ones
+        Hyprutils::Memory::CSharedPointer<CListViewBuilder>        size(CDynamicSize&&);
+
+        Hyprutils::Memory::CSharedPointer<CListViewElement>        commence();
+
+      private:
+        Hyprutils::Memory::CWeakPointer<CListViewBuilder> m_self;
+        Hyprutils::Memory::CUniquePointer<SListViewData>  m_data;
+        Hyprutils::Memory::CWeakPointer<CListViewElement> m_element;
+
+        CListViewBuilder() = default;
+
+        friend class CListViewElement;
+    };
+
+    class CListViewElement : public IElement {
+      public:
+        virtual ~CListViewElement();
+
+        Hyprutils::Memory::CSharedPointer<CListViewBuilder> rebuild();
+        virtual Hyprutils::Math::Vector2D                   size();
+
+        // the source's items changed, bind everything again
+        void                                                reload();
+
+        // scrolls the parent scroll area to the item's row
+        void                                                scrollToItem(size_t idx);
+
+      private:
+        CListViewElement(const SListViewData& data);
+        static Hyprutils::Memory::CSharedPointer<CListViewElement> create(const SListViewData& data);
+
+        void                                                       replaceData(const SListViewData& data);
+
+        virtual void                                               paint();
+        virtual void                                               reposition(const Hyprutils::Math::CBox& box, const Hyprutils::Math::Vector2D& maxSize = {-1, -1});
+        virtual std::optional<Hyprutils::Math::Vector2D>           preferredSize(const Hyprutils::Math::Vector2D& parent);
+        virtual std::optional<Hyprutils::Math::Vector2D>           minimumSize(const Hyprutils::Math::Vector2D& parent);
+        virtual std::optional<Hyprutils::Math::Vector2D>           maximumSize(const Hyprutils::Math::Vector2D& parent);
+        virtual bool                                               positioningDependsOnChild();
+
+        Hyprutils::Memory::CUniquePointer<SListViewImpl>           m_impl;
+
+        friend class CListViewBuilder;
+    };
+};
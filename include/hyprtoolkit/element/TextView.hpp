@@ -0,0 +1,68 @@
+#pragma once
+
+#include "Element.hpp"
+#include "../types/SizeType.hpp"
+#include "../palette/Color.hpp"
+#include "../types/FontTypes.hpp"
+
+namespace Hyprtoolkit {
+
+    struct STextViewImpl;
+    struct STextViewData;
+    class CTextViewElement;
+
+    // Read-only view of a large plain text (e.g. a log file), meant to be put in a scroll area.
+    // Only the lines visible in the parent, plus some overscan, are shaped and rendered.
+    class CTextViewBuilder {
+      public:
+        ~CTextViewBuilder() = default;
+
+        static Hyprutils::Memory::CSharedPointer<CTextViewBuilder> begin();
+        Hyprutils::Memory::CSharedPointer<CTextViewBuilder>        path(std::string&&); // mmap'd, takes precedence over text()
+        Hyprutils::Memory::CSharedPointer<CTextViewBuilder>        text(std::string&&);
+        Hyprutils::Memory::CSharedPointer<CTextViewBuilder>        color(colorFn&&);
+        Hyprutils::Memory::CSharedPointer<CTextViewBuilder>        fontSize(CFontSize&&);
+        Hyprutils::Memory::CSharedPointer<CTextViewBuilder>        fontFamily(std::string&&);
+        Hyprutils::Memory::CSharedPointer<CTextViewBuilder>        overscan(size_t);  // lines rendered above and below the visible ones
+        Hyprutils::Memory::CSharedPointer<CTextViewBuilder>        cacheSize(size_t); // max rendered lines kept around
+        Hyprutils::Memory::CSharedPointer<CTextViewBuilder>        size(CDynamicSize&&);
+
+        Hyprutils::Memory::CSharedPointer<CTextViewElement>        commence();
+
+      private:
+        Hyprutils::Memory::CWeakPointer<CTextViewBuilder> m_self;
+        Hyprutils::Memory::CUniquePointer<STextViewData>  m_data;
+        Hyprutils::Memory::CWeakPointer<CTextViewElement> m_element;
+
+        CTextViewBuilder() = default;
+
+        friend class CTextViewElement;
+    };
+
+    class CTextViewElement : public IElement {
+      public:
+        virtual ~CTextViewElement();
+
+        Hyprutils::Memory::CSharedPointer<CTextViewBuilder> rebuild();
+        virtual Hyprutils::Math::Vector2D                   size();
+
+        size_t                                              lines();
+
+        HT_HIDDEN : CTextViewElement(const STextViewData& data);
+        static Hyprutils::Memory::CSharedPointer<CTextViewElement> create(const STextViewData& data);
+
+        void                                                       replaceData(const STextViewData& data);
+
+        virtual void                                               paint();
+        virtual void                                               reposition(const Hyprutils::Math::CBox& box, const Hyprutils::Math::Vector2D& maxSize = {-1, -1});
+        virtual std::optional<Hyprutils::Math::Vector2D>           preferredSize(const Hyprutils::Math::Vector2D& parent);
+        virtual std::optional<Hyprutils::Math::Vector2D>           minimumSize(const Hyprutils::Math::Vector2D& parent);
+        virtual std::optional<Hyprutils::Math::Vector2D>           maximumSize(const Hyprutils::Math::Vector2D& parent);
+        virtual bool                                               positioningDependsOnChild();
+        virtual void                                               recheckColor();
+
+        Hyprutils::Memory::CUniquePointer<STextViewImpl>           m_impl;
+
+        friend class CTextViewBuilder;
+    };
+};
@@ -66,6 +66,9 @@ namespace Hyprtoolkit {
         virtual void                      open()      = 0;
         virtual Hyprutils::Math::Vector2D cursorPos() = 0;
 
+        // gpu memory of the textures this window drew last
+        virtual size_t gpuBytes() = 0;
+
         struct {
             // coordinates here are logical, meaning pixel size is this * scale()
             Hyprutils::Signal::CSignalT<Hyprutils::Math::Vector2D> resized;
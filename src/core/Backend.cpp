@@ -2,6 +2,7 @@
 #include <hyprtoolkit/core/Backend.hpp>
 #include <hyprtoolkit/core/Timer.hpp>
 #include <hyprtoolkit/palette/Palette.hpp>
+#include <hyprutils/utils/ScopeGuard.hpp>
 
 #include "InternalBackend.hpp"
 #include "AnimationManager.hpp"
@@ -16,12 +17,16 @@
 #include "../element/Element.hpp"
 #include "../palette/ConfigManager.hpp"
 #include "../system/Icons.hpp"
+#include "../system/Fonts.hpp"
 #include "../sessionLock/WaylandSessionLock.hpp"
+#include "../resource/prefetch/Prefetcher.hpp"
+#include "../renderer/TextureRegistry.hpp"
 
 #include <sys/wait.h>
 #include <sys/poll.h>
 
 #include <print>
+#include <chrono>
 #include <unistd.h>
 
 #if defined(__FreeBSD__)
@@ -62,11 +67,19 @@ CBackend::CBackend() {
 CBackend::~CBackend() {
     destroy();
 
+    // holds loads, which go before the scheduler
+    g_prefetcher.reset();
+
+    // first, its workers can still call into everything else
+    g_decodeScheduler.reset();
+
     g_openGL.reset();
     g_renderer.reset();
     g_config.reset();
     g_palette.reset();
     g_iconFactory.reset();
+    g_fontManager.reset();
+    g_imageDiskCache.reset();
     g_waylandPlatform.reset();
     g_logger.reset();
 
@@ -89,27 +102,44 @@ SP<IBackend> IBackend::create() {
     if (g_backend)
         return nullptr;
 
+    // first, so that fontconfig can initialize in the background while we set up everything else
+    if (!g_fontManager)
+        g_fontManager = makeShared<CFontManager>();
+
     if (!g_logger)
         g_logger = makeShared<CLogger>();
 
+    auto       phaseBegin = std::chrono::steady_clock::now();
+    const auto PHASE_DONE = [&phaseBegin](const char* phase) {
+        const auto NOW = std::chrono::steady_clock::now();
+        g_logger->log(HT_LOG_DEBUG, "startup: {} took {:.2f}ms", phase, std::chrono::duration<float, std::milli>(NOW - phaseBegin).count());
+        phaseBegin = NOW;
+    };
+
     g_backend = SP<CBackend>(new CBackend());
-    g_config  = makeShared<CConfigManager>();
+    PHASE_DONE("backend");
+    g_config = makeShared<CConfigManager>();
     g_config->parse();
     g_palette     = CPalette::palette();
     g_iconFactory = SP<CSystemIconFactory>(new CSystemIconFactory());
+    PHASE_DONE("config, palette and icons");
     if (!g_backend->m_aqBackend || !g_backend->m_aqBackend->start()) {
         g_logger->log(HT_LOG_ERROR, "couldn't start aq backend");
         g_backend.reset();
         return nullptr;
     }
+    PHASE_DONE("aquamarine");
     g_waylandPlatform = makeUnique<CWaylandPlatform>();
     if (!g_waylandPlatform->attempt()) {
         g_waylandPlatform = nullptr;
         g_backend.reset();
         return nullptr;
     }
+    PHASE_DONE("wayland");
     g_openGL   = makeShared<COpenGLRenderer>(g_waylandPlatform->m_drmState.fd);
     g_renderer = g_openGL;
+    PHASE_DONE("renderer");
+    g_prefetcher = makeShared<CPrefetcher>();
 
     return g_backend;
 };
@@ -195,6 +225,51 @@ void CBackend::addIdle(const std::function<void()>& fn) {
     m_sLoopState.idleCV.notify_all();
 }
 
+void CBackend::batch(const std::function<void()>& fn) {
+    m_batchDepth++;
+
+    Hyprutils::Utils::CScopeGuard x([this] {
+        if (--m_batchDepth > 0)
+            return;
+
+        // letting go can't batch anything new, but a window might go away meanwhile
+        const auto WINDOWS = std::move(m_batchedWindows);
+        m_batchedWindows.clear();
+
+        for (const auto& w : WINDOWS) {
+            if (w)
+                w->endBatch();
+        }
+    });
+
+    fn();
+}
+
+bool CBackend::batching() const {
+    return m_batchDepth > 0;
+}
+
+void CBackend::batched(WP<IToolkitWindow> window) {
+    if (std::ranges::none_of(m_batchedWindows, [&window](const auto& w) { return w.get() == window.get(); }))
+        m_batchedWindows.emplace_back(window);
+}
+
+void CBackend::prefetch(const SPrefetchRequest& request) {
+    addIdle([request] {
+        if (g_prefetcher)
+            g_prefetcher->prefetch(request);
+    });
+}
+
+IBackend::SGPUMemoryStats CBackend::gpuMemory() {
+    const auto STATS = textureRegistry()->stats();
+    return SGPUMemoryStats{.textures = STATS.textures, .bytes = STATS.bytes, .limit = STATS.limit};
+}
+
+void CBackend::setGPUMemoryLimit(size_t bytes) {
+    textureRegistry()->setLimit(bytes);
+}
+
 void CBackend::terminate() {
     if (m_terminate)
         return;
@@ -233,6 +308,7 @@ static void reloadRecurse(SP<IElement> el) {
             continue;
 
         e->recheckColor();
+        e->impl->resetMeasureCache(); // font sizes might differ
 
         reloadRecurse(e);
     }
@@ -13,6 +13,7 @@ namespace Hyprtoolkit {
     class CPalette;
     class CConfigManager;
     class CSystemIconFactory;
+    class IToolkitWindow;
 
     class CBackend : public IBackend {
       public:
@@ -26,9 +27,13 @@ namespace Hyprtoolkit {
         virtual SP<ISystemIconFactory> systemIcons();
         virtual ASP<CTimer> addTimer(const std::chrono::system_clock::duration& timeout, std::function<void(ASP<CTimer> self, void* data)> cb_, void* data, bool force = false);
         virtual void        addIdle(const std::function<void()>& fn);
+        virtual void        batch(const std::function<void()>& fn);
+        virtual void        prefetch(const SPrefetchRequest& request);
         virtual void        enterLoop();
         virtual std::vector<SP<IOutput>>                                getOutputs();
         virtual SP<CPalette>                                            getPalette();
+        virtual SGPUMemoryStats                                         gpuMemory();
+        virtual void                                                    setGPUMemoryLimit(size_t bytes);
         virtual std::expected<SP<ISessionLockState>, eSessionLockError> aquireSessionLock();
 
         // ======================= Internal fns ======================= //
@@ -43,6 +48,10 @@ namespace Hyprtoolkit {
 
         SP<IWindow> openWindow(const SWindowCreationData& data);
 
+        // inside batch(): windows hold their damage and frames, and get let go of when it ends
+        bool        batching() const;
+        void        batched(WP<IToolkitWindow> window);
+
         //
 
         std::vector<pollfd>                                     m_pollfds;
@@ -89,5 +98,8 @@ namespace Hyprtoolkit {
 
         std::vector<Hyprutils::Memory::CAtomicSharedPointer<CTimer>>                m_timers;
         std::vector<Hyprutils::Memory::CAtomicSharedPointer<std::function<void()>>> m_idles;
+
+        size_t                                                                      m_batchDepth = 0;
+        std::vector<WP<IToolkitWindow>>                                             m_batchedWindows;
     };
 }
@@ -3,8 +3,18 @@
 #include <cstdint>
 #include <string>
 
+#include <hyprutils/math/Vector2D.hpp>
+
 #include <hyprtoolkit/core/Input.hpp>
 
 namespace Hyprtoolkit::Input {
     eMouseButton buttonFromWayland(uint32_t wl);
-}
\ No newline at end of file
+
+    // the scrolling of one pointer frame
+    struct SAxisFrame {
+        Hyprutils::Math::Vector2D delta;
+        uint32_t                  time   = 0;     // ms
+        bool                      finger = false; // a touchpad, it can fling
+        bool                      stop   = false; // the fingers lifted
+    };
+}
@@ -13,10 +13,21 @@ namespace Hyprtoolkit {
     class CPalette;
     class CConfigManager;
     class CSystemIconFactory;
+    class CFontManager;
+    class CPrefetcher;
+
+    namespace Asset {
+        class CImageDiskCache;
+        class CDecodeScheduler;
+    }
 
     inline Hyprutils::Memory::CSharedPointer<Hyprtoolkit::CBackend>                g_backend;
     inline Hyprutils::Memory::CSharedPointer<Hyprgraphics::CAsyncResourceGatherer> g_asyncResourceGatherer;
     inline Hyprutils::Memory::CSharedPointer<CPalette>                             g_palette;
     inline Hyprutils::Memory::CSharedPointer<CConfigManager>                       g_config;
     inline Hyprutils::Memory::CSharedPointer<CSystemIconFactory>                   g_iconFactory;
+    inline Hyprutils::Memory::CSharedPointer<CFontManager>                         g_fontManager;
+    inline Hyprutils::Memory::CSharedPointer<Asset::CImageDiskCache>               g_imageDiskCache;
+    inline Hyprutils::Memory::CSharedPointer<Asset::CDecodeScheduler>              g_decodeScheduler;
+    inline Hyprutils::Memory::CSharedPointer<CPrefetcher>                          g_prefetcher;
 }
@@ -23,6 +23,9 @@
 using namespace Hyprtoolkit;
 using namespace Hyprutils::Math;
 
+// what a wheel notch scrolls when only its value120 comes, libinput's
+constexpr double WHEEL_NOTCH_DELTA = 15.0;
+
 static std::string fourccToName(uint32_t drmFormat) {
     auto        fmt  = drmGetFormatName(drmFormat);
     std::string name = fmt ? fmt : "unknown";
@@ -405,14 +408,65 @@ void CWaylandPlatform::initSeat() {
                 m_currentWindow->mouseButton(Input::buttonFromWayland(button), state == WL_POINTER_BUTTON_STATE_PRESSED);
             });
 
-            m_waylandState.pointer->setAxis([this](CCWlPointer* r, uint32_t serial, wl_pointer_axis axis, wl_fixed_t delta) {
-                if (!m_currentWindow)
+            // scrolling comes in pieces, gathered until the frame event and handed to the window at once
+            m_waylandState.pointer->setAxisSource([this](CCWlPointer* r, wl_pointer_axis_source source) { //
+                m_waylandState.seatState.axisFrame.finger = source == WL_POINTER_AXIS_SOURCE_FINGER;
+            });
+
+            m_waylandState.pointer->setAxis([this](CCWlPointer* r, uint32_t time, wl_pointer_axis axis, wl_fixed_t delta) {
+                auto& frame = m_waylandState.seatState.axisFrame;
+
+                if (axis == WL_POINTER_AXIS_HORIZONTAL_SCROLL)
+                    frame.delta.x += wl_fixed_to_double(delta);
+                else
+                    frame.delta.y += wl_fixed_to_double(delta);
+
+                frame.time    = time;
+                frame.pending = true;
+            });
+
+            m_waylandState.pointer->setAxisValue120([this](CCWlPointer* r, wl_pointer_axis axis, int32_t value120) {
+                auto& frame = m_waylandState.seatState.axisFrame;
+
+                if (axis == WL_POINTER_AXIS_HORIZONTAL_SCROLL)
+                    frame.value120.x += value120;
+                else
+                    frame.value120.y += value120;
+
+                frame.pending = true;
+            });
+
+            m_waylandState.pointer->setAxisStop([this](CCWlPointer* r, uint32_t time, wl_pointer_axis axis) {
+                auto& frame = m_waylandState.seatState.axisFrame;
+
+                frame.time    = time;
+                frame.stop    = true;
+                frame.pending = true;
+            });
+
+            m_waylandState.pointer->setFrame([this](CCWlPointer* r) {
+                auto& frame = m_waylandState.seatState.axisFrame;
+
+                if (!frame.pending)
                     return;
 
-                m_currentWindow->mouseAxis(axis == WL_POINTER_AXIS_HORIZONTAL_SCROLL ? Input::AXIS_AXIS_HORIZONTAL : Input::AXIS_AXIS_VERTICAL, wl_fixed_to_double(delta));
+                if (m_currentWindow) {
+                    // high resolution wheels send fractions of a notch, an axis value that didn't come along is made from them
+                    Vector2D delta = frame.delta;
+                    if (delta.x == 0)
+                        delta.x = frame.value120.x / 120.0 * WHEEL_NOTCH_DELTA;
+                    if (delta.y == 0)
+                        delta.y = frame.value120.y / 120.0 * WHEEL_NOTCH_DELTA;
+
+                    m_currentWindow->mouseAxisFrame({.delta = delta, .time = frame.time, .finger = frame.finger, .stop = frame.stop});
+                }
+
+                // the source is only sent when it's known, it doesn't carry over
+                frame = {};
             });
 
             m_waylandState.cursorShapeDev = makeShared<CCWpCursorShapeDeviceV1>(m_waylandState.cursorShapeMgr->sendGetPointer(m_waylandState.pointer->resource()));
+            m_lastCursor                  = {};
 
         } else if (!HAS_POINTER && m_waylandState.pointer) {
             m_waylandState.pointer.reset();
@@ -544,6 +598,11 @@ void CWaylandPlatform::setCursor(ePointerShape shape) {
         default: break;
     }
 
+    // it's asked for on every move, only changes are sent. Each enter needs it set again
+    if (m_lastCursor.serial == m_lastEnterSerial && m_lastCursor.shape == wlShape)
+        return;
+
+    m_lastCursor = {.serial = m_lastEnterSerial, .shape = wlShape};
     m_waylandState.cursorShapeDev->sendSetShape(m_lastEnterSerial, wlShape);
 }
 
@@ -9,6 +9,9 @@
 
 #include <vector>
 #include <functional>
+#include <optional>
+
+#include <hyprutils/math/Vector2D.hpp>
 
 #include <xkbcommon/xkbcommon.h>
 #include <xkbcommon/xkbcommon-compose.h>
@@ -106,6 +109,15 @@ namespace Hyprtoolkit {
                 std::vector<uint32_t>    pressedKeys;
                 Input::SKeyboardKeyEvent repeatKeyEvent;
                 ASP<CTimer>              repeatTimer;
+
+                // the scrolling of the pointer frame coming in
+                struct {
+                    Hyprutils::Math::Vector2D delta, value120;
+                    uint32_t                  time    = 0;
+                    bool                      finger  = false;
+                    bool                      stop    = false;
+                    bool                      pending = false;
+                } axisFrame;
             } seatState;
 
             struct {
@@ -132,6 +144,12 @@ namespace Hyprtoolkit {
         uint32_t                        m_currentMods     = 0; // HT modifiers, not xkb
         uint32_t                        m_lastEnterSerial = 0;
 
+        // the shape last sent, and with which enter's serial
+        struct {
+            uint32_t                                  serial = 0;
+            std::optional<wpCursorShapeDeviceV1Shape> shape;
+        } m_lastCursor;
+
         WP<CWaylandSessionLockState>    m_sessionLockState;
     };
 
@@ -6,6 +6,7 @@
 #include "../helpers/Memory.hpp"
 #include "../window/ToolkitWindow.hpp"
 #include "../layout/Positioner.hpp"
+#include "../core/AnimationManager.hpp"
 
 #include <algorithm>
 
@@ -51,14 +52,21 @@ IElement::IElement() {
     });
 }
 
+// how an element is placed is up to its parent, the element itself measures the same
+static void scheduleParentReposition(const UP<SElementInternalData>& impl) {
+    if (!impl->window)
+        return;
+
+    impl->window->scheduleReposition(impl->parent ? impl->parent : impl->self);
+}
+
 IElement::~IElement() {
     impl.reset();
 }
 
 void IElement::setPositionMode(ePositionMode mode) {
     impl->positionMode = mode;
-    if (impl->window)
-        impl->window->scheduleReposition(impl->self);
+    scheduleParentReposition(impl);
 }
 
 void IElement::setPositionFlag(ePositionFlag flag, bool set) {
@@ -66,19 +74,20 @@ void IElement::setPositionFlag(ePositionFlag flag, bool set) {
         impl->positionFlags |= flag;
     else
         impl->positionFlags &= ~flag;
-    if (impl->window)
-        impl->window->scheduleReposition(impl->self);
+    scheduleParentReposition(impl);
 }
 
 void IElement::setAbsolutePosition(const Hyprutils::Math::Vector2D& offset) {
     impl->absoluteOffset = offset;
-    if (impl->window)
-        impl->window->scheduleReposition(impl->self);
+    scheduleParentReposition(impl);
 }
 
 void IElement::setTooltip(std::string&& x) {
     impl->tooltip    = std::move(x);
     impl->hasTooltip = !impl->tooltip.empty();
+
+    if (impl->window)
+        impl->window->invalidateHover();
 }
 
 std::optional<Hyprutils::Math::Vector2D> IElement::preferredSize(const Hyprutils::Math::Vector2D& parent) {
@@ -94,13 +103,13 @@ std::optional<Hyprutils::Math::Vector2D> IElement::maximumSize(const Hyprutils::
 }
 
 void IElement::setGrow(bool grow) {
-    impl->growH = grow;
-    impl->growV = grow;
+    setGrow(grow, grow);
 }
 
 void IElement::setGrow(bool growH, bool growV) {
     impl->growH = growH;
     impl->growV = growV;
+    scheduleParentReposition(impl);
 }
 
 void IElement::addChild(Hyprutils::Memory::CSharedPointer<IElement> child) {
@@ -111,6 +120,7 @@ void IElement::addChild(Hyprutils::Memory::CSharedPointer<IElement> child) {
     child->impl->window = impl->window;
     child->impl->breadthfirst([w = impl->window.lock()](SP<IElement> e) { e->impl->setWindow(w); });
     impl->children.emplace_back(child);
+    impl->invalidateMeasure();
 
     if (impl->window)
         impl->window->scheduleReposition(child);
@@ -121,6 +131,7 @@ void IElement::removeChild(Hyprutils::Memory::CSharedPointer<IElement> child) {
         return;
 
     std::erase(impl->children, child);
+    impl->invalidateMeasure();
 
     child->impl->parent.reset();
     child->impl->window.reset();
@@ -136,6 +147,7 @@ void IElement::clearChildren() {
         c->impl->window.reset();
     }
     impl->children.clear();
+    impl->invalidateMeasure();
 }
 
 bool IElement::acceptsMouseInput() {
@@ -156,6 +168,7 @@ bool IElement::alwaysGetMouseInput() {
 
 void IElement::setMargin(float thick) {
     impl->margin = thick;
+    impl->invalidateMeasure();
 }
 
 void IElement::reposition(const Hyprutils::Math::CBox& box, const Hyprutils::Math::Vector2D& maxSize) {
@@ -183,6 +196,9 @@ void IElement::imApplyText() {
 
 void IElement::setReceivesMouse(bool x) {
     impl->userRequestedMouseInput = true;
+
+    if (impl->window)
+        impl->window->invalidateHover();
 }
 
 void IElement::setMouseEnter(std::function<void(const Hyprutils::Math::Vector2D&)>&& fn) {
@@ -213,6 +229,34 @@ void IElement::setGrouped(bool grouped) {
     impl->grouped = grouped;
 }
 
+template <Animable T>
+static void setAnimated(PHLANIMVAR<T>& var, const T& value, bool animate) {
+    if (animate)
+        *var = value;
+    else
+        var->setValueAndWarp(value);
+}
+
+void IElement::setRenderTranslate(const Vector2D& offset, bool animate) {
+    impl->initRenderTransform();
+    setAnimated(impl->renderTransform->translate, offset, animate);
+}
+
+void IElement::setRenderScale(float scale, bool animate) {
+    impl->initRenderTransform();
+    setAnimated(impl->renderTransform->scale, scale, animate);
+}
+
+void IElement::setRenderRotation(float radians, bool animate) {
+    impl->initRenderTransform();
+    setAnimated(impl->renderTransform->rotation, radians, animate);
+}
+
+void IElement::setOpacity(float opacity, bool animate) {
+    impl->initRenderTransform();
+    setAnimated(impl->renderTransform->opacity, std::clamp(opacity, 0.F, 1.F), animate);
+}
+
 Vector2D IElement::posFromParent() {
     if (!impl->parent)
         return impl->position.pos();
@@ -232,9 +276,31 @@ void IElement::forceReposition() {
 }
 
 void SElementInternalData::setPosition(const CBox& box) {
+    const auto LAST = position.size();
+
     position = box;
     if (margin > 0)
         position.expand(-margin);
+
+    // layouts measure their children against their own size. Only this one's own measure is off, the
+    // parent gave it this size, and the children's caches are keyed on it
+    if (position.size() != LAST)
+        resetMeasureCache();
+}
+
+void SElementInternalData::translate(const Vector2D& delta) {
+    breadthfirst([&delta](SP<IElement> e) {
+        e->impl->position.translate(delta);
+
+        if (e->impl->layoutOnScroll && e->impl->window)
+            e->impl->window->scheduleReposition(e->impl->self);
+
+        // where a relayout of it would put it, without painting it again
+        if (e->impl->positionerData) {
+            e->impl->positionerData->baseBox.translate(delta);
+            e->impl->positionerData->scrolled = true;
+        }
+    });
 }
 
 void SElementInternalData::bfHelper(std::vector<SP<IElement>> elements, const std::function<void(SP<IElement>)>& fn) {
@@ -262,15 +328,24 @@ void SElementInternalData::breadthfirst(const std::function<void(SP<IElement>)>&
 }
 
 void SElementInternalData::setWindow(SP<IToolkitWindow> w) {
-    window = w;
+    window      = w;
+    needsLayout  = false; // whatever another window had queued is moot
+    rasterQueued = false; // might never run there, the new window queues its own
+    resetMeasureCache(); // the scale might differ
     if (w)
         w->scheduleReposition(self);
 }
 
 void SElementInternalData::damageEntire() {
+    damage(position.copy().expand(2));
+}
+
+void SElementInternalData::damage(const CBox& box) {
     if (!window)
         return;
-    window->damage(position.copy().expand(2));
+
+    const auto TRANSFORM = drawTransform();
+    window->damage(TRANSFORM.identity() ? box : TRANSFORM.bounds(box));
 }
 
 void SElementInternalData::setFailedPositioning(bool set) {
@@ -280,9 +355,9 @@ void SElementInternalData::setFailedPositioning(bool set) {
 Vector2D SElementInternalData::maxChildSize(const Vector2D& parent) {
     Vector2D max;
     for (const auto& e : children) {
-        auto size = e->preferredSize(parent);
+        auto size = e->impl->measurePreferred(parent);
         if (!size)
-            size = e->minimumSize(parent);
+            size = e->impl->measureMinimum(parent);
 
         if (!size)
             continue;
@@ -304,3 +379,130 @@ Vector2D SElementInternalData::getPreferredSizeGeneric(const CDynamicSize& size,
         s.y = max.y;
     return s;
 }
+
+using MeasureFn = std::optional<Vector2D> (IElement::*)(const Vector2D&);
+
+static std::optional<Vector2D> measureCached(const WP<IElement>& el, SElementInternalData::SMeasureCache& cache, const Vector2D& parent, MeasureFn fn) {
+    if (cache.valid && cache.parent == parent)
+        return cache.size;
+
+    if (!el)
+        return std::nullopt;
+
+    cache.size   = (el.lock().get()->*fn)(parent);
+    cache.parent = parent;
+    cache.valid  = true;
+
+    return cache.size;
+}
+
+std::optional<Vector2D> SElementInternalData::measurePreferred(const Vector2D& parent) {
+    return measureCached(self, measureCache.preferred, parent, &IElement::preferredSize);
+}
+
+std::optional<Vector2D> SElementInternalData::measureMinimum(const Vector2D& parent) {
+    return measureCached(self, measureCache.minimum, parent, &IElement::minimumSize);
+}
+
+std::optional<Vector2D> SElementInternalData::measureMaximum(const Vector2D& parent) {
+    return measureCached(self, measureCache.maximum, parent, &IElement::maximumSize);
+}
+
+void SElementInternalData::invalidateMeasure() {
+    resetMeasureCache();
+
+    // an ancestor's size is made of its children's
+    for (auto p = parent.lock(); p; p = p->impl->parent.lock()) {
+        p->impl->resetMeasureCache();
+    }
+}
+
+void SElementInternalData::resetMeasureCache() {
+    for (auto cache : {&measureCache.preferred, &measureCache.minimum, &measureCache.maximum}) {
+        if (cache->valid) {
+            cache->before    = cache->size;
+            cache->hasBefore = true;
+        }
+
+        cache->valid = false;
+    }
+}
+
+bool SElementInternalData::measuresSame() {
+    // never laid out, there's nothing to compare with
+    if (!positionerData)
+        return false;
+
+    // a measure the parent never took doesn't matter to it
+    const auto SAME = [this](SMeasureCache& cache, MeasureFn fn) { return !cache.hasBefore || measureCached(self, cache, cache.parent, fn) == cache.before; };
+
+    return SAME(measureCache.preferred, &IElement::preferredSize) && SAME(measureCache.minimum, &IElement::minimumSize) &&
+        SAME(measureCache.maximum, &IElement::maximumSize);
+}
+
+void SElementInternalData::initRenderTransform() {
+    if (renderTransform)
+        return;
+
+    renderTransform    = makeUnique<SRenderTransformData>();
+    const auto CONFIG  = g_animationManager->m_animationTree.getConfig("fast");
+    const auto DAMAGE  = [this](auto) { damageTransformed(); };
+    const auto OBSERVE = [&DAMAGE](auto& var) {
+        var->setUpdateCallback(DAMAGE);
+        var->setCallbackOnBegin(DAMAGE, false);
+    };
+
+    g_animationManager->createAnimation(Vector2D{}, renderTransform->translate, CONFIG);
+    g_animationManager->createAnimation(1.F, renderTransform->scale, CONFIG);
+    g_animationManager->createAnimation(0.F, renderTransform->rotation, CONFIG);
+    g_animationManager->createAnimation(1.F, renderTransform->opacity, CONFIG);
+
+    OBSERVE(renderTransform->translate);
+    OBSERVE(renderTransform->scale);
+    OBSERVE(renderTransform->rotation);
+    OBSERVE(renderTransform->opacity);
+}
+
+SRenderTransform SElementInternalData::ownTransform() {
+    if (!renderTransform)
+        return {};
+
+    return SRenderTransform::make(renderTransform->translate->value(), renderTransform->scale->value(), renderTransform->rotation->value(),
+                                  renderTransform->opacity->value(), position.middle());
+}
+
+SRenderTransform SElementInternalData::drawTransform() {
+    auto transform = ownTransform();
+
+    for (auto p = parent; p; p = p->impl->parent) {
+        if (p->impl->renderTransform)
+            transform = transform.then(p->impl->ownTransform());
+    }
+
+    return transform;
+}
+
+bool SElementInternalData::transformed() {
+    return renderTransform && !ownTransform().identity();
+}
+
+void SElementInternalData::damageTransformed() {
+    if (!window || !renderTransform)
+        return;
+
+    // everything in it, children can stick out
+    Vector2D min = position.pos(), max = position.pos() + position.size();
+    breadthfirst([&min, &max](SP<IElement> e) {
+        const auto& BOX = e->impl->position;
+        min             = {std::min(min.x, BOX.x), std::min(min.y, BOX.y)};
+        max             = {std::max(max.x, BOX.x + BOX.w), std::max(max.y, BOX.y + BOX.h)};
+    });
+
+    // only where it was drawn and where it is now, nothing was laid out again
+    const auto NOW = drawTransform().bounds(CBox{min, max - min}.expand(2));
+    CRegion    rg{renderTransform->drawn};
+    rg.add(NOW);
+    renderTransform->drawn = NOW;
+
+    window->damage(std::move(rg));
+}
@@ -6,7 +6,9 @@
 #include <functional>
 
 #include "../helpers/Memory.hpp"
+#include "../helpers/RenderTransform.hpp"
 #include "../core/Input.hpp"
+#include "../core/AnimatedVariable.hpp"
 
 #include <hyprutils/math/Box.hpp>
 
@@ -42,9 +44,43 @@ namespace Hyprtoolkit {
         // rendering: clip children to parent box
         bool         clipChildren = false;
 
-        WP<IElement> parent;
+        // draws nothing of its own, only its children
+        bool         paintsNothing = false;
 
-        bool         failedPositioning = false;
+        // what it has depends on what's visible, so a scroll area moving it lays it out again
+        bool         layoutOnScroll = false;
+
+        // drawn moved, scaled, rotated and faded, without changing the layout. Only there once set, see IElement::setRenderTranslate
+        struct SRenderTransformData {
+            PHLANIMVAR<Hyprutils::Math::Vector2D> translate;
+            PHLANIMVAR<float>                     scale, rotation, opacity;
+
+            Hyprutils::Math::CBox                 drawn; // what it and everything in it covered, last damaged
+        };
+
+        UP<SRenderTransformData> renderTransform;
+
+        WP<IElement>             parent;
+
+        bool                     failedPositioning = false;
+
+        // scheduled for a layout, see CPositioner::relayout
+        bool needsLayout = false;
+
+        // waiting in the window's raster queue, see IToolkitWindow::scheduleRaster
+        bool rasterQueued = false;
+
+        // what preferredSize / minimumSize / maximumSize last returned, and for which parent size.
+        // before is what it returned until invalidated, what the parent last laid it out with
+        struct SMeasureCache {
+            bool                                     valid = false, hasBefore = false;
+            Hyprutils::Math::Vector2D                parent;
+            std::optional<Hyprutils::Math::Vector2D> size, before;
+        };
+
+        struct {
+            SMeasureCache preferred, minimum, maximum;
+        } measureCache;
 
         struct {
             Hyprutils::Signal::CSignalT<Hyprutils::Math::Vector2D> mouseEnter; // local coords
@@ -71,10 +107,31 @@ namespace Hyprtoolkit {
         void                      breadthfirst(const std::function<void(SP<IElement>)>& fn);
         void                      setWindow(SP<IToolkitWindow> w);
         void                      damageEntire();
+        void                      damage(const Hyprutils::Math::CBox& box); // box as laid out, damaged where it's drawn
         void                      setPosition(const Hyprutils::Math::CBox& box);
+        void                      translate(const Hyprutils::Math::Vector2D& delta); // moves it and everything in it as laid out, without laying out
         void                      setFailedPositioning(bool set);
         Hyprutils::Math::Vector2D maxChildSize(const Hyprutils::Math::Vector2D& parent);
         Hyprutils::Math::Vector2D getPreferredSizeGeneric(const CDynamicSize& size, const Hyprutils::Math::Vector2D& parent);
+
+        // memoized preferredSize / minimumSize / maximumSize, what layouts measure their children with
+        std::optional<Hyprutils::Math::Vector2D> measurePreferred(const Hyprutils::Math::Vector2D& parent);
+        std::optional<Hyprutils::Math::Vector2D> measureMinimum(const Hyprutils::Math::Vector2D& parent);
+        std::optional<Hyprutils::Math::Vector2D> measureMaximum(const Hyprutils::Math::Vector2D& parent);
+
+        // this element measures differently now, and so might every ancestor
+        void invalidateMeasure();
+        void resetMeasureCache(); // this element's only
+
+        // whether it measures as it did before the last invalidation, so its parent would give it the same box
+        bool measuresSame();
+
+        // render transforms: its own, and what it's drawn with, its own and every parent's
+        void             initRenderTransform();
+        SRenderTransform ownTransform();
+        SRenderTransform drawTransform();
+        bool             transformed(); // its own does anything
+        void             damageTransformed();
     };
 
 }
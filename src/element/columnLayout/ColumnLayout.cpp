@@ -2,6 +2,7 @@
 #include <cmath>
 
 #include "../../layout/Positioner.hpp"
+#include "../../layout/StackSolver.hpp"
 #include "../../renderer/Renderer.hpp"
 #include "../../core/InternalBackend.hpp"
 #include "../../window/ToolkitWindow.hpp"
@@ -18,7 +19,8 @@ SP<CColumnLayoutElement> CColumnLayoutElement::create(const SColumnLayoutData& d
 }
 
 CColumnLayoutElement::CColumnLayoutElement(const SColumnLayoutData& data) : IElement(), m_impl(makeUnique<SColumnLayoutImpl>()) {
-    m_impl->data = data;
+    m_impl->data        = data;
+    impl->paintsNothing = true;
 }
 
 void CColumnLayoutElement::paint() {
@@ -50,107 +52,39 @@ void CColumnLayoutElement::reposition(const Hyprutils::Math::CBox& sbox, const H
 
     // position children in this layout.
 
-    size_t              usedY = 0;
-    const size_t        MAX_Y = (uint64_t)impl->position.size().y;
-
-    size_t              i = 0;
+    const size_t             MAX_Y = (uint64_t)impl->position.size().y;
 
-    std::vector<size_t> heights;
-    heights.resize(impl->children.size());
-
-    for (i = 0; i < C.size(); ++i) {
-        const auto& child = C.at(i);
+    std::vector<SStackChild> items;
+    items.reserve(C.size());
 
-        Vector2D    cSize = childSize(child);
+    for (const auto& child : C) {
+        Vector2D cSize = childSize(child);
         if (cSize == Vector2D{-1, -1})
             cSize = {box.w, 1.F};
 
-        if (usedY + cSize.y > MAX_Y + 1) {
-            // doesn't fit: try to shrink any previous element if it allows to do so
-            // FIXME: if we resize and fail to fit, it will mess up the layout a bit
-            float needs = (usedY + cSize.y) - (MAX_Y + 1);
-            for (int j = i - 1; j >= 0; --j) {
-                const auto& prevChild = C.at(j);
-                const auto  MIN       = prevChild->minimumSize(impl->position.size());
-                if (!MIN.has_value()) {
-                    // we can shrink this child to zero
-                    if (needs > heights.at(j)) {
-                        heights.at(j) -= needs - heights.at(j);
-                        needs -= needs - heights.at(j);
-                        continue;
-                    }
-
-                    heights.at(j) -= needs;
-                    needs = 0;
-                    break; // done
-                } else if (MIN->y < heights.at(j)) {
-                    // we can shrink it a bit
-                    if (needs > (heights.at(j) - MIN->y)) {
-                        heights.at(j) -= needs - (heights.at(j) - MIN->y);
-                        needs -= needs - (heights.at(j) - MIN->y);
-                        continue;
-                    }
-
-                    heights.at(j) -= needs;
-                    needs = 0;
-                    break; // done
-                }
-            }
-
-            if (needs > 0) {
-                // doesn't fit: disable and expand the last if possible
-                child->impl->setFailedPositioning(true);
-                if (i != 0) {
-                    // try to expand last child
-                    const auto& lastChild = C.at(i - 1);
-
-                    if (lastChild->maximumSize(box.size()) && heights.at(i - 1) + MAX_Y - usedY > lastChild->maximumSize(box.size())->y)
-                        continue; // too bad, we'll have a gap
-
-                    heights.at(i - 1) += MAX_Y - usedY;
-                }
-                continue;
-            } else {
-
-                child->impl->setFailedPositioning(false);
-                heights.at(i) = cSize.y;
-
-                // recalc usedX cuz we changed stuff
-                usedY = 0;
-                for (const auto& h : heights) {
-                    usedY += h + m_impl->data.gap;
-                }
-
-                continue;
-            }
-        }
-
-        // can fit: use preferred
-        heights.at(i) = cSize.y;
-        child->impl->setFailedPositioning(false);
-        usedY += cSize.y + m_impl->data.gap;
-    }
-
-    if (!C.empty())
-        usedY -= m_impl->data.gap;
+        const auto MIN = child->impl->measureMinimum(impl->position.size());
+        const auto MAX = child->impl->measureMaximum(box.size());
 
-    // check if any element grows and grow if applicable
-    if (usedY < MAX_Y) {
-        for (i = 0; i < C.size(); ++i) {
-            const auto& child = C.at(i);
+        items.emplace_back(SStackChild{
+            .size = cSize.y,
+            .min  = MIN ? std::optional<double>{MIN->y} : std::nullopt,
+            .max  = MAX ? std::optional<double>{MAX->y} : std::nullopt,
+            .grow = child->impl->growV,
+        });
+    }
 
-            if (!child->impl->growV)
-                continue;
+    const auto  SOLVED  = solveStack(items, MAX_Y, m_impl->data.gap, {.overflowSlack = 1, .wholePixels = true});
+    const auto& heights = SOLVED.sizes;
+    const auto  usedY   = SOLVED.used;
 
-            heights.at(i) += MAX_Y - usedY;
-            break;
-        }
+    for (size_t i = 0; i < C.size(); ++i) {
+        C.at(i)->impl->setFailedPositioning(SOLVED.failed.at(i));
     }
 
-    // widths done: lay out elements
+    // heights done: lay out elements
     size_t currentY = 0;
 
-    for (i = 0; i < C.size(); ++i) {
+    for (size_t i = 0; i < C.size(); ++i) {
         const auto& child = C.at(i);
 
         if (child->impl->failedPositioning)
@@ -175,10 +109,10 @@ Hyprutils::Math::Vector2D CColumnLayoutElement::size() {
 }
 
 Hyprutils::Math::Vector2D CColumnLayoutElement::childSize(Hyprutils::Memory::CSharedPointer<IElement> child) {
-    if (child->preferredSize(impl->position.size()))
-        return *child->preferredSize(impl->position.size());
-    else if (child->minimumSize(impl->position.size()))
-        return *child->minimumSize(impl->position.size());
+    if (child->impl->measurePreferred(impl->position.size()))
+        return *child->impl->measurePreferred(impl->position.size());
+    else if (child->impl->measureMinimum(impl->position.size()))
+        return *child->impl->measureMinimum(impl->position.size());
     return {-1, -1};
 }
 
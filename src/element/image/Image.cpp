@@ -6,12 +6,106 @@
 #include "../../window/ToolkitWindow.hpp"
 #include "../../system/Icons.hpp"
 #include "../../resource/assetCache/AssetCache.hpp"
+#include "../../resource/assetCache/SvgRasterCache.hpp"
+#include "../../resource/diskCache/ImageDiskCache.hpp"
+#include "../../resource/decode/DecodeScheduler.hpp"
+#include "../../helpers/Hash.hpp"
 #include "../../renderer/RendererTexture.hpp"
+#include "../../palette/ConfigManager.hpp"
 
 #include "../Element.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <cairo/cairo.h>
+#include <hyprgraphics/cairo/CairoSurface.hpp>
+#include <hyprutils/utils/ScopeGuard.hpp>
+
 using namespace Hyprtoolkit;
 
+// decode boxes are rounded up to this, so that resizing doesn't need a new decode every frame
+constexpr double DECODE_GRANULARITY = 64;
+
+// the smallest size with the source's aspect ratio that still covers box, never larger than the source
+static Vector2D decodedSizeFor(const Vector2D& source, const Vector2D& box) {
+    if (box.x <= 0 || box.y <= 0 || source.x <= 0 || source.y <= 0)
+        return source;
+
+    const double FACTOR = std::max(box.x / source.x, box.y / source.y);
+    if (FACTOR >= 1.0)
+        return source;
+
+    return Vector2D{std::max(1.0, std::ceil(source.x * FACTOR)), std::max(1.0, std::ceil(source.y * FACTOR))};
+}
+
+// scales a freshly decoded image down to what it's going to be drawn at, so that the full size
+// one never makes it to the gpu. Runs wherever the decode finished, i.e. usually off the main thread.
+static void downscaleDecoded(IAsyncResource* resource, SP<SImageDecodeTarget> target) {
+    if (!resource || !target || !resource->m_asset.cairoSurface)
+        return;
+
+    const auto SOURCE  = resource->m_asset.pixelSize;
+    target->sourceSize = SOURCE;
+
+    const auto SIZE = decodedSizeFor(SOURCE, target->box);
+    if (SIZE == SOURCE)
+        return;
+
+    const auto SURFACE = resource->m_asset.cairoSurface->cairo();
+    const auto FORMAT  = cairo_image_surface_get_format(SURFACE);
+    if (FORMAT != CAIRO_FORMAT_ARGB32 && FORMAT != CAIRO_FORMAT_RGB24)
+        return;
+
+    const auto SCALED = cairo_image_surface_create(FORMAT, SIZE.x, SIZE.y);
+    const auto CAIRO  = cairo_create(SCALED);
+
+    cairo_scale(CAIRO, SIZE.x / SOURCE.x, SIZE.y / SOURCE.y);
+    cairo_set_source_surface(CAIRO, SURFACE, 0, 0);
+    // GOOD averages all covered source pixels when going down, PAD keeps the edges from fading out
+    cairo_pattern_set_filter(cairo_get_source(CAIRO), CAIRO_FILTER_GOOD);
+    cairo_pattern_set_extend(cairo_get_source(CAIRO), CAIRO_EXTEND_PAD);
+    cairo_set_operator(CAIRO, CAIRO_OPERATOR_SOURCE);
+    cairo_paint(CAIRO);
+    cairo_destroy(CAIRO);
+    cairo_surface_flush(SCALED);
+
+    resource->m_asset.cairoSurface = makeShared<Hyprgraphics::CCairoSurface>(SCALED);
+    resource->m_asset.pixelSize    = SIZE;
+}
+
+// uploads what was decoded and marks the entry done, nullptr if it failed, then calls fn with the texture.
+// Nothing in here is the element's, it might be gone by now.
+static void finishLoad(SImageLoad&& load, std::function<void(SP<IRendererTexture>)>&& fn) {
+    if (!load.resource || !load.resource->m_asset.cairoSurface) {
+        g_logger->log(HT_LOG_ERROR, "Image: failed loading, hyprgraphics couldn't load asset {}", load.path);
+        load.entry->texDone(nullptr);
+        fn(nullptr);
+        return;
+    }
+
+    if (load.target && load.target->sourceSize != Vector2D{})
+        load.entry->setSourceSize(load.target->sourceSize);
+
+    ASP<IAsyncResource> resourceGeneric(load.resource);
+    const IRenderer::STextureData TEXDATA = {.resource = resourceGeneric, .fitMode = load.fitMode, .lowPrecision = load.lowPrecision};
+
+    auto onUploaded = [entry = load.entry, resource = resourceGeneric, key = std::move(load.diskCacheKey), fn = std::move(fn)](SP<IRendererTexture> tex) {
+        entry->texDone(tex);
+
+        if (key && g_imageDiskCache)
+            g_imageDiskCache->storeAsync(*key, resource, entry->sourceSize());
+
+        fn(tex);
+    };
+
+    // the old texture is drawn until the new one is on the gpu
+    if (load.sync)
+        onUploaded(g_renderer->uploadTexture(TEXDATA));
+    else
+        g_renderer->uploadTextureAsync(TEXDATA, std::move(onUploaded));
+}
+
 SP<CImageElement> CImageElement::create(const SImageData& data) {
     auto p          = SP<CImageElement>(new CImageElement(data));
     p->impl->self   = p;
@@ -21,6 +115,7 @@ SP<CImageElement> CImageElement::create(const SImageData& data) {
 
 CImageElement::CImageElement(const SImageData& data) : IElement(), m_impl(makeUnique<SImageImpl>()) {
     m_impl->data = data;
+    m_impl->updateDataHash();
 }
 
 void CImageElement::paint() {
@@ -35,13 +130,34 @@ void CImageElement::paint() {
     if (!assetToUse || !assetToUse->tex()) {
         if (!m_impl->waitingForTex)
             renderTex();
+        else
+            m_impl->updateDecodePriority();
         return;
     }
 
-    if (impl->window)
-        m_impl->lastScale = impl->window->scale();
+    if (impl->window && impl->window->scale() != m_impl->lastScale) {
+        if ((m_impl->data.icon || m_impl->isVector()) && !impl->rasterQueued) {
+            // the old raster gets stretched over our box until the window gets to us
+            impl->rasterQueued = true;
+            impl->window->scheduleRaster(impl->self, [this] {
+                impl->rasterQueued = false;
 
-    if (m_impl->data.icon && m_impl->preferredSvgSize() != m_impl->size && !m_impl->waitingForTex) {
+                if (!impl->window)
+                    return;
+
+                m_impl->lastScale = impl->window->scale();
+
+                if (m_impl->needsNewRaster())
+                    renderTex();
+            });
+        } else if (!m_impl->data.icon && !m_impl->isVector())
+            m_impl->lastScale = impl->window->scale();
+    } else if (m_impl->needsNewRaster()) {
+        // whatever raster of it is closest stands in until the sharp one is done
+        renderTex();
+        assetToUse = m_impl->cacheEntry && m_impl->cacheEntry->tex() ? m_impl->cacheEntry : m_impl->oldCacheEntry;
+    } else if (!m_impl->isVector() && !m_impl->waitingForTex && m_impl->needsLargerDecode()) {
+        // grew past what was decoded, the smaller one gets stretched until the new one is there
         renderTex();
         assetToUse = m_impl->oldCacheEntry;
     }
@@ -62,20 +178,42 @@ void CImageElement::renderTex() {
         return;
 
     m_impl->resource.reset();
-    m_impl->oldCacheEntry = m_impl->cacheEntry;
+    if (m_impl->cacheEntry && m_impl->cacheEntry->tex())
+        m_impl->oldCacheEntry = m_impl->cacheEntry;
     m_impl->cacheEntry.reset();
+    m_impl->diskCacheKey.reset();
+    m_impl->decodeTarget = makeShared<SImageDecodeTarget>(SImageDecodeTarget{.box = m_impl->decodeBox()});
 
     const auto CACHE_STR = m_impl->getCacheString();
 
-    const auto ASSET = Asset::assetCache()->get(CACHE_STR);
+    // a disk cache load whose file was bad, others might be waiting on its entry. Failed if it's not decoded into.
+    auto fallback = std::exchange(m_impl->diskFallback, nullptr);
+    if (fallback && fallback->source() != CACHE_STR) {
+        fallback->texDone(nullptr);
+        fallback.reset();
+    }
+
+    Hyprutils::Utils::CScopeGuard finishFallback([&fallback] {
+        if (fallback)
+            fallback->texDone(nullptr);
+    });
+
+    const auto ASSET = fallback ? nullptr : Asset::assetCache()->get(CACHE_STR);
     if (ASSET) {
         g_logger->log(HT_LOG_DEBUG, "CImageElement: path {} was already cached, reusing entry", m_impl->data.path);
-        m_impl->failed     = false;
+        m_impl->failed     = ASSET->status() == Asset::CACHE_ENTRY_DONE && !ASSET->tex();
         m_impl->cacheEntry = ASSET;
         if (ASSET->status() == Asset::CACHE_ENTRY_DONE)
             m_impl->postImageScheduleRecalc();
         else {
+            // someone else's load, e.g. a prefetch. Ours now too, so it goes at our priority.
+            m_impl->waitingForTex      = true;
+            m_impl->decodeTicket       = ASSET->ticket();
+            m_impl->lastDecodePriority = Asset::DECODE_PRIORITY_PREFETCH;
+            m_impl->updateDecodePriority();
+
             m_impl->listeners.cacheEntryDone = ASSET->m_events.done.listen([this] {
+                m_impl->failed = m_impl->cacheEntry && !m_impl->cacheEntry->tex();
                 m_impl->postImageScheduleRecalc();
                 m_impl->listeners.cacheEntryDone.reset();
             });
@@ -83,73 +221,223 @@ void CImageElement::renderTex() {
         return;
     }
 
+    if (m_impl->loadFromDisk())
+        return;
+
+    if (m_impl->isVector()) {
+        if (const auto STANDIN = Asset::svgRasterCache()->nearest(m_impl->sourcePath(), m_impl->preferredSvgSize()); STANDIN)
+            m_impl->oldCacheEntry = STANDIN;
+    }
+
     if (!m_impl->data.data.empty()) {
         const auto SIZE  = m_impl->preferredSvgSize();
         m_impl->resource = makeAtomicShared<CImageResource>(m_impl->data.data, SIZE);
         m_impl->lastData = m_impl->data.data.data();
-    } else if (!m_impl->data.icon) {
-        m_impl->resource = makeAtomicShared<CImageResource>(m_impl->data.path);
-        m_impl->lastPath = m_impl->data.path;
     } else {
-        m_impl->lastPath = reinterpretPointerCast<CSystemIconDescription>(m_impl->data.icon)->m_bestPath;
         const auto SIZE  = m_impl->preferredSvgSize();
-        m_impl->resource = makeAtomicShared<CImageResource>(m_impl->lastPath, SIZE);
+        m_impl->lastPath = m_impl->sourcePath();
 
-        if (SIZE.x == 0 || SIZE.y == 0)
-            return;
+        if (!m_impl->isVector())
+            m_impl->resource = makeAtomicShared<CImageResource>(m_impl->lastPath);
+        else if (SIZE.x == 0 || SIZE.y == 0) {
+            // an icon has no size of its own to be drawn at before it's laid out
+            if (m_impl->data.icon)
+                return;
+
+            m_impl->resource = makeAtomicShared<CImageResource>(m_impl->lastPath);
+        } else
+            m_impl->resource = makeAtomicShared<CImageResource>(m_impl->lastPath, SIZE);
     }
 
-    m_impl->cacheEntry = makeShared<Asset::CAssetCacheEntry>(CACHE_STR);
-    Asset::assetCache()->cache(m_impl->cacheEntry);
+    if (fallback)
+        m_impl->cacheEntry = std::exchange(fallback, nullptr);
+    else {
+        m_impl->cacheEntry = makeShared<Asset::CAssetCacheEntry>(CACHE_STR);
+        Asset::assetCache()->cache(m_impl->cacheEntry);
+    }
 
     m_impl->waitingForTex = true;
 
     ASP<IAsyncResource> resourceGeneric(m_impl->resource);
 
-    g_asyncResourceGatherer->enqueue(resourceGeneric);
-
-    if (!m_impl->data.sync) {
-        m_impl->resource->m_events.finished.listenStatic([this, self = impl->self] {
-            if (!self)
-                return;
-
-            g_backend->addIdle([this, self = self]() {
-                if (!self)
-                    return;
-
-                m_impl->postImageLoad();
+    if (!m_impl->data.sync && g_decodeScheduler) {
+        m_impl->lastDecodePriority = m_impl->decodePriority();
+
+        auto ticket = g_decodeScheduler->submit(
+            CACHE_STR, m_impl->lastDecodePriority,
+            [resource = resourceGeneric] {
+                resource->render();
+                resource->m_ready = true;
+                resource->m_events.finished.emit();
+            },
+            [this, self = impl->self, load = m_impl->currentLoad()] {
+                // still on the decode thread
+                downscaleDecoded(load.resource.get(), load.target);
+
+                g_backend->addIdle([this, self, load]() mutable {
+                    // others can be waiting on the entry, even if we're gone
+                    if (!self) {
+                        finishLoad(std::move(load), [](auto) {});
+                        return;
+                    }
+
+                    m_impl->postImageLoad(std::move(load));
+                });
             });
-        });
+
+        // the entry owns the load, so that it's cancelled once nobody waits for it anymore
+        m_impl->cacheEntry->setTicket(ticket);
+        m_impl->decodeTicket = ticket;
     } else {
+        g_asyncResourceGatherer->enqueue(resourceGeneric);
         g_asyncResourceGatherer->await(resourceGeneric);
-        m_impl->postImageLoad();
+        downscaleDecoded(resourceGeneric.get(), m_impl->decodeTarget);
+        m_impl->postImageLoad(m_impl->currentLoad());
     }
 }
 
-void SImageImpl::postImageLoad() {
-    if (!resource || !cacheEntry)
+SImageLoad SImageImpl::currentLoad() {
+    return SImageLoad{
+        .entry        = cacheEntry,
+        .resource     = resource,
+        .target       = decodeTarget,
+        .diskCacheKey = diskCacheKey,
+        .path         = lastPath,
+        .fitMode      = data.fitMode,
+        .lowPrecision = lowPrecision(),
+        .sync         = data.sync,
+    };
+}
+
+void SImageImpl::postImageLoad(SImageLoad&& load) {
+    if (!load.entry)
         return;
 
-    if (resource->m_asset.cairoSurface) {
-        ASP<IAsyncResource> resourceGeneric(resource);
-        size = resource->m_asset.pixelSize;
-        cacheEntry->texDone(g_renderer->uploadTexture({.resource = resourceGeneric, .fitMode = data.fitMode}));
-    } else {
-        failed = true;
-        g_logger->log(HT_LOG_ERROR, "Image: failed loading, hyprgraphics couldn't load asset {}", lastPath);
+    // moved on to another load meanwhile, this one still finishes its entry
+    if (load.entry == cacheEntry) {
+        resource.reset();
+        diskCacheKey.reset();
     }
 
-    oldCacheEntry.reset();
-    resource.reset();
+    const auto ENTRY = load.entry;
+    finishLoad(std::move(load), [this, self = self, entry = ENTRY](SP<IRendererTexture> tex) {
+        if (!self || cacheEntry != entry)
+            return;
 
-    postImageScheduleRecalc();
+        failed = !tex;
+        oldCacheEntry.reset();
+        postImageScheduleRecalc();
+    });
+}
+
+bool SImageImpl::loadFromDisk() {
+    if (!g_imageDiskCache || !data.data.empty())
+        return false;
+
+    const bool SVG = isVector();
+
+    Asset::SImageCacheKey key;
+    key.path      = sourcePath();
+    key.pixelSize = SVG ? preferredSvgSize() : decodeTarget->box;
+    key.scale     = SVG ? lastScale : 1.F;
+
+    if (key.path.empty() || (SVG && (key.pixelSize.x == 0 || key.pixelSize.y == 0)))
+        return false;
+
+    const auto MAPPED = g_imageDiskCache->load(key);
+    const bool ASYNC  = !data.sync && g_decodeScheduler;
+
+    // blocking anyway, so the pixels can be checked right here
+    if (!MAPPED || (!ASYNC && !g_imageDiskCache->verify(*MAPPED))) {
+        diskCacheKey = std::move(key);
+        return false;
+    }
+
+    g_logger->log(HT_LOG_DEBUG, "CImageElement: {} loaded from the disk cache", key.path);
+
+    lastPath   = key.path;
+    failed     = false;
+    cacheEntry = makeShared<Asset::CAssetCacheEntry>(getCacheString());
+    Asset::assetCache()->cache(cacheEntry);
+    cacheEntry->setSourceSize(MAPPED->sourceSize());
+
+    const IRenderer::STextureData TEXDATA = {.fitMode = data.fitMode, .pixels = MAPPED->pixels(), .pixelSize = MAPPED->size(), .stride = MAPPED->stride(),
+                                             .lowPrecision = lowPrecision()};
+
+    // the mapping is what the upload reads from, so it goes with it
+    auto onUploaded = [this, self = self, entry = cacheEntry, MAPPED](SP<IRendererTexture> tex) {
+        entry->texDone(tex);
+
+        if (!self || cacheEntry != entry)
+            return;
+
+        oldCacheEntry.reset();
+        postImageScheduleRecalc();
+    };
+
+    if (data.sync) {
+        onUploaded(g_renderer->uploadTexture(TEXDATA));
+        return true;
+    }
+
+    waitingForTex = true;
+
+    if (!ASYNC) {
+        g_renderer->uploadTextureAsync(TEXDATA, std::move(onUploaded));
+        return true;
+    }
+
+    // checking the pixels reads the whole file, which on a cold page cache can take a while
+    auto valid = makeShared<bool>(false);
+
+    lastDecodePriority = decodePriority();
+
+    auto ticket = g_decodeScheduler->submit(
+        "disk:" + std::string{cacheEntry->source()}, lastDecodePriority, [cache = g_imageDiskCache, MAPPED, valid] { *valid = cache->verify(*MAPPED); },
+        [this, self = self, entry = cacheEntry, valid, TEXDATA, onUploaded = std::move(onUploaded)]() mutable {
+            g_backend->addIdle([this, self, entry, VALID = *valid, TEXDATA, onUploaded = std::move(onUploaded)]() mutable {
+                if (VALID) {
+                    g_renderer->uploadTextureAsync(TEXDATA, std::move(onUploaded));
+                    return;
+                }
+
+                if (!self || cacheEntry != entry) {
+                    entry->texDone(nullptr);
+                    return;
+                }
+
+                // the file is gone now, decode the source into the same entry
+                diskFallback  = entry;
+                waitingForTex = false;
+                self->renderTex();
+            });
+        });
+
+    // the entry owns the check, so that it's cancelled once nobody waits for it anymore
+    cacheEntry->setTicket(ticket);
+    decodeTicket = ticket;
+
+    return true;
+}
+
+bool SImageImpl::lowPrecision() {
+    if (!data.icon || !g_config)
+        return false;
+
+    auto LOWPRECISION = Hyprlang::CSimpleConfigValue<Hyprlang::INT>(g_config->m_config.get(), "icon_low_precision_textures");
+    return *LOWPRECISION;
 }
 
 void SImageImpl::postImageScheduleRecalc() {
     waitingForTex = false;
     if (!failed) {
-        if (cacheEntry && cacheEntry->tex())
-            size = cacheEntry->tex()->size();
+        if (cacheEntry && cacheEntry->tex()) {
+            size = cacheEntry->sourceSize();
+
+            if (isVector())
+                Asset::svgRasterCache()->add(sourcePath(), cacheEntry);
+        }
+        self->impl->invalidateMeasure();
         self->impl->damageEntire();
 
         if (self->impl->window)
@@ -158,13 +446,27 @@ void SImageImpl::postImageScheduleRecalc() {
 }
 
 std::string SImageImpl::getCacheString() {
-    if (!data.data.empty()) // uncacheable
-        return std::format("data-{:x}", rc<uintptr_t>(data.data.data()));
+    const auto BOX = decodeTarget ? decodeTarget->box : Vector2D{};
 
-    if (!data.icon)
-        return data.path.ends_with(".svg") ? std::format("{}-{}x{}", data.path, preferredSvgSize().x, preferredSvgSize().y) : data.path;
-    else
-        return std::format("icon-{}-{}x{}", reinterpretPointerCast<CSystemIconDescription>(data.icon)->m_bestPath, preferredSvgSize().x, preferredSvgSize().y);
+    // by contents, so that the same image from different buffers is shared
+    if (!data.data.empty())
+        return BOX == Vector2D{} ? std::format("data-{:016x}-{}", dataHash, data.data.size()) :
+                                   std::format("data-{:016x}-{}@{}x{}", dataHash, data.data.size(), BOX.x, BOX.y);
+
+    if (!data.icon) {
+        if (data.path.ends_with(".svg"))
+            return std::format("{}-{}x{}", data.path, preferredSvgSize().x, preferredSvgSize().y);
+
+        return BOX == Vector2D{} ? data.path : std::format("{}@{}x{}", data.path, BOX.x, BOX.y);
+    }
+
+    const auto PATH = sourcePath();
+
+    // a raster icon is the same file at any size
+    if (!PATH.ends_with(".svg"))
+        return std::format("icon-{}", PATH);
+
+    return std::format("icon-{}-{}x{}", PATH, preferredSvgSize().x, preferredSvgSize().y);
 }
 
 SP<CImageBuilder> CImageElement::rebuild() {
@@ -177,6 +479,7 @@ SP<CImageBuilder> CImageElement::rebuild() {
 
 void CImageElement::replaceData(const SImageData& data) {
     m_impl->data = data;
+    m_impl->updateDataHash();
 
     renderTex();
 
@@ -234,7 +537,109 @@ bool CImageElement::positioningDependsOnChild() {
 }
 
 Vector2D SImageImpl::preferredSvgSize() {
-    auto max = std::max(self->impl->position.size().x, self->impl->position.size().y);
+    // an svg file that sizes itself is drawn at its own size
+    if (!data.icon && data.data.empty() && data.size.hasAuto())
+        return {};
+
+    return Asset::CSvgRasterCache::rasterSizeFor(self->impl->position.size() * lastScale);
+}
+
+bool SImageImpl::isVector() {
+    return data.data.empty() && sourcePath().ends_with(".svg");
+}
+
+std::string SImageImpl::sourcePath() {
+    if (!data.icon)
+        return data.path;
+
+    const auto ICON = reinterpretPointerCast<CSystemIconDescription>(data.icon);
+    const auto BOX  = self->impl->position.size();
+
+    // not laid out yet
+    if (BOX.x <= 0 || BOX.y <= 0)
+        return ICON->m_bestPath;
+
+    return ICON->pathFor(std::round(std::max(BOX.x, BOX.y)), std::ceil(lastScale));
+}
+
+bool SImageImpl::needsNewRaster() {
+    if (waitingForTex || self->impl->rasterQueued)
+        return false;
+
+    // the theme has a better fitting file for the new size
+    if (data.icon && !lastPath.empty() && sourcePath() != lastPath)
+        return true;
+
+    if (!isVector())
+        return false;
+
+    const auto PREFERRED = preferredSvgSize();
+    return PREFERRED != Vector2D{} && PREFERRED != size;
+}
+
+Vector2D SImageImpl::decodeBox() {
+    // svgs and icons are rendered at their size already, tiles need every pixel
+    if (data.icon || data.path.ends_with(".svg") || data.fitMode == IMAGE_FIT_MODE_TILE)
+        return {};
+
+    // with an auto size, the box comes from the image itself
+    if (data.size.hasAuto())
+        return {};
+
+    const float SCALE = self->impl->window ? self->impl->window->scale() : lastScale;
+    const auto  BOX   = self->impl->position.size() * SCALE;
+
+    if (BOX.x <= 0 || BOX.y <= 0)
+        return {};
+
+    return Vector2D{std::ceil(BOX.x / DECODE_GRANULARITY) * DECODE_GRANULARITY, std::ceil(BOX.y / DECODE_GRANULARITY) * DECODE_GRANULARITY};
+}
+
+bool SImageImpl::needsLargerDecode() {
+    if (!cacheEntry || !cacheEntry->tex())
+        return false;
+
+    const auto TEX    = cacheEntry->tex()->size();
+    const auto SOURCE = cacheEntry->sourceSize();
+
+    // already the full thing
+    if (TEX.x >= SOURCE.x && TEX.y >= SOURCE.y)
+        return false;
+
+    const auto BOX = decodeBox();
+    if (BOX == Vector2D{})
+        return true;
+
+    return BOX.x > TEX.x || BOX.y > TEX.y;
+}
+
+Asset::eDecodePriority SImageImpl::decodePriority() {
+    const auto WINDOW = self->impl->window;
+    if (!WINDOW)
+        return Asset::DECODE_PRIORITY_PREFETCH;
+
+    if (WINDOW->isElementVisible(self.lock()))
+        return Asset::DECODE_PRIORITY_VISIBLE;
+
+    const auto VIEWPORT = WINDOW->pixelSize() / WINDOW->scale();
+    if (WINDOW->isElementVisible(self.lock(), std::max(VIEWPORT.x, VIEWPORT.y)))
+        return Asset::DECODE_PRIORITY_NEAR;
+
+    return Asset::DECODE_PRIORITY_PREFETCH;
+}
+
+void SImageImpl::updateDecodePriority() {
+    if (!decodeTicket)
+        return;
+
+    const auto PRIORITY = decodePriority();
+    if (PRIORITY == lastDecodePriority)
+        return;
+
+    lastDecodePriority = PRIORITY;
+    decodeTicket->setPriority(PRIORITY);
+}
 
-    return Vector2D{max * lastScale, max * lastScale}.round();
+void SImageImpl::updateDataHash() {
+    dataHash = data.data.empty() ? 0 : Hash::xxh64(data.data.data(), data.data.size());
 }
@@ -2,6 +2,10 @@
 
 #include "../../helpers/Memory.hpp"
 #include "../../resource/assetCache/AssetCacheEntry.hpp"
+#include "../../resource/diskCache/ImageDiskCache.hpp"
+#include "../../resource/decode/DecodeScheduler.hpp"
+
+#include <optional>
 
 namespace Hyprtoolkit {
     struct SImageData {
@@ -15,6 +19,24 @@ namespace Hyprtoolkit {
         CDynamicSize               size{CDynamicSize::HT_SIZE_PERCENT, CDynamicSize::HT_SIZE_PERCENT, {1, 1}};
     };
 
+    // what a raster image gets scaled down to after decoding. Shared with the decode thread.
+    struct SImageDecodeTarget {
+        Hyprutils::Math::Vector2D box;        // pixels to cover, 0x0 for the native size
+        Hyprutils::Math::Vector2D sourceSize; // set once decoded
+    };
+
+    // a load on its way to the gpu, taken when it was started. It finishes its cache entry even if the
+    // element that started it is gone, others can be waiting on the entry.
+    struct SImageLoad {
+        SP<Asset::CAssetCacheEntry>                                           entry;
+        Hyprutils::Memory::CAtomicSharedPointer<Hyprgraphics::CImageResource> resource;
+        SP<SImageDecodeTarget>                                                target;
+        std::optional<Asset::SImageCacheKey>                                  diskCacheKey;
+        std::string                                                           path; // for logging
+        eImageFitMode                                                         fitMode      = IMAGE_FIT_MODE_STRETCH;
+        bool                                                                  lowPrecision = false, sync = false;
+    };
+
     struct SImageImpl {
         SImageData                                                            data;
 
@@ -31,11 +53,30 @@ namespace Hyprtoolkit {
 
         std::string                                                           lastPath = "";
         void*                                                                 lastData = nullptr;
+        uint64_t                                                              dataHash = 0; // of data.data
+
+        std::optional<Asset::SImageCacheKey>                                  diskCacheKey; // set while loading something the disk cache doesn't have yet
+        SP<Asset::CAssetCacheEntry>                                           diskFallback; // a disk cache load that turned out bad, renderTex decodes the source into it
+
+        SP<SImageDecodeTarget>                                                decodeTarget;
+        WP<Asset::CDecodeTicket>                                              decodeTicket; // owned by cacheEntry
+        Asset::eDecodePriority                                                lastDecodePriority = Asset::DECODE_PRIORITY_PREFETCH;
 
         Hyprutils::Math::Vector2D                                             preferredSvgSize();
-        void                                                                  postImageLoad();
+        bool                                                                  isVector(); // an svg, rasterized at the size it's drawn at
+        std::string                                                           sourcePath(); // the file, or the icon's
+        bool                                                                  needsNewRaster();
+        SImageLoad                                                            currentLoad();
+        void                                                                  postImageLoad(SImageLoad&& load);
         void                                                                  postImageScheduleRecalc();
         std::string                                                           getCacheString();
+        bool                                                                  loadFromDisk();
+        Hyprutils::Math::Vector2D                                             decodeBox();
+        bool                                                                  needsLargerDecode();
+        Asset::eDecodePriority                                                decodePriority();
+        void                                                                  updateDecodePriority();
+        void                                                                  updateDataHash();
+        bool                                                                  lowPrecision(); // may be stored lossy, icons with icon_low_precision_textures
 
         struct {
             Hyprutils::Signal::CHyprSignalListener cacheEntryDone;
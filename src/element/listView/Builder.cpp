@@ -0,0 +1,51 @@
+#include "ListView.hpp"
+
+#include <algorithm>
+
+using namespace Hyprtoolkit;
+
+SP<CListViewBuilder> CListViewBuilder::begin() {
+    SP<CListViewBuilder> p = SP<CListViewBuilder>(new CListViewBuilder());
+    p->m_data              = makeUnique<SListViewData>();
+    p->m_self              = p;
+    return p;
+}
+
+SP<CListViewBuilder> CListViewBuilder::source(SListViewDataSource&& x) {
+    m_data->source = std::move(x);
+    return m_self.lock();
+}
+
+SP<CListViewBuilder> CListViewBuilder::estimatedHeight(float x) {
+    m_data->estimatedHeight = x;
+    return m_self.lock();
+}
+
+SP<CListViewBuilder> CListViewBuilder::columns(size_t x) {
+    m_data->columns = std::max<size_t>(x, 1);
+    return m_self.lock();
+}
+
+SP<CListViewBuilder> CListViewBuilder::gap(size_t x) {
+    m_data->gap = x;
+    return m_self.lock();
+}
+
+SP<CListViewBuilder> CListViewBuilder::overscan(size_t x) {
+    m_data->overscan = x;
+    return m_self.lock();
+}
+
+SP<CListViewBuilder> CListViewBuilder::size(CDynamicSize&& s) {
+    m_data->size = std::move(s);
+    return m_self.lock();
+}
+
+SP<CListViewElement> CListViewBuilder::commence() {
+    if (m_element) {
+        m_element->replaceData(*m_data);
+        return m_element.lock();
+    }
+
+    return CListViewElement::create(*m_data);
+}
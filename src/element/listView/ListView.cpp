@@ -0,0 +1,278 @@
+#include "ListView.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <hyprtoolkit/element/ScrollArea.hpp>
+#include <hyprutils/memory/Casts.hpp>
+
+#include "../../layout/Positioner.hpp"
+#include "../../window/ToolkitWindow.hpp"
+
+#include "../Element.hpp"
+
+using namespace Hyprtoolkit;
+
+SP<CListViewElement> CListViewElement::create(const SListViewData& data) {
+    auto p          = SP<CListViewElement>(new CListViewElement(data));
+    p->impl->self   = p;
+    p->m_impl->self = p;
+    return p;
+}
+
+CListViewElement::CListViewElement(const SListViewData& data) : IElement(), m_impl(makeUnique<SListViewImpl>()) {
+    m_impl->data         = data;
+    impl->paintsNothing  = true;
+    impl->layoutOnScroll = true;
+    m_impl->reset();
+}
+
+CListViewElement::~CListViewElement() = default;
+
+void CListViewElement::replaceData(const SListViewData& data) {
+    m_impl->data = data;
+    reload();
+}
+
+SP<CListViewBuilder> CListViewElement::rebuild() {
+    auto p       = SP<CListViewBuilder>(new CListViewBuilder());
+    p->m_self    = p;
+    p->m_data    = makeUnique<SListViewData>(m_impl->data);
+    p->m_element = m_impl->self;
+    return p;
+}
+
+void CListViewElement::reload() {
+    m_impl->reset();
+
+    if (impl->window)
+        impl->window->scheduleReposition(impl->self);
+}
+
+void CListViewElement::scrollToItem(size_t idx) {
+    const auto AREA = m_impl->scrollArea();
+    if (!AREA)
+        return;
+
+    m_impl->heights.resize(m_impl->rows());
+
+    // our top, in the scroll area's content
+    const auto SCROLL = AREA->getCurrentScroll();
+    const auto TOP    = impl->position.y - AREA->impl->position.y + SCROLL.y;
+
+    AREA->setScroll({SCROLL.x, TOP + m_impl->heights.offset(idx / m_impl->data.columns)});
+}
+
+void CListViewElement::paint() {
+    ; // no-op, items paint themselves
+}
+
+void CListViewElement::reposition(const Hyprutils::Math::CBox& box, const Hyprutils::Math::Vector2D& maxSize) {
+    IElement::reposition(box);
+
+    const auto  COLUMNS  = m_impl->data.columns;
+    const auto  GAP      = m_impl->data.gap;
+    const auto  OVERSCAN = m_impl->data.overscan;
+    const float COLUMN_W = std::max(0.0, (box.w - (GAP * (COLUMNS - 1.0))) / COLUMNS);
+
+    // items measure differently at another width
+    if (COLUMN_W != m_impl->columnWidth) {
+        m_impl->reset();
+        m_impl->columnWidth = COLUMN_W;
+    }
+
+    auto&      heights = m_impl->heights;
+    const auto ROWS    = m_impl->rows();
+    heights.resize(ROWS);
+
+    // we are usually way taller than our parent (a scroll area), only what it shows gets items
+    CBox visible = box;
+    if (impl->parent)
+        visible = visible.intersection(impl->parent->impl->position);
+
+    if (visible.empty() || ROWS == 0) {
+        m_impl->recycleOutside(0, 0);
+        return;
+    }
+
+    const double TOP    = visible.y - box.y;
+    const double BOTTOM = TOP + visible.h;
+
+    // what's at the top stays there, whatever the rows above it turn out to measure
+    const size_t ANCHOR   = heights.rowAt(TOP);
+    const double ANCHOR_Y = heights.offset(ANCHOR);
+    const double TOTAL    = heights.total();
+    const size_t FIRST    = ANCHOR - std::min(ANCHOR, OVERSCAN);
+
+    // let go of what's nowhere near first, so scrolling reuses instead of creating
+    m_impl->recycleOutside(FIRST, heights.rowAt(BOTTOM) + 1 + OVERSCAN);
+
+    // measuring changes the offsets, rows are filled in until the visible part is
+    size_t last = ANCHOR;
+    while (last < ROWS && heights.offset(last) < BOTTOM) {
+        m_impl->measureRow(last++);
+    }
+
+    for (size_t i = 0; i < OVERSCAN && last < ROWS; ++i) {
+        m_impl->measureRow(last++);
+    }
+
+    for (size_t row = FIRST; row < ANCHOR; ++row) {
+        m_impl->measureRow(row);
+    }
+
+    m_impl->recycleOutside(FIRST, last);
+
+    double     shift = 0;
+    const auto DELTA = heights.offset(ANCHOR) - ANCHOR_Y;
+
+    if (DELTA != 0 || heights.total() != TOTAL) {
+        impl->invalidateMeasure();
+
+        // scroll by as much as the rows above moved the anchor, placing items where that scroll will have them already
+        if (const auto AREA = m_impl->scrollArea(); AREA && DELTA != 0) {
+            const auto SCROLL = AREA->getCurrentScroll();
+            AREA->setScroll(SCROLL + Vector2D{0, DELTA});
+            shift = std::round(AREA->getCurrentScroll().y) - std::round(SCROLL.y);
+        }
+
+        if (impl->window)
+            impl->window->scheduleReposition(impl->self);
+    }
+
+    for (const auto& [IDX, ITEM] : m_impl->bound) {
+        const auto ROW = IDX / COLUMNS;
+        const auto COL = IDX % COLUMNS;
+
+        g_positioner->position(ITEM, {box.x + (COL * (COLUMN_W + GAP)), box.y - shift + heights.offset(ROW), COLUMN_W, heights.height(ROW)});
+    }
+}
+
+Hyprutils::Math::Vector2D CListViewElement::size() {
+    return impl->position.size();
+}
+
+std::optional<Vector2D> CListViewElement::preferredSize(const Hyprutils::Math::Vector2D& parent) {
+    auto s = m_impl->data.size.calculate(parent);
+
+    if (s.x == -1)
+        s.x = parent.x;
+    if (s.y == -1) {
+        m_impl->heights.resize(m_impl->rows());
+        s.y = m_impl->heights.total();
+    }
+
+    return s;
+}
+
+std::optional<Vector2D> CListViewElement::minimumSize(const Hyprutils::Math::Vector2D& parent) {
+    return Vector2D{0, 0};
+}
+
+std::optional<Vector2D> CListViewElement::maximumSize(const Hyprutils::Math::Vector2D& parent) {
+    return std::nullopt;
+}
+
+bool CListViewElement::positioningDependsOnChild() {
+    return false;
+}
+
+void SListViewImpl::reset() {
+    while (!bound.empty()) {
+        recycle(bound.begin()->first);
+    }
+
+    heights.reset(rows(), data.estimatedHeight, data.gap);
+    columnWidth = -1.F;
+}
+
+size_t SListViewImpl::count() {
+    return data.source.count ? data.source.count() : 0;
+}
+
+size_t SListViewImpl::rows() {
+    return (count() + data.columns - 1) / data.columns;
+}
+
+SP<IElement> SListViewImpl::itemFor(size_t idx) {
+    if (const auto IT = bound.find(idx); IT != bound.end())
+        return IT->second;
+
+    SP<IElement> item;
+    if (!pool.empty()) {
+        item = pool.back();
+        pool.pop_back();
+    } else if (data.source.create)
+        item = data.source.create();
+
+    if (!item)
+        return nullptr;
+
+    // attached without addChild, we're in the middle of laying it out. Recycled ones kept the window, so only new ones set it
+    const auto& LIST = self->impl;
+    item->impl->parent = LIST->self;
+    if (item->impl->window.get() != LIST->window.get())
+        item->impl->breadthfirst([w = LIST->window.lock()](SP<IElement> e) { e->impl->setWindow(w); });
+    LIST->children.emplace_back(item);
+    bound.emplace(idx, item);
+
+    if (data.source.bind)
+        data.source.bind(item, idx);
+
+    // whatever it measured for the last index it had doesn't hold, and it's painted again wherever it goes
+    item->impl->resetMeasureCache();
+    item->impl->breadthfirst([](SP<IElement> e) {
+        if (e->impl->positionerData)
+            e->impl->positionerData->scrolled = false;
+    });
+
+    return item;
+}
+
+void SListViewImpl::recycle(size_t idx) {
+    const auto IT = bound.find(idx);
+    if (IT == bound.end())
+        return;
+
+    auto item = IT->second;
+    bound.erase(IT);
+
+    if (data.source.unbind)
+        data.source.unbind(item, idx);
+
+    std::erase(self->impl->children, item);
+    item->impl->parent.reset();
+    pool.emplace_back(item);
+}
+
+void SListViewImpl::recycleOutside(size_t first, size_t last) {
+    std::vector<size_t> outside;
+    for (const auto& [IDX, _] : bound) {
+        const auto ROW = IDX / data.columns;
+        if (ROW < first || ROW >= last)
+            outside.emplace_back(IDX);
+    }
+
+    for (const auto& idx : outside) {
+        recycle(idx);
+    }
+}
+
+float SListViewImpl::measureRow(size_t row) {
+    const auto COUNT  = count();
+    float      height = 0.F;
+
+    for (size_t idx = row * data.columns; idx < std::min(COUNT, (row + 1) * data.columns); ++idx) {
+        const auto ITEM = itemFor(idx);
+        if (!ITEM)
+            continue;
+
+        height = std::max(height, sc<float>(ITEM->impl->measurePreferred({columnWidth, data.estimatedHeight}).value_or(Vector2D{0, data.estimatedHeight}).y));
+    }
+
+    heights.set(row, height);
+    return height;
+}
+
+CScrollAreaElement* SListViewImpl::scrollArea() {
+    return dynamic_cast<CScrollAreaElement*>(self->impl->parent.lock().get());
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <hyprtoolkit/element/ListView.hpp>
+
+#include <unordered_map>
+
+#include "RowHeights.hpp"
+#include "../../helpers/Memory.hpp"
+
+namespace Hyprtoolkit {
+    class CScrollAreaElement;
+
+    struct SListViewData {
+        SListViewDataSource source;
+        float               estimatedHeight = 30.F;
+        size_t              columns         = 1;
+        size_t              gap             = 0;
+        size_t              overscan        = 2;
+        CDynamicSize        size{CDynamicSize::HT_SIZE_PERCENT, CDynamicSize::HT_SIZE_AUTO, {1, 1}};
+    };
+
+    struct SListViewImpl {
+        SListViewData        data;
+
+        WP<CListViewElement> self;
+
+        CRowHeights          heights;
+        float                columnWidth = -1.F;
+
+        // items by the index they're bound to, and the ones free for reuse
+        std::unordered_map<size_t, SP<IElement>> bound;
+        std::vector<SP<IElement>>                pool;
+
+        void                                     reset();
+        size_t                                   count();
+        size_t                                   rows();
+        SP<IElement>                             itemFor(size_t idx);
+        void                                     recycle(size_t idx);
+        void                                     recycleOutside(size_t first, size_t last); // rows, last exclusive
+        float                                    measureRow(size_t row);
+        CScrollAreaElement*                      scrollArea();
+    };
+}
@@ -0,0 +1,99 @@
+#include "RowHeights.hpp"
+
+#include <algorithm>
+#include <bit>
+
+using namespace Hyprtoolkit;
+
+void CRowHeights::reset(size_t rows, float estimate, float gap) {
+    m_estimate = estimate;
+    m_gap      = gap;
+    m_heights.assign(rows, estimate);
+    m_measured.assign(rows, false);
+    rebuild();
+}
+
+void CRowHeights::resize(size_t rows) {
+    if (rows == m_heights.size())
+        return;
+
+    m_heights.resize(rows, m_estimate);
+    m_measured.resize(rows, false);
+    rebuild();
+}
+
+void CRowHeights::set(size_t row, float height) {
+    if (row >= m_heights.size())
+        return;
+
+    m_measured[row] = true;
+
+    const double DELTA = height - m_heights[row];
+    if (DELTA == 0)
+        return;
+
+    m_heights[row] = height;
+
+    for (size_t i = row + 1; i < m_tree.size(); i += i & -i) {
+        m_tree[i] += DELTA;
+    }
+}
+
+float CRowHeights::height(size_t row) const {
+    return row < m_heights.size() ? m_heights[row] : m_estimate;
+}
+
+bool CRowHeights::measured(size_t row) const {
+    return row < m_measured.size() && m_measured[row];
+}
+
+double CRowHeights::offset(size_t row) const {
+    return prefix(std::min(row, m_heights.size()));
+}
+
+size_t CRowHeights::rowAt(double y) const {
+    if (m_heights.empty() || y <= 0)
+        return 0;
+
+    // walk down the tree: the most rows that still end at or above y
+    size_t pos = 0;
+    for (size_t step = std::bit_floor(m_heights.size()); step > 0; step >>= 1) {
+        if (pos + step < m_tree.size() && m_tree[pos + step] <= y) {
+            pos += step;
+            y -= m_tree[pos];
+        }
+    }
+
+    return std::min(pos, m_heights.size() - 1);
+}
+
+double CRowHeights::total() const {
+    if (m_heights.empty())
+        return 0;
+
+    return prefix(m_heights.size()) - m_gap;
+}
+
+size_t CRowHeights::rows() const {
+    return m_heights.size();
+}
+
+void CRowHeights::rebuild() {
+    m_tree.assign(m_heights.size() + 1, 0);
+
+    for (size_t i = 1; i < m_tree.size(); ++i) {
+        m_tree[i] += m_heights[i - 1] + m_gap;
+
+        const auto PARENT = i + (i & -i);
+        if (PARENT < m_tree.size())
+            m_tree[PARENT] += m_tree[i];
+    }
+}
+
+double CRowHeights::prefix(size_t n) const {
+    double sum = 0;
+    for (size_t i = n; i > 0; i -= i & -i) {
+        sum += m_tree[i];
+    }
+    return sum;
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace Hyprtoolkit {
+
+    // Heights of a list's rows, estimated until measured. Offsets and lookups are logarithmic (a Fenwick tree
+    // over height + gap), so a measure deep in a long list doesn't mean summing everything above it.
+    class CRowHeights {
+      public:
+        // all rows estimated
+        void   reset(size_t rows, float estimate, float gap);
+        // new rows are estimated, the rest keep what they have
+        void   resize(size_t rows);
+
+        void   set(size_t row, float height);
+        float  height(size_t row) const;
+        bool   measured(size_t row) const;
+
+        double offset(size_t row) const; // top of it
+        size_t rowAt(double y) const;    // the row at y, clamped to the ones there are
+        double total() const;
+        size_t rows() const;
+
+      private:
+        void                rebuild();
+        double              prefix(size_t n) const;
+
+        std::vector<float>  m_heights;
+        std::vector<bool>   m_measured;
+        std::vector<double> m_tree; // 1-based
+        float               m_estimate = 0.F, m_gap = 0.F;
+    };
+}
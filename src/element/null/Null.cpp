@@ -16,7 +16,8 @@ SP<CNullElement> CNullElement::create(const SNullData& data) {
 }
 
 CNullElement::CNullElement(const SNullData& data) : IElement(), m_impl(makeUnique<SNullImpl>()) {
-    m_impl->data = data;
+    m_impl->data        = data;
+    impl->paintsNothing = true;
 }
 
 void CNullElement::paint() {
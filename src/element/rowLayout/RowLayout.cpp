@@ -2,6 +2,7 @@
 #include <cmath>
 
 #include "../../layout/Positioner.hpp"
+#include "../../layout/StackSolver.hpp"
 #include "../../renderer/Renderer.hpp"
 #include "../../core/InternalBackend.hpp"
 #include "../../window/ToolkitWindow.hpp"
@@ -18,7 +19,8 @@ SP<CRowLayoutElement> CRowLayoutElement::create(const SRowLayoutData& data) {
 }
 
 CRowLayoutElement::CRowLayoutElement(const SRowLayoutData& data) : IElement(), m_impl(makeUnique<SRowLayoutImpl>()) {
-    m_impl->data = data;
+    m_impl->data        = data;
+    impl->paintsNothing = true;
 }
 
 void CRowLayoutElement::paint() {
@@ -41,122 +43,40 @@ void CRowLayoutElement::reposition(const Hyprutils::Math::CBox& sbox, const Hypr
 
     // position children in this layout.
 
-    float               usedX = 0;
-    const float         MAX_X = (uint64_t)impl->position.size().x;
-
-    size_t              i = 0;
+    const float              MAX_X = (uint64_t)impl->position.size().x;
 
-    std::vector<size_t> widths;
-    widths.resize(impl->children.size());
+    std::vector<SStackChild> items;
+    items.reserve(C.size());
 
-    for (i = 0; i < C.size(); ++i) {
-        const auto& child = C.at(i);
-
-        Vector2D    cSize = childSize(child);
+    for (const auto& child : C) {
+        Vector2D cSize = childSize(child);
         if (cSize == Vector2D{-1, -1})
             cSize = {1.F, box.h};
 
-        if (usedX + cSize.x > MAX_X + 2 /* FIXME: WHERE THE FUCK IS THIS LOST??? */) {
-            // we exceeded our available space.
-            if (!child->minimumSize(box.size())) {
-                // doesn't fit: disable
-                child->impl->setFailedPositioning(true);
-                continue;
-            }
-
-            cSize = *child->minimumSize(box.size());
-
-            if (usedX + cSize.x > MAX_X + 1) {
-                // doesn't fit: try to shrink any previous element if it allows to do so
-                // FIXME: if we resize and fail to fit, it will mess up the layout a bit
-                float needs = (usedX + cSize.x) - (MAX_X + 1);
-                for (int j = i - 1; j >= 0; --j) {
-                    const auto& prevChild = C.at(j);
-                    const auto  MIN       = prevChild->minimumSize(impl->position.size());
-                    if (!MIN.has_value()) {
-                        // we can shrink this child to zero
-                        if (needs > widths.at(j)) {
-                            widths.at(j) -= needs - widths.at(j);
-                            needs -= needs - widths.at(j);
-                            continue;
-                        }
-
-                        widths.at(j) -= needs;
-                        needs = 0;
-                        break; // done
-                    } else if (MIN->x < widths.at(j)) {
-                        // we can shrink it a bit
-                        if (needs > (widths.at(j) - MIN->x)) {
-                            widths.at(j) -= needs - (widths.at(j) - MIN->x);
-                            needs -= needs - (widths.at(j) - MIN->x);
-                            continue;
-                        }
-
-                        widths.at(j) -= needs;
-                        needs = 0;
-                        break; // done
-                    }
-                }
-
-                if (needs > 0) {
-                    // doesn't fit: disable and expand the last if possible
-                    child->impl->setFailedPositioning(true);
-                    if (i != 0) {
-                        // try to expand last child
-                        const auto& lastChild = C.at(i - 1);
-
-                        if (lastChild->maximumSize(box.size()) && widths.at(i - 1) + MAX_X - usedX > lastChild->maximumSize(box.size())->x)
-                            continue; // too bad, we'll have a gap
-
-                        widths.at(i - 1) += MAX_X - usedX;
-                    }
-                    continue;
-                } else {
-
-                    child->impl->setFailedPositioning(false);
-                    widths.at(i) = cSize.x;
-
-                    // recalc usedX cuz we changed stuff
-                    usedX = 0;
-                    for (const auto& w : widths) {
-                        usedX += w + m_impl->data.gap;
-                    }
-
-                    continue;
-                }
-            }
-
-            // squeeze the last element in
-            widths.at(i) = MAX_X - usedX;
-            continue;
-        }
+        const auto MIN = child->impl->measureMinimum(box.size());
+        const auto MAX = child->impl->measureMaximum(box.size());
 
-        // can fit: use preferred
-        widths.at(i) = cSize.x;
-        child->impl->setFailedPositioning(false);
-        usedX += cSize.x + m_impl->data.gap;
+        items.emplace_back(SStackChild{
+            .size = cSize.x,
+            .min  = MIN ? std::optional<double>{MIN->x} : std::nullopt,
+            .max  = MAX ? std::optional<double>{MAX->x} : std::nullopt,
+            .grow = child->impl->growH,
+        });
     }
 
-    if (!C.empty())
-        usedX -= m_impl->data.gap;
-
-    // check if any element grows and grow if applicable
-    if (usedX < MAX_X) {
-        for (i = 0; i < C.size(); ++i) {
-            const auto& child = C.at(i);
+    // FIXME: the 2 is lost somewhere
+    const auto  SOLVED = solveStack(items, MAX_X, m_impl->data.gap, {.overflowSlack = 2, .tryMinimum = true});
+    const auto& widths = SOLVED.sizes;
+    const auto  usedX  = SOLVED.used;
 
-            if (!child->impl->growH)
-                continue;
-
-            widths.at(i) += MAX_X - usedX;
-            break;
-        }
+    for (size_t i = 0; i < C.size(); ++i) {
+        C.at(i)->impl->setFailedPositioning(SOLVED.failed.at(i));
     }
 
     // widths done: lay out elements
     size_t currentX = 0;
 
-    for (i = 0; i < C.size(); ++i) {
+    for (size_t i = 0; i < C.size(); ++i) {
         const auto& child = C.at(i);
 
         if (child->impl->failedPositioning)
@@ -164,6 +84,10 @@ void CRowLayoutElement::reposition(const Hyprutils::Math::CBox& sbox, const Hypr
 
         Vector2D cSize = childSize(child);
 
+        // given less width than it asked for, it might need more height for it
+        if (widths.at(i) + 1 < cSize.x)
+            cSize = child->impl->measurePreferred({(double)widths.at(i), impl->position.h}).value_or(cSize);
+
         cSize.y = std::clamp(cSize.y, 0.0, impl->position.h);
 
         CBox childBox = CBox{box.x + currentX, box.y + ((box.h - cSize.y) / 2), (double)widths.at(i), cSize.y};
@@ -177,10 +101,10 @@ void CRowLayoutElement::reposition(const Hyprutils::Math::CBox& sbox, const Hypr
 }
 
 Hyprutils::Math::Vector2D CRowLayoutElement::childSize(Hyprutils::Memory::CSharedPointer<IElement> child) {
-    if (child->preferredSize(impl->position.size()))
-        return *child->preferredSize(impl->position.size());
-    else if (child->minimumSize(impl->position.size()))
-        return *child->minimumSize(impl->position.size());
+    if (child->impl->measurePreferred(impl->position.size()))
+        return *child->impl->measurePreferred(impl->position.size());
+    else if (child->impl->measureMinimum(impl->position.size()))
+        return *child->impl->measureMinimum(impl->position.size());
     return {-1, -1};
 }
 
@@ -18,8 +18,9 @@ SP<CScrollAreaElement> CScrollAreaElement::create(const SScrollAreaData& data) {
 }
 
 CScrollAreaElement::CScrollAreaElement(const SScrollAreaData& data) : IElement(), m_impl(makeUnique<SScrollAreaImpl>()) {
-    m_impl->data       = data;
-    impl->clipChildren = true;
+    m_impl->data        = data;
+    impl->clipChildren  = true;
+    impl->paintsNothing = true;
 
     m_impl->listeners.axis = impl->m_externalEvents.mouseAxis.listen([this](Input::eAxisAxis axis, float delta) {
         if (m_impl->data.blockUserScroll)
@@ -32,15 +33,15 @@ CScrollAreaElement::CScrollAreaElement(const SScrollAreaData& data) : IElement()
         if (!SCROLLING_X && !m_impl->data.scrollY)
             return;
 
+        const auto BEFORE = m_impl->data.currentScroll;
+
         if (SCROLLING_X)
             m_impl->data.currentScroll.x += delta;
         else
             m_impl->data.currentScroll.y += delta;
 
         m_impl->clampMaxScroll();
-
-        if (impl->window)
-            impl->window->scheduleReposition(impl->self);
+        m_impl->moveContent(BEFORE);
     });
 }
 
@@ -77,11 +78,11 @@ Vector2D CScrollAreaElement::getCurrentScroll() {
 }
 
 void CScrollAreaElement::setScroll(const Hyprutils::Math::Vector2D& x) {
+    const auto BEFORE = m_impl->data.currentScroll;
+
     m_impl->data.currentScroll = x;
     m_impl->clampMaxScroll();
-
-    if (impl->window)
-        impl->window->scheduleReposition(impl->self);
+    m_impl->moveContent(BEFORE);
 }
 
 std::optional<Vector2D> CScrollAreaElement::preferredSize(const Vector2D& parent) {
@@ -113,8 +114,9 @@ void SScrollAreaImpl::clampMaxScroll() {
     if (self->impl->children.empty() || !self->impl->children.at(0)->impl->positionerData)
         return;
 
+    // memoized, so only measured again once the content changed
     Vector2D scrollMax = (self->impl->children.at(0)
-                              ->preferredSize({
+                              ->impl->measurePreferred({
                                   data.scrollX ? 99999999999 : self->impl->position.w,
                                   data.scrollY ? 99999999999 : self->impl->position.h,
                               })
@@ -124,3 +126,25 @@ void SScrollAreaImpl::clampMaxScroll() {
 
     data.currentScroll = data.currentScroll.clamp({}, scrollMax);
 }
+
+void SScrollAreaImpl::moveContent(const Vector2D& before) {
+    // content is laid out at whole pixels, see CScrollAreaElement::reposition
+    const auto DELTA = before.round() - data.currentScroll.round();
+    if (DELTA == Vector2D{})
+        return;
+
+    // never laid out, nothing to move
+    if (!self->impl->positionerData) {
+        if (self->impl->window)
+            self->impl->window->scheduleReposition(self->impl->self);
+        return;
+    }
+
+    // a scroll doesn't change the content's layout, only where it is
+    for (const auto& c : self->impl->children) {
+        c->impl->translate(DELTA);
+    }
+
+    if (self->impl->window)
+        self->impl->window->damageScroll(self->impl->self.lock(), DELTA);
+}
@@ -18,6 +18,7 @@ namespace Hyprtoolkit {
         WP<CScrollAreaElement> self;
 
         void                   clampMaxScroll();
+        void                   moveContent(const Hyprutils::Math::Vector2D& before); // the scroll was before, moves the content to where it is now
 
         struct {
             CHyprSignalListener axis;
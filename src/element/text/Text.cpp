@@ -1,6 +1,7 @@
 #include "Text.hpp"
 
 #include <cmath>
+#include <cstring>
 #include <hyprtoolkit/palette/Palette.hpp>
 #include <hyprgraphics/color/Color.hpp>
 #include <pango-1.0/pango/pangocairo.h>
@@ -15,6 +16,7 @@
 #include "../Element.hpp"
 #include "../../helpers/UTF8.hpp"
 #include "../../system/DesktopMethods.hpp"
+#include "../../system/Fonts.hpp"
 
 using namespace Hyprtoolkit;
 using namespace Hyprgraphics;
@@ -31,6 +33,7 @@ CTextElement::CTextElement(const STextData& data) : IElement(), m_impl(makeUniqu
     m_impl->parseText();
     m_impl->lastFontSizeUnscaled = m_impl->data.fontSize.ptSize();
     m_impl->preferred            = m_impl->getTextSizePreferred();
+    m_impl->updateNatural();
 
     impl->m_externalEvents.mouseMove.listenStatic([this](const Vector2D& pos) {
         m_impl->lastCursorPos = pos;
@@ -55,7 +58,8 @@ void CTextElement::replaceData(const STextData& data) {
     if (m_impl->lastFontSizeUnscaled != m_impl->data.fontSize.ptSize() || TEXT_DIFFERENT) {
         m_impl->parseText();
         m_impl->lastFontSizeUnscaled = m_impl->data.fontSize.ptSize();
-        m_impl->preferred            = m_impl->getTextSizePreferred();
+        m_impl->updateNatural();
+        m_impl->updatePreferred();
         m_impl->scheduleTexRefresh();
     }
 
@@ -83,11 +87,25 @@ void CTextElement::paint() {
         return;
     }
 
-    if ((impl->window && impl->window->scale() != m_impl->lastScale) || m_impl->needsTexRefresh) {
+    if (m_impl->needsTexRefresh) {
         m_impl->lastScale = impl->window ? impl->window->scale() : 1.F;
-        m_impl->preferred = m_impl->getTextSizePreferred();
+        m_impl->updatePreferred();
         m_impl->renderTex();
-        textureToUse = m_impl->oldTex;
+        // sync renders are already done here
+        textureToUse = m_impl->tex ? m_impl->tex : m_impl->oldTex;
+    } else if (impl->window && impl->window->scale() != m_impl->texScale && !m_impl->waitingForTex && !impl->rasterQueued) {
+        // only blurry, not wrong. Let the window decide when it's our turn.
+        impl->rasterQueued = true;
+        impl->window->scheduleRaster(impl->self, [this] {
+            impl->rasterQueued = false;
+
+            if (!impl->window || impl->window->scale() == m_impl->texScale || m_impl->waitingForTex)
+                return;
+
+            m_impl->lastScale = impl->window->scale();
+            m_impl->updatePreferred();
+            m_impl->renderTex();
+        });
     }
 
     if (!textureToUse)
@@ -99,7 +117,7 @@ void CTextElement::paint() {
     }
 
     CBox     renderBox      = impl->position;
-    Vector2D texSizeLogical = m_impl->size / impl->window->scale();
+    Vector2D texSizeLogical = m_impl->size / m_impl->texScale;
     if (impl->positionFlags & HT_POSITION_FLAG_HCENTER)
         renderBox.translate({(renderBox.size() - texSizeLogical).x / 2, 0.F});
     if (impl->positionFlags & HT_POSITION_FLAG_VCENTER)
@@ -134,10 +152,11 @@ void CTextElement::reposition(const Hyprutils::Math::CBox& box, const Hyprutils:
 
         if (PREV != m_impl->lastMaxSize) {
             m_impl->needsTexRefresh = true;
-            const auto LAST_PREF    = m_impl->preferred;
             m_impl->lastScale       = impl->window ? impl->window->scale() : 1.F;
-            m_impl->preferred       = m_impl->getTextSizePreferred();
-            if (impl->window && (std::abs(LAST_PREF.x - m_impl->preferred.x) > 2 || std::abs(LAST_PREF.y - m_impl->preferred.y) > 2))
+            m_impl->updatePreferred();
+
+            // the parent measured it for this width already, so it fits unless it was placed without asking
+            if (impl->window && (m_impl->preferred.x > SIZE.x + 2 || m_impl->preferred.y > SIZE.y + 2))
                 impl->window->scheduleReposition(impl->self.lock());
         }
     }
@@ -158,7 +177,11 @@ std::optional<Vector2D> CTextElement::maximumSize(const Hyprutils::Math::Vector2
 }
 
 std::optional<Vector2D> CTextElement::preferredSize(const Hyprutils::Math::Vector2D& parent) {
-    return m_impl->preferred;
+    // height for width: offered less than it'd like, it wraps and grows taller
+    if (m_impl->wraps() && parent.x > 0 && parent.x + 1 < m_impl->natural.x)
+        return m_impl->sizeForWidth(parent.x);
+
+    return m_impl->natural;
 }
 
 std::optional<Vector2D> CTextElement::minimumSize(const Hyprutils::Math::Vector2D& parent) {
@@ -177,16 +200,14 @@ bool CTextElement::positioningDependsOnChild() {
     return m_impl->data.size.hasAuto();
 }
 
-std::tuple<UP<Hyprgraphics::CCairoSurface>, cairo_t*, PangoLayout*, Vector2D> STextImpl::prepPangoLayout() {
-    auto                  CAIROSURFACE = makeUnique<CCairoSurface>(cairo_image_surface_create(CAIRO_FORMAT_ARGB32, 1, 1 /* dummy value */));
-    auto                  CAIRO        = cairo_create(CAIROSURFACE->cairo());
+std::tuple<PangoLayout*, Vector2D> STextImpl::prepPangoLayout() {
+    return prepPangoLayout(data.clampSize.value_or(lastMaxSize));
+}
 
-    PangoLayout*          layout = pango_cairo_create_layout(CAIRO);
+std::tuple<PangoLayout*, Vector2D> STextImpl::prepPangoLayout(const Vector2D& maxSizeUnscaled) {
+    PangoLayout* layout = g_fontManager->createLayout();
 
-    PangoFontDescription* fontDesc = pango_font_description_from_string(data.fontFamily.c_str());
-    pango_font_description_set_size(fontDesc, std::round(lastFontSizeUnscaled * lastScale) * PANGO_SCALE);
-    pango_layout_set_font_description(layout, fontDesc);
-    pango_font_description_free(fontDesc);
+    pango_layout_set_font_description(layout, g_fontManager->fontDescription(data.fontFamily, sc<int>(std::round(lastFontSizeUnscaled * lastScale) * PANGO_SCALE)));
 
     if (data.align == HT_FONT_ALIGN_LEFT)
         pango_layout_set_alignment(layout, PANGO_ALIGN_LEFT);
@@ -221,7 +242,7 @@ std::tuple<UP<Hyprgraphics::CCairoSurface>, cairo_t*, PangoLayout*, Vector2D> ST
     PangoRectangle ink, logical;
     pango_layout_get_pixel_extents(layout, &ink, &logical);
 
-    std::optional<Vector2D> maxSize = data.clampSize.value_or(lastMaxSize).round();
+    std::optional<Vector2D> maxSize = maxSizeUnscaled.round();
     if (maxSize == Vector2D{0, 0})
         maxSize = std::nullopt;
 
@@ -244,20 +265,54 @@ std::tuple<UP<Hyprgraphics::CCairoSurface>, cairo_t*, PangoLayout*, Vector2D> ST
 
     pango_layout_get_pixel_extents(layout, &ink, &logical);
 
-    return std::make_tuple<>(std::move(CAIROSURFACE), CAIRO, layout, Vector2D{logical.width, logical.height});
+    return std::make_tuple<>(layout, Vector2D{logical.width, logical.height});
+}
+
+void STextImpl::updatePreferred() {
+    preferred = getTextSizePreferred();
+
+    // measures are in logical pixels, but rounded at the scale's font size
+    if (lastScale != naturalScale)
+        updateNatural();
+}
+
+void STextImpl::updateNatural() {
+    natural      = getTextSizeFor(data.clampSize.value_or(Vector2D{}));
+    naturalScale = lastScale;
+    fitted       = {};
+
+    if (self)
+        self->impl->invalidateMeasure();
+}
+
+bool STextImpl::wraps() {
+    // the same as what reposition clamps the layout to
+    return !data.noEllipsize && !data.clampSize && natural.x > 0 && natural.y > 0;
+}
+
+Vector2D STextImpl::sizeForWidth(double width) {
+    if (fitted.width != width) {
+        fitted.width = width;
+        fitted.size  = getTextSizeFor({width, -1});
+    }
+
+    return fitted.size;
 }
 
 Hyprutils::Math::Vector2D STextImpl::getTextSizePreferred() {
-    auto [CAIROSURFACE, CAIRO, LAYOUT, LAYOUTSIZE] = prepPangoLayout();
+    return getTextSizeFor(data.clampSize.value_or(lastMaxSize));
+}
+
+Hyprutils::Math::Vector2D STextImpl::getTextSizeFor(const Vector2D& maxSize) {
+    auto [LAYOUT, LAYOUTSIZE] = prepPangoLayout(maxSize);
 
     g_object_unref(LAYOUT);
-    cairo_destroy(CAIRO);
 
     return LAYOUTSIZE / lastScale;
 }
 
 CBox STextImpl::getCharBox(size_t offset) {
-    auto [CAIROSURFACE, CAIRO, LAYOUT, LAYOUTSIZE] = prepPangoLayout();
+    auto [LAYOUT, LAYOUTSIZE] = prepPangoLayout();
 
     PangoRectangle rect;
 
@@ -273,13 +328,12 @@ CBox STextImpl::getCharBox(size_t offset) {
             .scale(1.F / lastScale);
 
     g_object_unref(LAYOUT);
-    cairo_destroy(CAIRO);
 
     return charBox;
 }
 
 std::optional<size_t> STextImpl::vecToOffset(const Vector2D& vec) {
-    auto [CAIROSURFACE, CAIRO, LAYOUT, LAYOUTSIZE] = prepPangoLayout();
+    auto [LAYOUT, LAYOUTSIZE] = prepPangoLayout();
 
     auto pangoX = sc<int>(vec.x * PANGO_SCALE), //
         pangoY  = sc<int>(vec.y * PANGO_SCALE);
@@ -287,13 +341,22 @@ std::optional<size_t> STextImpl::vecToOffset(const Vector2D& vec) {
     int index = 0, trailing = 0;
     pango_layout_xy_to_index(LAYOUT, pangoX, pangoY, &index, &trailing);
 
-    g_object_unref(LAYOUT);
-    cairo_destroy(CAIRO);
-
-    if (index == -1)
+    if (index == -1) {
+        g_object_unref(LAYOUT);
         return std::nullopt;
+    }
 
-    return index + trailing;
+    // index is in bytes, trailing in codepoints of the grapheme that was hit
+    const char*  TEXT   = pango_layout_get_text(LAYOUT);
+    const size_t LEN    = std::strlen(TEXT);
+    size_t       offset = index;
+    for (int i = 0; i < trailing && offset < LEN; ++i) {
+        offset += UTF8::codepointLen(TEXT + offset, LEN - offset);
+    }
+
+    g_object_unref(LAYOUT);
+
+    return offset;
 }
 
 float STextImpl::getCursorPos(size_t offset) {
@@ -315,26 +378,27 @@ float STextImpl::getCursorPos(const Hyprutils::Math::Vector2D& click) {
 Vector2D STextImpl::unscale(const Vector2D& x) {
     if (!self->impl->window)
         return x + Vector2D{self->impl->margin * 2, self->impl->margin * 2};
-    return (x + Vector2D{self->impl->margin * 2, self->impl->margin * 2}) / self->impl->window->scale();
+    return (x + Vector2D{self->impl->margin * 2, self->impl->margin * 2}) / texScale;
 }
 
 void STextImpl::scheduleTexRefresh() {
-    if (data.async) {
-        needsTexRefresh = true;
-        return;
-    }
+    needsTexRefresh = true;
 }
 
 void STextImpl::renderTex() {
-    oldTex          = tex;
+    // tex is empty while the last one is still loading, what's on screen stays until the new one is up
+    if (tex)
+        oldTex = tex;
     needsTexRefresh = false;
+    texGeneration++;
 
     resource.reset();
     tex.reset();
 
     waitingForTex = true;
 
-    lastScale = self->impl->window ? self->impl->window->scale() : 1.F;
+    lastScale       = self->impl->window ? self->impl->window->scale() : 1.F;
+    pendingTexScale = lastScale;
 
     self->impl->damageEntire();
 
@@ -387,20 +451,33 @@ void STextImpl::postTexLoad() {
         return;
 
     ASP<IAsyncResource> resourceGeneric(resource);
-    size = resource->m_asset.pixelSize;
-    tex  = g_renderer->uploadTexture({.resource = resourceGeneric});
-    oldTex.reset();
-    if (self->impl->window)
-        self->impl->window->scheduleReposition(self->impl->self);
-
-    waitingForTex = false;
-    newTex        = true;
     resource.reset();
 
-    recheckTextBoxes();
+    // size and scale go with the texture, the old one is drawn at its own until then
+    auto onUploaded = [this, self = self, generation = texGeneration, pixelSize = resourceGeneric->m_asset.pixelSize, scale = pendingTexScale](SP<IRendererTexture> uploaded) {
+        if (!self || generation != texGeneration)
+            return;
+
+        size     = pixelSize;
+        texScale = scale;
+        tex      = uploaded;
+        oldTex.reset();
+        if (self->impl->window)
+            self->impl->window->scheduleReposition(self->impl->self);
 
-    if (data.callback)
-        data.callback();
+        waitingForTex = false;
+        newTex        = true;
+
+        recheckTextBoxes();
+
+        if (data.callback)
+            data.callback();
+    };
+
+    if (!data.async)
+        onUploaded(g_renderer->uploadTexture({.resource = resourceGeneric}));
+    else
+        g_renderer->uploadTextureAsync({.resource = resourceGeneric}, std::move(onUploaded));
 }
 
 static std::string formatColor(uint32_t col) {
@@ -33,43 +33,59 @@ namespace Hyprtoolkit {
     };
 
     struct STextImpl {
-        STextData                                                                                      data;
-
-        std::string                                                                                    parsedText;
-        std::vector<STextLink>                                                                         parsedLinks;
-        STextLink*                                                                                     hoveredTextLink = nullptr;
-
-        WP<CTextElement>                                                                               self;
-
-        size_t                                                                                         lastFontSizeUnscaled = 0;
-        float                                                                                          lastScale            = 1.F;
-        bool                                                                                           needsTexRefresh = false, newTex = false;
-
-        Hyprutils::Math::Vector2D                                                                      lastMaxSize;
-
-        SP<IRendererTexture>                                                                           tex;
-        SP<IRendererTexture>                                                                           oldTex; // while loading a new one
-        ASP<Hyprgraphics::CTextResource>                                                               resource;
-        Hyprutils::Math::Vector2D                                                                      size, preferred;
-
-        Hyprutils::Math::Vector2D                                                                      lastCursorPos;
-
-        bool                                                                                           waitingForTex = false;
-
-        Hyprutils::Math::Vector2D                                                                      getTextSizePreferred();
-        Hyprutils::Math::CBox                                                                          getCharBox(size_t offset);
-        std::optional<size_t>                                                                          vecToOffset(const Hyprutils::Math::Vector2D& vec);
-        float                                                                                          getCursorPos(size_t offset);
-        float                                                                                          getCursorPos(const Hyprutils::Math::Vector2D& click);
-        Hyprutils::Math::Vector2D                                                                      unscale(const Hyprutils::Math::Vector2D& x);
-        std::tuple<UP<Hyprgraphics::CCairoSurface>, cairo_t*, PangoLayout*, Hyprutils::Math::Vector2D> prepPangoLayout();
-        void                                                                                           scheduleTexRefresh();
-        void                                                                                           renderTex();
-        void                                                                                           postTexLoad();
-        void                                                                                           parseText();
-        void                                                                                           recheckTextBoxes();
-        void                                                                                           onMouseDown();
-        void                                                                                           onMouseMove();
+        STextData                                           data;
+
+        std::string                                         parsedText;
+        std::vector<STextLink>                              parsedLinks;
+        STextLink*                                          hoveredTextLink = nullptr;
+
+        WP<CTextElement>                                    self;
+
+        size_t                                              lastFontSizeUnscaled = 0;
+        float                                               lastScale            = 1.F;
+        bool                                                needsTexRefresh = false, newTex = false;
+        float                                               texScale = 1.F, pendingTexScale = 1.F; // what tex and resource were rendered at
+
+        Hyprutils::Math::Vector2D                           lastMaxSize;
+
+        SP<IRendererTexture>                                tex;
+        SP<IRendererTexture>                                oldTex; // while loading a new one
+        ASP<Hyprgraphics::CTextResource>                    resource;
+        Hyprutils::Math::Vector2D                           size, preferred;
+
+        // what it measures with: the size with nothing to fit, and the last height for width
+        Hyprutils::Math::Vector2D natural;
+        float                     naturalScale = 0.F;
+        struct {
+            double                    width = -1;
+            Hyprutils::Math::Vector2D size;
+        } fitted;
+
+        Hyprutils::Math::Vector2D                           lastCursorPos;
+
+        bool                                                waitingForTex = false;
+        size_t                                              texGeneration = 0; // bumped by renderTex, an upload for an older one is dropped
+
+        Hyprutils::Math::Vector2D                           getTextSizePreferred();
+        Hyprutils::Math::Vector2D                           getTextSizeFor(const Hyprutils::Math::Vector2D& maxSize);
+        void                                                updatePreferred(); // preferred from getTextSizePreferred, and natural if the scale changed
+        void                                                updateNatural();   // after the text or font changed, invalidates measures
+        bool                                                wraps();
+        Hyprutils::Math::Vector2D                           sizeForWidth(double width);
+        Hyprutils::Math::CBox                               getCharBox(size_t offset);
+        std::optional<size_t>                               vecToOffset(const Hyprutils::Math::Vector2D& vec);
+        float                                               getCursorPos(size_t offset);
+        float                                               getCursorPos(const Hyprutils::Math::Vector2D& click);
+        Hyprutils::Math::Vector2D                           unscale(const Hyprutils::Math::Vector2D& x);
+        std::tuple<PangoLayout*, Hyprutils::Math::Vector2D> prepPangoLayout();
+        std::tuple<PangoLayout*, Hyprutils::Math::Vector2D> prepPangoLayout(const Hyprutils::Math::Vector2D& maxSizeUnscaled);
+        void                                                scheduleTexRefresh();
+        void                                                renderTex();
+        void                                                postTexLoad();
+        void                                                parseText();
+        void                                                recheckTextBoxes();
+        void                                                onMouseDown();
+        void                                                onMouseMove();
 
         friend class CTextboxElement;
         friend struct STextboxImpl;
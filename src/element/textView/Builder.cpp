@@ -0,0 +1,60 @@
+#include "TextView.hpp"
+
+using namespace Hyprtoolkit;
+
+SP<CTextViewBuilder> CTextViewBuilder::begin() {
+    SP<CTextViewBuilder> p = SP<CTextViewBuilder>(new CTextViewBuilder());
+    p->m_data              = makeUnique<STextViewData>();
+    p->m_self              = p;
+    return p;
+}
+
+SP<CTextViewBuilder> CTextViewBuilder::path(std::string&& x) {
+    m_data->path = std::move(x);
+    return m_self.lock();
+}
+
+SP<CTextViewBuilder> CTextViewBuilder::text(std::string&& x) {
+    m_data->text = std::move(x);
+    return m_self.lock();
+}
+
+SP<CTextViewBuilder> CTextViewBuilder::color(colorFn&& f) {
+    m_data->color = std::move(f);
+    return m_self.lock();
+}
+
+SP<CTextViewBuilder> CTextViewBuilder::fontSize(CFontSize&& x) {
+    //NOLINTNEXTLINE
+    m_data->fontSize = std::move(x);
+    return m_self.lock();
+}
+
+SP<CTextViewBuilder> CTextViewBuilder::fontFamily(std::string&& x) {
+    m_data->fontFamily = std::move(x);
+    return m_self.lock();
+}
+
+SP<CTextViewBuilder> CTextViewBuilder::overscan(size_t x) {
+    m_data->overscan = x;
+    return m_self.lock();
+}
+
+SP<CTextViewBuilder> CTextViewBuilder::cacheSize(size_t x) {
+    m_data->cacheSize = x;
+    return m_self.lock();
+}
+
+SP<CTextViewBuilder> CTextViewBuilder::size(CDynamicSize&& s) {
+    m_data->size = std::move(s);
+    return m_self.lock();
+}
+
+SP<CTextViewElement> CTextViewBuilder::commence() {
+    if (m_element) {
+        m_element->replaceData(*m_data);
+        return m_element.lock();
+    }
+
+    return CTextViewElement::create(*m_data);
+}
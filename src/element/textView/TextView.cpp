@@ -0,0 +1,313 @@
+#include "TextView.hpp"
+
+#include <cmath>
+#include <hyprgraphics/color/Color.hpp>
+#include <pango/pangocairo.h>
+
+#include "../../layout/Positioner.hpp"
+#include "../../renderer/Renderer.hpp"
+#include "../../window/ToolkitWindow.hpp"
+#include "../../core/Logger.hpp"
+#include "../../system/Fonts.hpp"
+
+#include "../Element.hpp"
+
+using namespace Hyprtoolkit;
+using namespace Hyprgraphics;
+
+// longer lines are cut before they're shaped, this only bounds the shaping work
+constexpr size_t MAX_LINE_BYTES = 2048;
+
+// a line's texture is ellipsized at this many pixels wide, so that wide glyphs at a high scale
+// can't go over GL limits (16k on most gpus)
+constexpr double MAX_LINE_PIXELS = 8192;
+
+SP<CTextViewElement> CTextViewElement::create(const STextViewData& data) {
+    auto p          = SP<CTextViewElement>(new CTextViewElement(data));
+    p->impl->self   = p;
+    p->m_impl->self = p;
+    return p;
+}
+
+CTextViewElement::CTextViewElement(const STextViewData& data) : IElement(), m_impl(makeUnique<STextViewImpl>()) {
+    m_impl->data = data;
+    m_impl->reload();
+    m_impl->measureLineHeight();
+}
+
+CTextViewElement::~CTextViewElement() = default;
+
+void CTextViewElement::replaceData(const STextViewData& data) {
+    const bool SOURCE_CHANGED = data.path != m_impl->data.path || data.text != m_impl->data.text;
+    const bool FONT_CHANGED   = data.fontFamily != m_impl->data.fontFamily || CFontSize{data.fontSize}.ptSize() != m_impl->data.fontSize.ptSize();
+
+    m_impl->data = data;
+
+    if (SOURCE_CHANGED)
+        m_impl->reload();
+
+    if (FONT_CHANGED)
+        m_impl->measureLineHeight();
+
+    m_impl->clearCache();
+
+    if (impl->window)
+        impl->window->scheduleReposition(impl->self);
+}
+
+SP<CTextViewBuilder> CTextViewElement::rebuild() {
+    auto p       = SP<CTextViewBuilder>(new CTextViewBuilder());
+    p->m_self    = p;
+    p->m_data    = makeUnique<STextViewData>(m_impl->data);
+    p->m_element = m_impl->self;
+    return p;
+}
+
+void CTextViewElement::paint() {
+    if (!m_impl->index || m_impl->index->lines() == 0 || m_impl->lineHeight <= 0)
+        return;
+
+    const float SCALE = impl->window ? impl->window->scale() : 1.F;
+    if (SCALE != m_impl->lastScale) {
+        m_impl->lastScale = SCALE;
+        m_impl->measureLineHeight();
+        m_impl->clearCache();
+
+        // rows are as tall as the lines rendered at this scale
+        if (impl->window)
+            impl->window->scheduleReposition(impl->self);
+    }
+
+    // we are usually way taller than our parent (a scroll area), only what it shows is visible
+    CBox visible = impl->position;
+    if (impl->parent)
+        visible = visible.intersection(impl->parent->impl->position);
+
+    if (visible.empty())
+        return;
+
+    const auto [FIRST, LAST] = m_impl->visibleRange(visible);
+
+    for (size_t i = FIRST; i < LAST; ++i) {
+        const auto LINE = m_impl->lineFor(i);
+
+        if (!LINE->tex)
+            continue;
+
+        const CBox LINE_BOX = {impl->position.x, impl->position.y + (i * m_impl->lineHeight), LINE->pixelSize.x / SCALE, LINE->pixelSize.y / SCALE};
+
+        if (!LINE_BOX.overlaps(visible))
+            continue;
+
+        g_renderer->renderTexture({
+            .box      = LINE_BOX,
+            .texture  = LINE->tex,
+            .a        = 1.F,
+            .rounding = 0,
+        });
+    }
+
+    m_impl->trimCache(LAST - FIRST);
+}
+
+void CTextViewElement::reposition(const Hyprutils::Math::CBox& box, const Hyprutils::Math::Vector2D& maxSize) {
+    IElement::reposition(box);
+
+    g_positioner->positionChildren(impl->self.lock());
+}
+
+void CTextViewElement::recheckColor() {
+    m_impl->clearCache();
+    impl->damageEntire();
+}
+
+Hyprutils::Math::Vector2D CTextViewElement::size() {
+    return impl->position.size();
+}
+
+size_t CTextViewElement::lines() {
+    return m_impl->index ? m_impl->index->lines() : 0;
+}
+
+std::optional<Vector2D> CTextViewElement::preferredSize(const Hyprutils::Math::Vector2D& parent) {
+    auto s = m_impl->data.size.calculate(parent);
+
+    if (s.x == -1)
+        s.x = m_impl->maxLineWidth;
+    if (s.y == -1)
+        s.y = lines() * m_impl->lineHeight;
+
+    return s;
+}
+
+std::optional<Vector2D> CTextViewElement::minimumSize(const Hyprutils::Math::Vector2D& parent) {
+    return Vector2D{0, 0};
+}
+
+std::optional<Vector2D> CTextViewElement::maximumSize(const Hyprutils::Math::Vector2D& parent) {
+    return std::nullopt;
+}
+
+bool CTextViewElement::positioningDependsOnChild() {
+    return false;
+}
+
+void STextViewImpl::reload() {
+    clearCache();
+    maxLineWidth = 0.F;
+
+    if (!data.path.empty()) {
+        index = CLineIndex::fromFile(data.path);
+        if (!index)
+            g_logger->log(HT_LOG_ERROR, "CTextViewElement: failed to open {}", data.path);
+    } else
+        index = CLineIndex::fromString(std::string{data.text});
+
+    if (index)
+        g_logger->log(HT_LOG_DEBUG, "CTextViewElement: indexed {} lines, {} bytes", index->lines(), index->bytes());
+}
+
+void STextViewImpl::measureLineHeight() {
+    // all lines are assumed to be one line of the same font, so we can index them by y without shaping.
+    // Measured at the size they're rendered at, rounding included, so that rows match the lines' textures
+    PangoLayout* layout = g_fontManager->createLayout();
+
+    pango_layout_set_font_description(layout, g_fontManager->fontDescription(data.fontFamily, sc<int>(std::round(data.fontSize.ptSize() * lastScale)) * PANGO_SCALE));
+    pango_layout_set_text(layout, "Ay", -1);
+
+    PangoRectangle ink, logical;
+    pango_layout_get_pixel_extents(layout, &ink, &logical);
+
+    lineHeight = logical.height / lastScale;
+
+    g_object_unref(layout);
+}
+
+std::pair<size_t, size_t> STextViewImpl::visibleRange(const CBox& visible) {
+    const auto   POS   = self->impl->position;
+    const double TOP   = visible.y - POS.y;
+    const double BOT   = TOP + visible.h;
+    const size_t LINES = index->lines();
+
+    const auto   FIRST = sc<size_t>(std::max(0.0, std::floor(TOP / lineHeight)));
+    const auto   LAST  = sc<size_t>(std::max(0.0, std::ceil(BOT / lineHeight)));
+
+    return {
+        FIRST > data.overscan ? FIRST - data.overscan : 0,
+        std::min(LAST + data.overscan, LINES),
+    };
+}
+
+SP<STextViewLine> STextViewImpl::lineFor(size_t idx) {
+    if (const auto IT = lines.find(idx); IT != lines.end()) {
+        lru.splice(lru.begin(), lru, IT->second);
+        return *IT->second;
+    }
+
+    auto line = makeShared<STextViewLine>();
+    line->idx = idx;
+
+    lru.emplace_front(line);
+    lines[idx] = lru.begin();
+
+    renderLine(line);
+
+    return line;
+}
+
+void STextViewImpl::renderLine(SP<STextViewLine> line) {
+    auto text = index->line(line->idx);
+
+    if (text.size() > MAX_LINE_BYTES) {
+        size_t len = MAX_LINE_BYTES;
+        // don't cut through a codepoint
+        while (len > 0 && (text[len] & 0xC0) == 0x80) {
+            len--;
+        }
+        text = text.substr(0, len);
+    }
+
+    if (text.empty())
+        return;
+
+    // the resource parses markup, and this is plain text
+    char*       escaped = g_markup_escape_text(text.data(), text.size());
+    std::string escapedText{escaped};
+    g_free(escaped);
+
+    auto col = data.color();
+
+    line->resource = makeAtomicShared<CTextResource>(CTextResource::STextResourceData{
+        .text      = std::move(escapedText),
+        .font      = data.fontFamily,
+        .fontSize  = sc<size_t>(std::round(data.fontSize.ptSize() * lastScale)),
+        .color     = CColor{CColor::SSRGB{.r = col.r, .g = col.g, .b = col.b}},
+        .align     = Hyprgraphics::CTextResource::TEXT_ALIGN_LEFT,
+        .maxSize   = Vector2D{MAX_LINE_PIXELS, std::ceil(lineHeight * lastScale)},
+        .ellipsize = true,
+    });
+
+    ASP<IAsyncResource> resourceGeneric(line->resource);
+
+    g_asyncResourceGatherer->enqueue(resourceGeneric);
+
+    // the line can be evicted before it's done, in which case we just drop the result
+    line->resource->m_events.finished.listenStatic([this, self = self->impl->self, weak = WP<STextViewLine>{line}] {
+        if (!self)
+            return;
+
+        g_backend->addIdle([this, self, weak] {
+            if (!self || !weak)
+                return;
+
+            onLineReady(weak.lock());
+        });
+    });
+}
+
+void STextViewImpl::onLineReady(SP<STextViewLine> line) {
+    if (!line->resource)
+        return;
+
+    ASP<IAsyncResource> resourceGeneric(line->resource);
+    line->resource.reset();
+
+    g_renderer->uploadTextureAsync({.resource = resourceGeneric}, [this, self = self, weak = WP<STextViewLine>{line}, pixelSize = resourceGeneric->m_asset.pixelSize](SP<IRendererTexture> tex) {
+        if (!self || !weak)
+            return;
+
+        onLineUploaded(weak.lock(), tex, pixelSize);
+    });
+}
+
+void STextViewImpl::onLineUploaded(SP<STextViewLine> line, SP<IRendererTexture> tex, const Vector2D& pixelSize) {
+    line->pixelSize = pixelSize;
+    line->tex       = tex;
+
+    if (!self->impl->window)
+        return;
+
+    const auto POS = self->impl->position;
+    self->impl->damage(CBox{POS.x, POS.y + (line->idx * lineHeight), POS.w, lineHeight});
+
+    // auto width follows the widest line seen so far
+    const float WIDTH = line->pixelSize.x / lastScale;
+    if (data.size.calculate({}).x == -1 && WIDTH > maxLineWidth) {
+        maxLineWidth = WIDTH;
+        self->impl->window->scheduleReposition(self->impl->self);
+    }
+}
+
+void STextViewImpl::trimCache(size_t minimum) {
+    const size_t MAX = std::max(data.cacheSize, minimum);
+
+    while (lru.size() > MAX) {
+        lines.erase(lru.back()->idx);
+        lru.pop_back();
+    }
+}
+
+void STextViewImpl::clearCache() {
+    lines.clear();
+    lru.clear();
+}
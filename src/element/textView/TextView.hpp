@@ -0,0 +1,60 @@
+#pragma once
+
+#include <hyprtoolkit/element/TextView.hpp>
+#include <hyprgraphics/resource/resources/TextResource.hpp>
+
+#include <list>
+#include <unordered_map>
+
+#include "../../helpers/Memory.hpp"
+#include "../../helpers/LineIndex.hpp"
+#include "../../core/InternalBackend.hpp"
+
+namespace Hyprtoolkit {
+    class IRendererTexture;
+
+    struct STextViewData {
+        std::string  path;
+        std::string  text;
+        std::string  fontFamily = g_palette ? g_palette->m_vars.fontFamily : "Sans Serif";
+        CFontSize    fontSize{CFontSize::HT_FONT_TEXT};
+        colorFn      color     = [] { return g_backend->getPalette()->m_colors.text; };
+        size_t       overscan  = 16;
+        size_t       cacheSize = 512;
+        CDynamicSize size{CDynamicSize::HT_SIZE_PERCENT, CDynamicSize::HT_SIZE_AUTO, {1, 1}};
+    };
+
+    // a shaped and rasterized line
+    struct STextViewLine {
+        size_t                           idx = 0;
+        SP<IRendererTexture>             tex;
+        ASP<Hyprgraphics::CTextResource> resource;
+        Hyprutils::Math::Vector2D        pixelSize;
+    };
+
+    struct STextViewImpl {
+        STextViewData        data;
+
+        WP<CTextViewElement> self;
+
+        UP<CLineIndex>       index;
+
+        float                lineHeight   = 0.F;
+        float                maxLineWidth = 0.F;
+        float                lastScale    = 1.F;
+
+        // LRU of rendered lines, most recently used in front
+        std::list<SP<STextViewLine>>                                       lru;
+        std::unordered_map<size_t, std::list<SP<STextViewLine>>::iterator> lines;
+
+        void                                                               reload();
+        void                                                               measureLineHeight();
+        std::pair<size_t, size_t>                                          visibleRange(const Hyprutils::Math::CBox& visible);
+        SP<STextViewLine>                                                  lineFor(size_t idx);
+        void                                                               renderLine(SP<STextViewLine> line);
+        void                                                               onLineReady(SP<STextViewLine> line);
+        void                                                               onLineUploaded(SP<STextViewLine> line, SP<IRendererTexture> tex, const Hyprutils::Math::Vector2D& pixelSize);
+        void                                                               trimCache(size_t minimum);
+        void                                                               clearCache();
+    };
+}
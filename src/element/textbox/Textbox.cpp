@@ -3,6 +3,7 @@
 #include <hyprtoolkit/element/Rectangle.hpp>
 #include <hyprtoolkit/element/Null.hpp>
 #include <tuple>
+#include <algorithm>
 #include <xkbcommon/xkbcommon-keysyms.h>
 #include <pango/pangocairo.h>
 
@@ -29,17 +30,17 @@ CTextboxElement::CTextboxElement(const STextboxData& data) : IElement(), m_impl(
 }
 
 void CTextboxElement::init() {
-    m_impl->text = CTextBuilder::begin()
-                       ->text(std::string{m_impl->data.text})
-                       ->color([] { return g_palette->m_colors.text; })
-                       ->callback([this] { impl->window->scheduleReposition(impl->self); })
-                       ->size({CDynamicSize::HT_SIZE_PERCENT, CDynamicSize::HT_SIZE_PERCENT, {1.F, 1.F}})
-                       ->commence();
+    m_impl->buffer.assign(m_impl->data.text);
+
+    m_impl->linesCont = CNullBuilder::begin()->size({CDynamicSize::HT_SIZE_PERCENT, CDynamicSize::HT_SIZE_ABSOLUTE, {1.F, 0.F}})->commence();
 
     m_impl->placeholder = CTextBuilder::begin()
                               ->text(std::string{m_impl->data.placeholder})
                               ->color([] { return g_palette->m_colors.text.darken(0.4F); })
-                              ->callback([this] { impl->window->scheduleReposition(impl->self); })
+                              ->callback([this] {
+                                  if (impl->window)
+                                      impl->window->scheduleReposition(impl->self);
+                              })
                               ->size({CDynamicSize::HT_SIZE_PERCENT, CDynamicSize::HT_SIZE_PERCENT, {1.F, 1.F}})
                               ->commence();
 
@@ -54,24 +55,26 @@ void CTextboxElement::init() {
     m_impl->bgInnerCont = CNullBuilder::begin()->size({CDynamicSize::HT_SIZE_PERCENT, CDynamicSize::HT_SIZE_PERCENT, {1.F, 1.F}})->commence();
     m_impl->bgInnerCont->setMargin(3);
 
-    m_impl->selectBgCont = CNullBuilder::begin()->size({CDynamicSize::HT_SIZE_PERCENT, CDynamicSize::HT_SIZE_PERCENT, {1.F, 0.7F}})->commence();
-    m_impl->selectBg     = CRectangleBuilder::begin()
-                           ->color([] {
-                               auto x = g_palette->m_colors.accent.darken(0.4F);
-                               x.a    = 0.5F;
-                               return x;
-                           })
-                           ->commence();
+    // the cursor and selection containers mirror linesCont, so that paragraph offsets apply to them as-is
+    m_impl->selectBgCont = CNullBuilder::begin()->size({CDynamicSize::HT_SIZE_PERCENT, CDynamicSize::HT_SIZE_ABSOLUTE, {1.F, 0.F}})->commence();
+
+    for (auto& sel : m_impl->selectBg) {
+        sel = CRectangleBuilder::begin()
+                  ->color([] {
+                      auto x = g_palette->m_colors.accent.darken(0.4F);
+                      x.a    = 0.5F;
+                      return x;
+                  })
+                  ->commence();
+        sel->setPositionMode(HT_POSITION_ABSOLUTE);
+    }
 
     m_impl->selectBgCont->setPositionMode(HT_POSITION_ABSOLUTE);
     m_impl->selectBgCont->setPositionFlag(HT_POSITION_FLAG_VCENTER, true);
-    m_impl->selectBg->setPositionMode(HT_POSITION_ABSOLUTE);
-
-    m_impl->selectBgCont->addChild(m_impl->selectBg);
 
-    m_impl->cursorCont = CNullBuilder::begin()->size({CDynamicSize::HT_SIZE_PERCENT, CDynamicSize::HT_SIZE_PERCENT, {1.F, 0.8F}})->commence();
+    m_impl->cursorCont = CNullBuilder::begin()->size({CDynamicSize::HT_SIZE_PERCENT, CDynamicSize::HT_SIZE_ABSOLUTE, {1.F, 0.F}})->commence();
     m_impl->cursor =
-        CRectangleBuilder::begin()->color([] { return g_palette->m_colors.text; })->size({CDynamicSize::HT_SIZE_ABSOLUTE, CDynamicSize::HT_SIZE_PERCENT, {1.F, 1.F}})->commence();
+        CRectangleBuilder::begin()->color([] { return g_palette->m_colors.text; })->size({CDynamicSize::HT_SIZE_ABSOLUTE, CDynamicSize::HT_SIZE_ABSOLUTE, {1.F, 0.F}})->commence();
 
     m_impl->cursorCont->setPositionMode(HT_POSITION_ABSOLUTE);
     m_impl->cursorCont->setPositionFlag(HT_POSITION_FLAG_VCENTER, true);
@@ -79,8 +82,8 @@ void CTextboxElement::init() {
 
     m_impl->placeholder->setPositionMode(HT_POSITION_ABSOLUTE);
     m_impl->placeholder->setPositionFlag(HT_POSITION_FLAG_VCENTER, true);
-    m_impl->text->setPositionMode(HT_POSITION_ABSOLUTE);
-    m_impl->text->setPositionFlag(HT_POSITION_FLAG_VCENTER, true);
+    m_impl->linesCont->setPositionMode(HT_POSITION_ABSOLUTE);
+    m_impl->linesCont->setPositionFlag(HT_POSITION_FLAG_VCENTER, true);
 
     m_impl->listeners.mouseMove = impl->m_externalEvents.mouseMove.listen([this](Vector2D pos) { m_impl->lastCursorPos = pos; });
 
@@ -91,7 +94,8 @@ void CTextboxElement::init() {
 
     m_impl->listeners.enter = impl->m_externalEvents.keyboardEnter.listen([this] {
         m_impl->bgInnerCont->addChild(m_impl->cursorCont);
-        impl->window->setIMTo(impl->position, m_impl->data.text, m_impl->inputState.cursor);
+        const auto [IDX, COL] = m_impl->buffer.locate(m_impl->inputState.cursor);
+        impl->window->setIMTo(impl->position, m_impl->buffer.paragraph(IDX), COL);
         m_impl->bg->rebuild()->borderColor([] { return g_palette->m_colors.alternateBase.brighten(0.5F); })->commence();
         m_impl->focusCursorAtClickedChar();
     });
@@ -127,7 +131,7 @@ void CTextboxElement::init() {
         }
 
         if (ev.xkbKeysym == XKB_KEY_Delete) {
-            if (m_impl->inputState.cursor == m_impl->data.text.length())
+            if (m_impl->inputState.cursor == m_impl->buffer.length())
                 return;
 
             if (m_impl->hasSelect()) {
@@ -184,7 +188,7 @@ void CTextboxElement::init() {
         }
 
         if (ev.xkbKeysym == XKB_KEY_Right) {
-            if (m_impl->inputState.cursor == m_impl->data.text.length())
+            if (m_impl->inputState.cursor == m_impl->buffer.length())
                 return;
 
             const auto oldCursorPos = m_impl->inputState.cursor;
@@ -226,7 +230,7 @@ void CTextboxElement::init() {
         }
 
         if (ev.xkbKeysym == XKB_KEY_End || ev.xkbKeysym == XKB_KEY_KP_End) {
-            m_impl->inputState.cursor = m_impl->data.text.length();
+            m_impl->inputState.cursor = m_impl->buffer.length();
             m_impl->updateCursor();
             m_impl->clearSelect();
             return;
@@ -243,7 +247,7 @@ void CTextboxElement::init() {
 
         if ((ev.xkbKeysym == XKB_KEY_A || ev.xkbKeysym == XKB_KEY_a) && ev.modMask & Input::HT_MODIFIER_CTRL) {
             m_impl->inputState.selectBegin = 0;
-            m_impl->inputState.selectEnd   = m_impl->data.text.length();
+            m_impl->inputState.selectEnd   = m_impl->buffer.length();
             m_impl->inputState.cursor      = m_impl->inputState.selectEnd;
             m_impl->updateSelect();
             m_impl->updateCursor();
@@ -258,13 +262,12 @@ void CTextboxElement::init() {
 
         m_impl->removeSelectedText();
 
-        m_impl->data.text = m_impl->data.text.insert(m_impl->inputState.cursor, ev.utf8);
+        m_impl->buffer.insert(m_impl->inputState.cursor, ev.utf8);
         m_impl->inputState.cursor += ev.utf8.length();
         m_impl->updateLabel();
     });
 
     m_impl->placeholder->setMargin(1);
-    m_impl->text->setMargin(1);
 
     addChild(m_impl->bg);
 
@@ -279,7 +282,7 @@ void CTextboxElement::init() {
 }
 
 std::string_view CTextboxElement::currentText() {
-    return m_impl->data.text;
+    return m_impl->buffer.str();
 }
 
 size_t CTextboxElement::cursorPos() const {
@@ -290,65 +293,179 @@ std::tuple<ssize_t, ssize_t> CTextboxElement::selection() const {
     return {m_impl->inputState.selectBegin, m_impl->inputState.selectEnd};
 }
 
-void STextboxImpl::updateLabel() {
-    if (data.text.empty()) {
-        bgInnerCont->removeChild(text);
-        bgInnerCont->addChild(placeholder);
-    } else {
-        bgInnerCont->removeChild(placeholder);
-        bgInnerCont->addChild(text);
+// the paragraph under the cursor is rendered synchronously if it's short enough, so that typing
+// shows up in the next frame instead of waiting for the resource gatherer.
+constexpr size_t SYNC_PARAGRAPH_MAX_LEN = 1024;
+
+bool STextboxImpl::syncParagraph(size_t idx) {
+    return idx == buffer.locate(inputState.cursor).first && buffer.paragraph(idx).size() < SYNC_PARAGRAPH_MAX_LEN;
+}
+
+std::string STextboxImpl::paragraphLabel(size_t idx) {
+    std::string label = data.password ? std::string(paragraphs[idx].index.length(), '*') : buffer.paragraph(idx);
+
+    if (!inputState.imText.empty() && idx == preeditParagraph)
+        label.insert(std::min(labelOffset(idx, buffer.locate(inputState.cursor).second), label.size()), "<u>" + inputState.imText + "</u>");
+
+    // empty text has nothing to render, a space keeps the line height
+    if (label.empty())
+        label = " ";
+
+    return label;
+}
+
+SP<CTextElement> STextboxImpl::makeParagraph(size_t idx) {
+    auto text = CTextBuilder::begin()
+                    ->text(paragraphLabel(idx))
+                    ->color([] { return g_palette->m_colors.text; })
+                    ->callback([this] {
+                        // wrapping may have changed the height
+                        updateParagraphPositions();
+
+                        if (self->impl->window)
+                            self->impl->window->scheduleReposition(self->impl->self);
+                    })
+                    ->async(!syncParagraph(idx))
+                    ->commence();
+
+    text->setPositionMode(IElement::HT_POSITION_ABSOLUTE);
+
+    return text;
+}
+
+void STextboxImpl::updateParagraphPositions() {
+    float y       = 0.F;
+    bool  changed = false;
+
+    for (auto& p : paragraphs) {
+        if (p.y != y) {
+            p.y = y;
+            // set directly instead of setAbsolutePosition, one reposition of the container is enough
+            p.text->impl->absoluteOffset = {0.F, y};
+            changed                      = true;
+        }
+
+        y += p.text->m_impl->preferred.y;
     }
 
-    if (!data.password) {
+    if (y != linesHeight) {
+        linesHeight = y;
+
+        for (const auto& cont : {linesCont, cursorCont, selectBgCont}) {
+            cont->rebuild()->size({CDynamicSize::HT_SIZE_PERCENT, CDynamicSize::HT_SIZE_ABSOLUTE, {1.F, y}})->commence();
+        }
 
-        auto fullLabel = inputState.imText.empty() ? //
-            data.text :                              //
-            data.text.insert(inputState.cursor, "<u>" + inputState.imText + "</u>");
+        return;
+    }
 
-        text->rebuild()->text(std::move(fullLabel))->commence();
-    } else {
-        std::string pwdText = "";
-        for (size_t i = 0; i < data.text.size(); ++i) {
-            pwdText += '*';
+    if (changed && self->impl->window)
+        self->impl->window->scheduleReposition(linesCont);
+}
+
+size_t STextboxImpl::paragraphAt(float y) const {
+    const auto IT = std::ranges::upper_bound(paragraphs, y, {}, &STextboxParagraph::y);
+    if (IT == paragraphs.begin())
+        return 0;
+    return std::distance(paragraphs.begin(), IT) - 1;
+}
+
+float STextboxImpl::cursorX(size_t idx, size_t col) {
+    if (buffer.paragraph(idx).empty())
+        return 0.F;
+
+    return paragraphs[idx].text->m_impl->getCursorPos(labelOffset(idx, col));
+}
+
+size_t STextboxImpl::labelOffset(size_t idx, size_t col) {
+    if (!data.password)
+        return col;
+
+    return paragraphs[idx].index.offsetToUTF8Len(buffer.paragraph(idx), col);
+}
+
+size_t STextboxImpl::bufferOffset(size_t idx, size_t labelOffset) {
+    if (!data.password)
+        return labelOffset;
+
+    return paragraphs[idx].index.utf8ToOffset(buffer.paragraph(idx), labelOffset);
+}
+
+void STextboxImpl::updateLabel() {
+    // only touch the paragraphs that changed, everything else keeps its layout and texture
+    if (const auto DAMAGE = buffer.takeDamage(); DAMAGE) {
+        const size_t REUSED = std::min(DAMAGE->removed, DAMAGE->added);
+
+        for (size_t i = DAMAGE->first + REUSED; i < DAMAGE->first + DAMAGE->removed; ++i) {
+            linesCont->removeChild(paragraphs[i].text);
         }
 
-        auto fullLabel = inputState.imText.empty() ? //
-            pwdText :                                //
-            pwdText.insert(inputState.cursor, "<u>" + inputState.imText + "</u>");
+        paragraphs.erase(paragraphs.begin() + DAMAGE->first + REUSED, paragraphs.begin() + DAMAGE->first + DAMAGE->removed);
 
-        text->rebuild()->text(std::move(fullLabel))->commence();
+        for (size_t i = DAMAGE->first; i < DAMAGE->first + DAMAGE->added; ++i) {
+            if (i < DAMAGE->first + REUSED) {
+                paragraphs[i].index.rebuild(buffer.paragraph(i));
+                paragraphs[i].text->rebuild()->text(paragraphLabel(i))->async(!syncParagraph(i))->commence();
+                continue;
+            }
+
+            paragraphs.insert(paragraphs.begin() + i, STextboxParagraph{.y = -1.F, .index = UTF8::CCodepointIndex{buffer.paragraph(i)}});
+            paragraphs[i].text = makeParagraph(i);
+            linesCont->addChild(paragraphs[i].text);
+        }
+
+        updateParagraphPositions();
+    }
+
+    if (buffer.empty() && inputState.imText.empty()) {
+        bgInnerCont->removeChild(linesCont);
+        bgInnerCont->addChild(placeholder);
+    } else {
+        bgInnerCont->removeChild(placeholder);
+        bgInnerCont->addChild(linesCont);
     }
 
     updateCursor();
 
     if (data.onTextEdited)
-        data.onTextEdited(self.lock(), data.text);
+        data.onTextEdited(self.lock(), buffer.str());
 }
 
 void CTextboxElement::imCommitNewText(const std::string& s) {
     m_impl->inputState.imText = s;
+
+    // preedit is drawn inside of the paragraph with the cursor
+    m_impl->buffer.markDirty(m_impl->preeditParagraph);
+    m_impl->preeditParagraph = m_impl->buffer.locate(m_impl->inputState.cursor).first;
+    m_impl->buffer.markDirty(m_impl->preeditParagraph);
+
     m_impl->updateLabel();
 }
 
 void CTextboxElement::imApplyText() {
-    m_impl->data.text = m_impl->data.text.insert(m_impl->inputState.cursor, m_impl->inputState.imText);
+    m_impl->buffer.markDirty(m_impl->preeditParagraph);
+    m_impl->buffer.insert(m_impl->inputState.cursor, m_impl->inputState.imText);
     m_impl->inputState.cursor += m_impl->inputState.imText.length();
     m_impl->inputState.imText.clear();
     m_impl->updateLabel();
 }
 
 void STextboxImpl::updateCursor() {
-    inputState.cursor = std::clamp(inputState.cursor, (size_t)0, data.text.length());
+    inputState.cursor = std::clamp(inputState.cursor, (size_t)0, buffer.length());
 
-    const float WIDTH = text->m_impl->getCursorPos(inputState.cursor);
+    const auto [IDX, COL] = buffer.locate(inputState.cursor);
+    const auto& PARAGRAPH = paragraphs[IDX];
+    const float X         = cursorX(IDX, COL);
 
+    cursor->rebuild()->size({CDynamicSize::HT_SIZE_ABSOLUTE, CDynamicSize::HT_SIZE_ABSOLUTE, {1.F, PARAGRAPH.text->m_impl->preferred.y}})->commence();
     cursor->setAbsolutePosition({
-        WIDTH,
-        0.F,
+        X,
+        PARAGRAPH.y,
     });
 
+    // the surrounding text is the paragraph, the IM doesn't need all of it
     if (self->impl->window)
-        self->impl->window->setIMTo(self->impl->position.copy().translate({std::clamp(WIDTH, 0.F, sc<float>(self->impl->position.w)), 0.F}), data.text, inputState.cursor);
+        self->impl->window->setIMTo(self->impl->position.copy().translate({std::clamp(X, 0.F, sc<float>(self->impl->position.w)), PARAGRAPH.y}), buffer.paragraph(IDX),
+                                    COL);
 
     g_positioner->repositionNeeded(cursor);
 }
@@ -376,13 +493,33 @@ void STextboxImpl::updateSelect() {
         return;
     }
 
-    float begin = text->m_impl->getCursorPos(inputState.selectBegin), //
-        end     = text->m_impl->getCursorPos(inputState.selectEnd);
+    const auto [FIRST, FIRST_COL] = buffer.locate(inputState.selectBegin);
+    const auto [LAST, LAST_COL]   = buffer.locate(inputState.selectEnd);
+    const float         BEGIN        = cursorX(FIRST, FIRST_COL);
+    const float         END          = cursorX(LAST, LAST_COL);
+    const float         FULL_WIDTH   = linesCont->impl->position.w;
+    const float         FIRST_HEIGHT = paragraphs[FIRST].text->m_impl->preferred.y;
+
+    std::array<CBox, 3> boxes;
+
+    if (FIRST == LAST)
+        boxes[0] = CBox{BEGIN, paragraphs[FIRST].y, END - BEGIN, FIRST_HEIGHT};
+    else {
+        boxes[0] = CBox{BEGIN, paragraphs[FIRST].y, FULL_WIDTH - BEGIN, FIRST_HEIGHT};
+        boxes[1] = CBox{0.F, paragraphs[FIRST].y + FIRST_HEIGHT, FULL_WIDTH, paragraphs[LAST].y - paragraphs[FIRST].y - FIRST_HEIGHT};
+        boxes[2] = CBox{0.F, paragraphs[LAST].y, END, paragraphs[LAST].text->m_impl->preferred.y};
+    }
 
-    float width = end - begin;
+    for (size_t i = 0; i < selectBg.size(); ++i) {
+        if (boxes[i].w <= 0 || boxes[i].h <= 0) {
+            selectBgCont->removeChild(selectBg[i]);
+            continue;
+        }
 
-    selectBg->rebuild()->size({CDynamicSize::HT_SIZE_ABSOLUTE, CDynamicSize::HT_SIZE_PERCENT, {width, 1.F}})->commence();
-    selectBg->setAbsolutePosition(Vector2D{begin, 0.F});
+        selectBg[i]->rebuild()->size({CDynamicSize::HT_SIZE_ABSOLUTE, CDynamicSize::HT_SIZE_ABSOLUTE, {boxes[i].w, boxes[i].h}})->commence();
+        selectBg[i]->setAbsolutePosition(boxes[i].pos());
+        selectBgCont->addChild(selectBg[i]);
+    }
 
     bgInnerCont->addChild(selectBgCont);
 }
@@ -393,64 +530,102 @@ bool STextboxImpl::hasSelect() const {
 
 void STextboxImpl::removeSelectedText() {
     if (hasSelect()) {
-        data.text         = data.text.substr(0, inputState.selectBegin) + data.text.substr(inputState.selectEnd);
+        buffer.erase(inputState.selectBegin, inputState.selectEnd);
         inputState.cursor = inputState.selectBegin;
         clearSelect();
     }
 }
 
 void STextboxImpl::focusCursorAtClickedChar() {
-    inputState.cursor = text->m_impl->vecToOffset(lastCursorPos - (text->impl->position.pos() - self->impl->position.pos())).value_or(data.text.size());
+    const size_t IDX  = paragraphAt(lastCursorPos.y - (linesCont->impl->position.y - self->impl->position.y));
+    const auto&  TEXT = paragraphs[IDX].text;
+    const size_t LEN  = buffer.paragraph(IDX).size();
+    const auto   AT   = TEXT->m_impl->vecToOffset(lastCursorPos - (TEXT->impl->position.pos() - self->impl->position.pos()));
+
+    inputState.cursor = buffer.paragraphStart(IDX) + std::min(AT ? bufferOffset(IDX, *AT) : LEN, LEN);
     updateCursor();
     clearSelect();
 }
 
-size_t STextboxImpl::moveLineBackwards() const {
+size_t STextboxImpl::moveLineBackwards() {
     if (inputState.cursor == 0)
         return inputState.cursor;
 
-    auto newlineBeforeCursor = data.text.find_last_of('\n', inputState.cursor);
-    newlineBeforeCursor      = newlineBeforeCursor == std::string::npos ? 0 : newlineBeforeCursor + 1;
-    return newlineBeforeCursor;
+    return buffer.paragraphStart(buffer.locate(inputState.cursor).first);
 }
 
-size_t STextboxImpl::moveLineForwards() const {
-    auto newlineAfterCursor = data.text.find_first_of('\n', inputState.cursor);
-    newlineAfterCursor      = newlineAfterCursor == std::string::npos ? data.text.length() : newlineAfterCursor;
-    return newlineAfterCursor;
+size_t STextboxImpl::moveLineForwards() {
+    const auto IDX = buffer.locate(inputState.cursor).first;
+    return buffer.paragraphStart(IDX) + buffer.paragraph(IDX).size();
 }
 
-size_t STextboxImpl::moveWordBackwards() const {
+size_t STextboxImpl::moveWordBackwards() {
     if (inputState.cursor == 0)
         return inputState.cursor;
 
+    auto [idx, col] = buffer.locate(inputState.cursor);
+
+    // at the start of a paragraph, the word before is the last one of the previous paragraph
+    if (col == 0) {
+        --idx;
+        col = buffer.paragraph(idx).size();
+    }
+
+    const auto& TEXT  = buffer.paragraph(idx);
+    const auto  START = buffer.paragraphStart(idx);
+
     // ignore spaces that are right behind the cursor
-    auto searchStartPos = data.text.find_last_not_of(' ', inputState.cursor - 1);
-    searchStartPos      = searchStartPos == std::string::npos ? 0 : searchStartPos;
+    const auto searchStartPos = col == 0 ? std::string::npos : TEXT.find_last_not_of(' ', col - 1);
+    if (searchStartPos == std::string::npos)
+        return START;
 
-    auto spaceBeforeCursor = data.text.find_last_of(' ', searchStartPos);
+    auto spaceBeforeCursor = TEXT.find_last_of(' ', searchStartPos);
     spaceBeforeCursor      = spaceBeforeCursor == std::string::npos ? 0 : spaceBeforeCursor + 1;
-    return spaceBeforeCursor;
+    return START + spaceBeforeCursor;
 }
 
-size_t STextboxImpl::moveWordForwards() const {
+size_t STextboxImpl::moveWordForwards() {
+    auto [idx, col] = buffer.locate(inputState.cursor);
+
+    // at the end of a paragraph, the word after is the first one of the next paragraph
+    if (col == buffer.paragraph(idx).size() && idx + 1 < buffer.paragraphs()) {
+        ++idx;
+        col = 0;
+    }
+
+    const auto& TEXT = buffer.paragraph(idx);
+
     // ignore spaces that are right in front of the cursor
-    auto searchStartPos = data.text.find_first_not_of(' ', inputState.cursor);
-    searchStartPos      = searchStartPos == std::string::npos ? data.text.length() : searchStartPos + 1;
+    auto searchStartPos = TEXT.find_first_not_of(' ', col);
+    searchStartPos      = searchStartPos == std::string::npos ? TEXT.length() : searchStartPos + 1;
 
-    auto spaceAfterCursor = data.text.find_first_of(' ', searchStartPos);
-    spaceAfterCursor      = spaceAfterCursor == std::string::npos ? data.text.length() : spaceAfterCursor;
-    return spaceAfterCursor;
+    auto spaceAfterCursor = TEXT.find_first_of(' ', searchStartPos);
+    spaceAfterCursor      = spaceAfterCursor == std::string::npos ? TEXT.length() : spaceAfterCursor;
+    return buffer.paragraphStart(idx) + spaceAfterCursor;
 }
 
-size_t STextboxImpl::moveCharBackwards() const {
+size_t STextboxImpl::moveCharBackwards() {
     if (inputState.cursor == 0)
         return inputState.cursor;
-    return inputState.cursor - UTF8::codepointLenBefore(data.text, inputState.cursor);
+
+    const auto [IDX, COL] = buffer.locate(inputState.cursor);
+
+    // the newline before the paragraph
+    if (COL == 0)
+        return inputState.cursor - 1;
+
+    return inputState.cursor - UTF8::codepointLenBefore(buffer.paragraph(IDX), COL);
 }
 
-size_t STextboxImpl::moveCharForwards() const {
-    return inputState.cursor + UTF8::codepointLen(&data.text[inputState.cursor], data.text.length() - inputState.cursor);
+size_t STextboxImpl::moveCharForwards() {
+    const auto [IDX, COL] = buffer.locate(inputState.cursor);
+    const auto& TEXT      = buffer.paragraph(IDX);
+
+    // the newline after the paragraph
+    if (COL == TEXT.length())
+        return std::min(inputState.cursor + 1, buffer.length());
+
+    return inputState.cursor + UTF8::codepointLen(&TEXT[COL], TEXT.length() - COL);
 }
 
 void CTextboxElement::reposition(const Hyprutils::Math::CBox& box, const Hyprutils::Math::Vector2D& maxSize) {
@@ -464,15 +639,27 @@ SP<CTextboxBuilder> CTextboxElement::rebuild() {
     p->m_self    = p;
     p->m_data    = makeUnique<STextboxData>(m_impl->data);
     p->m_element = m_impl->self;
+
+    // the buffer is the source of truth after edits
+    p->m_data->text = m_impl->buffer.str();
     return p;
 }
 
 void CTextboxElement::replaceData(const STextboxData& data) {
-    const bool TEXTS_DIFFER = data.text != m_impl->data.text;
+    const bool TEXTS_DIFFER     = !m_impl->buffer.matches(data.text);
+    const bool PASSWORD_DIFFERS = data.password != m_impl->data.password;
 
     m_impl->data = data;
 
     if (TEXTS_DIFFER)
+        m_impl->buffer.assign(data.text);
+    else if (PASSWORD_DIFFERS) {
+        for (size_t i = 0; i < m_impl->buffer.paragraphs(); ++i) {
+            m_impl->buffer.markDirty(i);
+        }
+    }
+
+    if (TEXTS_DIFFER || PASSWORD_DIFFERS)
         m_impl->updateLabel();
 
     if (impl->window)
@@ -4,6 +4,10 @@
 #include <hyprutils/signal/Listener.hpp>
 
 #include "../../helpers/Memory.hpp"
+#include "../../helpers/TextBuffer.hpp"
+#include "../../helpers/UTF8.hpp"
+
+#include <array>
 
 using namespace Hyprutils::Signal;
 
@@ -21,6 +25,14 @@ namespace Hyprtoolkit {
         bool                                                                                        password  = false;
         CDynamicSize                                                                                size{CDynamicSize::HT_SIZE_PERCENT, CDynamicSize::HT_SIZE_PERCENT, {1, 1}};
     };
+
+    // one laid out line of the textbox, i.e. a run of text between newlines
+    struct STextboxParagraph {
+        SP<CTextElement>      text;
+        float                 y = 0.F;
+        UTF8::CCodepointIndex index; // of the paragraph's text, a masked label has one char per codepoint
+    };
+
     struct STextboxImpl {
         STextboxData          data;
 
@@ -31,11 +43,18 @@ namespace Hyprtoolkit {
         SP<CNullElement>      cursorCont;
         SP<CRectangleElement> cursor;
         SP<CNullElement>      selectBgCont;
-        SP<CRectangleElement> selectBg;
-        SP<CTextElement>      text;
+        SP<CNullElement>      linesCont;
         SP<CTextElement>      placeholder;
 
-        bool                  active = false;
+        // first line, full middle lines and last line of a selection
+        std::array<SP<CRectangleElement>, 3> selectBg;
+
+        CTextBuffer                          buffer;
+        std::vector<STextboxParagraph>       paragraphs;
+        size_t                               preeditParagraph = 0;
+        float                                linesHeight      = 0.F;
+
+        bool                                 active = false;
 
         struct {
             CHyprSignalListener key;
@@ -56,14 +75,22 @@ namespace Hyprtoolkit {
         bool                      hasSelect() const;
         void                      removeSelectedText();
         void                      focusCursorAtClickedChar();
-        size_t                    moveLineBackwards() const;
-        size_t                    moveLineForwards() const;
-        size_t                    moveWordBackwards() const;
-        size_t                    moveWordForwards() const;
-        size_t                    moveCharBackwards() const;
-        size_t                    moveCharForwards() const;
+        size_t                    moveLineBackwards();
+        size_t                    moveLineForwards();
+        size_t                    moveWordBackwards();
+        size_t                    moveWordForwards();
+        size_t                    moveCharBackwards();
+        size_t                    moveCharForwards();
         void                      updateLabel();
         void                      updateCursor();
+        void                      updateParagraphPositions();
+        std::string               paragraphLabel(size_t idx);
+        SP<CTextElement>          makeParagraph(size_t idx);
+        size_t                    paragraphAt(float y) const;
+        float                     cursorX(size_t idx, size_t col);
+        size_t                    labelOffset(size_t idx, size_t col);
+        size_t                    bufferOffset(size_t idx, size_t labelOffset);
+        bool                      syncParagraph(size_t idx);
 
         Hyprutils::Math::Vector2D lastCursorPos;
     };
@@ -25,6 +25,15 @@ void CDamageRing::damageEntire() {
     damage(CBox{{}, m_size});
 }
 
+void CDamageRing::scroll(const CBox& box, const Vector2D& delta) {
+    // what was stale there still is, wherever it went
+    CRegion moved = m_current.copy().intersect(box);
+    moved.translate(delta);
+    moved.intersect(box);
+
+    m_current.add(moved);
+}
+
 void CDamageRing::rotate() {
     m_previousIdx = (m_previousIdx + DAMAGE_RING_PREVIOUS_LEN - 1) % DAMAGE_RING_PREVIOUS_LEN;
 
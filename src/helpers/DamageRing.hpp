@@ -11,6 +11,7 @@ namespace Hyprtoolkit {
         void                     setSize(const Hyprutils::Math::Vector2D& size_);
         bool                     damage(Hyprutils::Math::CRegion&& rg);
         void                     damageEntire();
+        void                     scroll(const Hyprutils::Math::CBox& box, const Hyprutils::Math::Vector2D& delta); // what's in box moved, its damage moves along
         void                     rotate();
         Hyprutils::Math::CRegion getBufferDamage(int age);
         bool                     hasChanged();
@@ -0,0 +1,88 @@
+#include "Hash.hpp"
+
+#include <hyprutils/memory/Casts.hpp>
+
+#include <bit>
+#include <cstring>
+
+using namespace Hyprtoolkit;
+using namespace Hyprutils::Memory;
+
+constexpr uint64_t PRIME1 = 0x9E3779B185EBCA87ULL;
+constexpr uint64_t PRIME2 = 0xC2B2AE3D27D4EB4FULL;
+constexpr uint64_t PRIME3 = 0x165667B19E3779F9ULL;
+constexpr uint64_t PRIME4 = 0x85EBCA77C2B2AE63ULL;
+constexpr uint64_t PRIME5 = 0x27D4EB2F165667C5ULL;
+
+static uint64_t read64(const uint8_t* p) {
+    uint64_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+static uint32_t read32(const uint8_t* p) {
+    uint32_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+static uint64_t xxRound(uint64_t acc, uint64_t input) {
+    acc += input * PRIME2;
+    acc = std::rotl(acc, 31);
+    return acc * PRIME1;
+}
+
+static uint64_t mergeRound(uint64_t acc, uint64_t val) {
+    acc ^= xxRound(0, val);
+    return acc * PRIME1 + PRIME4;
+}
+
+uint64_t Hash::xxh64(const void* data, size_t len, uint64_t seed) {
+    const auto* p   = sc<const uint8_t*>(data);
+    const auto* END = p + len;
+    uint64_t    h   = 0;
+
+    if (len >= 32) {
+        uint64_t v1 = seed + PRIME1 + PRIME2, v2 = seed + PRIME2, v3 = seed, v4 = seed - PRIME1;
+
+        for (const auto* LIMIT = END - 32; p <= LIMIT; p += 32) {
+            v1 = xxRound(v1, read64(p));
+            v2 = xxRound(v2, read64(p + 8));
+            v3 = xxRound(v3, read64(p + 16));
+            v4 = xxRound(v4, read64(p + 24));
+        }
+
+        h = std::rotl(v1, 1) + std::rotl(v2, 7) + std::rotl(v3, 12) + std::rotl(v4, 18);
+        h = mergeRound(h, v1);
+        h = mergeRound(h, v2);
+        h = mergeRound(h, v3);
+        h = mergeRound(h, v4);
+    } else
+        h = seed + PRIME5;
+
+    h += len;
+
+    for (; p + 8 <= END; p += 8) {
+        h ^= xxRound(0, read64(p));
+        h = std::rotl(h, 27) * PRIME1 + PRIME4;
+    }
+
+    if (p + 4 <= END) {
+        h ^= read32(p) * PRIME1;
+        h = std::rotl(h, 23) * PRIME2 + PRIME3;
+        p += 4;
+    }
+
+    for (; p < END; ++p) {
+        h ^= *p * PRIME5;
+        h = std::rotl(h, 11) * PRIME1;
+    }
+
+    h ^= h >> 33;
+    h *= PRIME2;
+    h ^= h >> 29;
+    h *= PRIME3;
+    h ^= h >> 32;
+
+    return h;
+}
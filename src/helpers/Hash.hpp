@@ -0,0 +1,9 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Hyprtoolkit::Hash {
+    // XXH64. Stable across runs and machines of the same endianness, so fine for on-disk keys.
+    uint64_t xxh64(const void* data, size_t len, uint64_t seed = 0);
+}
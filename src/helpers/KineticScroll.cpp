@@ -0,0 +1,94 @@
+#include "KineticScroll.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace Hyprtoolkit;
+using namespace Hyprutils::Math;
+
+// how far back the fingers' speed is taken from, and how long they can rest before lifting without a fling (ms)
+constexpr uint32_t VELOCITY_WINDOW = 100;
+constexpr uint32_t MAX_REST        = 50;
+
+// px/ms. Slower lifts don't fling, flings stop once this slow
+constexpr double MIN_FLING_VELOCITY = 0.1;
+constexpr double MAX_FLING_VELOCITY = 8.0;
+constexpr double STOP_VELOCITY      = 0.01;
+
+// the velocity decays as e^(-t / TIME_CONSTANT), t in ms
+constexpr double TIME_CONSTANT = 325.0;
+
+void CKineticScroll::push(const Vector2D& delta, uint32_t time, bool finger) {
+    m_velocity = {};
+    m_pending  = m_pending + delta;
+
+    if (!finger) {
+        m_samples.clear();
+        return;
+    }
+
+    // unsigned, so it holds when the time wraps
+    std::erase_if(m_samples, [time](const SSample& s) { return time - s.time > VELOCITY_WINDOW; });
+    m_samples.emplace_back(SSample{.delta = delta, .time = time});
+}
+
+void CKineticScroll::lift(uint32_t time, const clock::time_point& now) {
+    const auto SAMPLES = std::move(m_samples);
+    m_samples.clear();
+
+    if (SAMPLES.size() < 2 || time - SAMPLES.back().time > MAX_REST)
+        return;
+
+    // the first sample moved in a time before it we don't know of, it only starts the clock
+    Vector2D moved;
+    for (size_t i = 1; i < SAMPLES.size(); ++i) {
+        moved = moved + SAMPLES[i].delta;
+    }
+
+    const double SPAN = std::max<uint32_t>(SAMPLES.back().time - SAMPLES.front().time, 1);
+    auto         v    = moved / SPAN;
+
+    if (v.size() < MIN_FLING_VELOCITY)
+        return;
+
+    if (v.size() > MAX_FLING_VELOCITY)
+        v = v * (MAX_FLING_VELOCITY / v.size());
+
+    m_velocity  = v;
+    m_lastFrame = now;
+}
+
+void CKineticScroll::cancel() {
+    m_pending  = {};
+    m_velocity = {};
+    m_samples.clear();
+}
+
+Vector2D CKineticScroll::frame(const clock::time_point& now) {
+    auto delta = m_pending;
+    m_pending  = {};
+
+    if (!flinging())
+        return delta;
+
+    // how far the decaying velocity goes since the last frame, however long ago it was
+    const double DT    = std::max(0.0, std::chrono::duration<double, std::milli>(now - m_lastFrame).count());
+    const double DECAY = std::exp(-DT / TIME_CONSTANT);
+
+    delta       = delta + m_velocity * (TIME_CONSTANT * (1.0 - DECAY));
+    m_velocity  = m_velocity * DECAY;
+    m_lastFrame = now;
+
+    if (m_velocity.size() < STOP_VELOCITY)
+        m_velocity = {};
+
+    return delta;
+}
+
+bool CKineticScroll::active() const {
+    return m_pending != Vector2D{} || flinging();
+}
+
+bool CKineticScroll::flinging() const {
+    return m_velocity != Vector2D{};
+}
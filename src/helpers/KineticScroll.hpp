@@ -0,0 +1,43 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+#include <hyprutils/math/Vector2D.hpp>
+
+namespace Hyprtoolkit {
+
+    // CKineticScroll gathers the scrolling that comes in between frames, so that a frame scrolls once.
+    // Finger scrolling (touchpads) keeps going after the fingers lift, slowing down with friction.
+    class CKineticScroll {
+      public:
+        using clock = std::chrono::steady_clock;
+
+        // time is the input's own (ms), only used to tell how fast the fingers went
+        void                      push(const Hyprutils::Math::Vector2D& delta, uint32_t time, bool finger);
+
+        // the fingers lifted at time, keeps going if they were moving. now is the frame clock's
+        void                      lift(uint32_t time, const clock::time_point& now = clock::now());
+        void                      cancel();
+
+        // what to scroll by this frame
+        Hyprutils::Math::Vector2D frame(const clock::time_point& now = clock::now());
+
+        // there's scrolling left, for this frame or the next ones
+        bool                      active() const;
+        bool                      flinging() const;
+
+      private:
+        struct SSample {
+            Hyprutils::Math::Vector2D delta;
+            uint32_t                  time = 0;
+        };
+
+        Hyprutils::Math::Vector2D m_pending;
+        std::vector<SSample>      m_samples;
+
+        Hyprutils::Math::Vector2D m_velocity; // px/ms
+        clock::time_point         m_lastFrame;
+    };
+}
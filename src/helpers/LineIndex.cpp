@@ -0,0 +1,108 @@
+#include "LineIndex.hpp"
+
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <hyprutils/memory/Casts.hpp>
+
+using namespace Hyprtoolkit;
+
+CLineIndex::~CLineIndex() {
+    if (m_mapped)
+        munmap(m_mapped, m_size);
+}
+
+UP<CLineIndex> CLineIndex::fromFile(const std::string& path) {
+    const int FD = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (FD < 0)
+        return nullptr;
+
+    struct stat st;
+    if (fstat(FD, &st) != 0 || !S_ISREG(st.st_mode)) {
+        close(FD);
+        return nullptr;
+    }
+
+    auto index = UP<CLineIndex>(new CLineIndex());
+
+    if (st.st_size == 0) {
+        close(FD);
+        return index;
+    }
+
+    void* mapped = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, FD, 0);
+    close(FD);
+
+    if (mapped == MAP_FAILED)
+        return nullptr;
+
+    index->m_mapped = mapped;
+    index->m_data   = sc<const char*>(mapped);
+    index->m_size   = st.st_size;
+
+    // we walk the whole thing once to index it, afterwards access is random (whatever is scrolled to)
+    madvise(mapped, st.st_size, MADV_SEQUENTIAL);
+    index->build();
+    madvise(mapped, st.st_size, MADV_RANDOM);
+
+    return index;
+}
+
+UP<CLineIndex> CLineIndex::fromString(std::string&& text) {
+    auto index     = UP<CLineIndex>(new CLineIndex());
+    index->m_owned = std::move(text);
+    index->m_data  = index->m_owned.data();
+    index->m_size  = index->m_owned.size();
+    index->build();
+    return index;
+}
+
+void CLineIndex::build() {
+    m_starts.clear();
+
+    if (m_size == 0)
+        return;
+
+    m_starts.emplace_back(0);
+
+    const char* cur = m_data;
+    const char* END = m_data + m_size;
+
+    while (cur < END) {
+        const char* newline = sc<const char*>(memchr(cur, '\n', END - cur));
+        if (!newline)
+            break;
+
+        cur = newline + 1;
+
+        if (cur < END)
+            m_starts.emplace_back(cur - m_data);
+    }
+
+    m_starts.shrink_to_fit();
+}
+
+size_t CLineIndex::lines() const {
+    return m_starts.size();
+}
+
+size_t CLineIndex::bytes() const {
+    return m_size;
+}
+
+std::string_view CLineIndex::line(size_t idx) const {
+    if (idx >= m_starts.size())
+        return {};
+
+    const size_t BEGIN = m_starts[idx];
+    size_t       end   = idx + 1 < m_starts.size() ? m_starts[idx + 1] - 1 : m_size;
+
+    if (end > BEGIN && m_data[end - 1] == '\n')
+        end--;
+    if (end > BEGIN && m_data[end - 1] == '\r')
+        end--;
+
+    return std::string_view{m_data + BEGIN, end - BEGIN};
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+
+#include "Memory.hpp"
+
+namespace Hyprtoolkit {
+
+    // CLineIndex indexes the line starts of a (potentially huge) text, so that any line can be fetched in O(1).
+    // Files are mmap'd, so only the pages of lines actually read are ever loaded.
+    // A trailing newline does not start a new line, and \r\n line endings are stripped.
+    class CLineIndex {
+      public:
+        ~CLineIndex();
+
+        CLineIndex(const CLineIndex&)            = delete;
+        CLineIndex& operator=(const CLineIndex&) = delete;
+
+        // nullptr on failure
+        static UP<CLineIndex> fromFile(const std::string& path);
+        static UP<CLineIndex> fromString(std::string&& text);
+
+        size_t                lines() const;
+        std::string_view      line(size_t idx) const;
+        size_t                bytes() const;
+
+      private:
+        CLineIndex() = default;
+
+        void                  build();
+
+        const char*           m_data   = nullptr;
+        size_t                m_size   = 0;
+        void*                 m_mapped = nullptr;
+        std::string           m_owned;
+        std::vector<uint64_t> m_starts;
+    };
+}
@@ -0,0 +1,72 @@
+#include "RenderTransform.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+using namespace Hyprtoolkit;
+using namespace Hyprutils::Math;
+
+static Vector2D rotate(const Vector2D& v, double rad) {
+    const double SIN = std::sin(rad);
+    const double COS = std::cos(rad);
+    return {(v.x * COS) - (v.y * SIN), (v.x * SIN) + (v.y * COS)};
+}
+
+SRenderTransform SRenderTransform::make(const Vector2D& translate, double scale, double rotation, float opacity, const Vector2D& pivot) {
+    // p' = pivot + s * R * (p - pivot) + translate
+    return SRenderTransform{
+        .scale    = scale,
+        .rotation = rotation,
+        .offset   = pivot + translate - (rotate(pivot, rotation) * scale),
+        .opacity  = opacity,
+    };
+}
+
+bool SRenderTransform::identity() const {
+    return scale == 1.0 && rotation == 0.0 && offset == Vector2D{} && opacity == 1.F;
+}
+
+SRenderTransform SRenderTransform::then(const SRenderTransform& outer) const {
+    return SRenderTransform{
+        .scale    = scale * outer.scale,
+        .rotation = rotation + outer.rotation,
+        .offset   = outer.apply(offset),
+        .opacity  = opacity * outer.opacity,
+    };
+}
+
+Vector2D SRenderTransform::apply(const Vector2D& point) const {
+    return (rotate(point, rotation) * scale) + offset;
+}
+
+CBox SRenderTransform::apply(const CBox& box) const {
+    if (identity())
+        return box;
+
+    const auto SIZE = box.size() * scale;
+
+    CBox       result{apply(box.middle()) - (SIZE / 2.0), SIZE};
+    result.rot = box.rot + rotation;
+    return result;
+}
+
+CBox SRenderTransform::bounds(const CBox& box) const {
+    if (rotation == 0.0)
+        return apply(box);
+
+    const std::array<Vector2D, 4> CORNERS = {
+        apply(box.pos()),
+        apply(box.pos() + Vector2D{box.w, 0}),
+        apply(box.pos() + Vector2D{0, box.h}),
+        apply(box.pos() + box.size()),
+    };
+
+    Vector2D min = CORNERS[0], max = CORNERS[0];
+    for (const auto& c : CORNERS) {
+        min = {std::min(min.x, c.x), std::min(min.y, c.y)};
+        max = {std::max(max.x, c.x), std::max(max.y, c.y)};
+    }
+
+    return {min, max - min};
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <hyprutils/math/Box.hpp>
+#include <hyprutils/math/Vector2D.hpp>
+
+namespace Hyprtoolkit {
+
+    // How something is drawn compared to where it's laid out: scaled, rotated, then moved, and faded.
+    // An element's own, and what it and all of its parents' make together, see SElementInternalData::drawTransform
+    struct SRenderTransform {
+        double                    scale    = 1.0;
+        double                    rotation = 0.0; // radians, clockwise on screen
+        Hyprutils::Math::Vector2D offset;
+        float                     opacity = 1.F;
+
+        // scaled and rotated around pivot, then moved by translate
+        static SRenderTransform make(const Hyprutils::Math::Vector2D& translate, double scale, double rotation, float opacity, const Hyprutils::Math::Vector2D& pivot);
+
+        bool                      identity() const;
+
+        // this, then outer
+        SRenderTransform          then(const SRenderTransform& outer) const;
+
+        Hyprutils::Math::Vector2D apply(const Hyprutils::Math::Vector2D& point) const;
+
+        // the box as drawn: its center moved, its size scaled, rotated around its center by rot
+        Hyprutils::Math::CBox     apply(const Hyprutils::Math::CBox& box) const;
+
+        // what the box covers once drawn, axis aligned
+        Hyprutils::Math::CBox     bounds(const Hyprutils::Math::CBox& box) const;
+    };
+}
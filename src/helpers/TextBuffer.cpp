@@ -0,0 +1,238 @@
+#include "TextBuffer.hpp"
+
+#include <algorithm>
+
+using namespace Hyprtoolkit;
+
+CTextBuffer::CTextBuffer() {
+    assign("");
+}
+
+CTextBuffer::CTextBuffer(const std::string_view& text) {
+    assign(text);
+}
+
+void CTextBuffer::assign(const std::string_view& text) {
+    const size_t OLD_PARAGRAPHS = m_paragraphs.size();
+
+    m_paragraphs.clear();
+
+    size_t last = 0;
+    while (true) {
+        const size_t NEWLINE = text.find('\n', last);
+        if (NEWLINE == std::string_view::npos) {
+            m_paragraphs.emplace_back(text.substr(last));
+            break;
+        }
+
+        m_paragraphs.emplace_back(text.substr(last, NEWLINE - last));
+        last = NEWLINE + 1;
+    }
+
+    m_length     = text.size();
+    m_cacheValid = false;
+    invalidateStarts(0);
+
+    damage(0, OLD_PARAGRAPHS, m_paragraphs.size());
+}
+
+void CTextBuffer::insert(size_t offset, const std::string_view& text) {
+    if (text.empty())
+        return;
+
+    const auto [IDX, COL] = locate(offset);
+
+    if (m_cacheValid)
+        m_cached.insert(m_starts[IDX] + COL, text);
+
+    if (!text.contains('\n')) {
+        m_paragraphs[IDX].insert(COL, text);
+        m_length += text.size();
+        invalidateStarts(IDX + 1);
+        damage(IDX, 1, 1);
+        return;
+    }
+
+    // split the paragraph at the insertion point and glue the new ones in between
+    std::string              tail = m_paragraphs[IDX].substr(COL);
+    std::vector<std::string> newParagraphs;
+
+    size_t                   last = 0;
+    while (true) {
+        const size_t NEWLINE = text.find('\n', last);
+        if (NEWLINE == std::string_view::npos) {
+            newParagraphs.emplace_back(text.substr(last));
+            break;
+        }
+
+        newParagraphs.emplace_back(text.substr(last, NEWLINE - last));
+        last = NEWLINE + 1;
+    }
+
+    m_paragraphs[IDX].resize(COL);
+    m_paragraphs[IDX] += newParagraphs.front();
+    newParagraphs.back() += tail;
+
+    const size_t ADDED = newParagraphs.size();
+
+    m_paragraphs.insert(m_paragraphs.begin() + IDX + 1, std::make_move_iterator(newParagraphs.begin() + 1), std::make_move_iterator(newParagraphs.end()));
+
+    m_length += text.size();
+    invalidateStarts(IDX + 1);
+    damage(IDX, 1, ADDED);
+}
+
+void CTextBuffer::erase(size_t begin, size_t end) {
+    end = std::min(end, m_length);
+
+    if (begin >= end)
+        return;
+
+    const auto [IDX_BEGIN, COL_BEGIN] = locate(begin);
+    const auto [IDX_END, COL_END]     = locate(end);
+
+    if (m_cacheValid)
+        m_cached.erase(begin, end - begin);
+
+    if (IDX_BEGIN == IDX_END) {
+        m_paragraphs[IDX_BEGIN].erase(COL_BEGIN, COL_END - COL_BEGIN);
+        m_length -= end - begin;
+        invalidateStarts(IDX_BEGIN + 1);
+        damage(IDX_BEGIN, 1, 1);
+        return;
+    }
+
+    m_paragraphs[IDX_BEGIN].resize(COL_BEGIN);
+    m_paragraphs[IDX_BEGIN] += std::string_view{m_paragraphs[IDX_END]}.substr(COL_END);
+    m_paragraphs.erase(m_paragraphs.begin() + IDX_BEGIN + 1, m_paragraphs.begin() + IDX_END + 1);
+
+    m_length -= end - begin;
+    invalidateStarts(IDX_BEGIN + 1);
+    damage(IDX_BEGIN, IDX_END - IDX_BEGIN + 1, 1);
+}
+
+size_t CTextBuffer::length() const {
+    return m_length;
+}
+
+bool CTextBuffer::empty() const {
+    return m_length == 0;
+}
+
+const std::string& CTextBuffer::str() {
+    if (m_cacheValid)
+        return m_cached;
+
+    m_cached.clear();
+    m_cached.reserve(m_length);
+
+    for (size_t i = 0; i < m_paragraphs.size(); ++i) {
+        if (i != 0)
+            m_cached += '\n';
+        m_cached += m_paragraphs[i];
+    }
+
+    m_cacheValid = true;
+    return m_cached;
+}
+
+bool CTextBuffer::matches(const std::string_view& text) const {
+    if (text.size() != m_length)
+        return false;
+
+    if (m_cacheValid)
+        return m_cached == text;
+
+    size_t pos = 0;
+    for (size_t i = 0; i < m_paragraphs.size(); ++i) {
+        if (i != 0 && text[pos++] != '\n')
+            return false;
+
+        if (text.compare(pos, m_paragraphs[i].size(), m_paragraphs[i]) != 0)
+            return false;
+
+        pos += m_paragraphs[i].size();
+    }
+
+    return true;
+}
+
+size_t CTextBuffer::paragraphs() const {
+    return m_paragraphs.size();
+}
+
+const std::string& CTextBuffer::paragraph(size_t idx) const {
+    return m_paragraphs.at(idx);
+}
+
+size_t CTextBuffer::paragraphStart(size_t idx) {
+    updateStarts();
+    return m_starts.at(idx);
+}
+
+std::pair<size_t, size_t> CTextBuffer::locate(size_t offset) {
+    updateStarts();
+
+    offset = std::min(offset, m_length);
+
+    // first paragraph starting after offset, the one before it contains it
+    const auto   IT  = std::ranges::upper_bound(m_starts, offset);
+    const size_t IDX = std::distance(m_starts.begin(), IT) - 1;
+
+    return {IDX, offset - m_starts[IDX]};
+}
+
+void CTextBuffer::markDirty(size_t idx) {
+    if (idx >= m_paragraphs.size())
+        return;
+
+    damage(idx, 1, 1);
+}
+
+std::optional<CTextBuffer::SParagraphDamage> CTextBuffer::takeDamage() {
+    auto dmg = m_damage;
+    m_damage.reset();
+    return dmg;
+}
+
+void CTextBuffer::damage(size_t first, size_t removed, size_t added) {
+    if (!m_damage) {
+        m_damage = SParagraphDamage{.first = first, .removed = removed, .added = added};
+        return;
+    }
+
+    // merge with the pending damage. The pending damage is expressed in coordinates from before this edit,
+    // so the union is [start, end) there, and everything past the pending range maps back to the old state
+    // with a constant shift.
+    const auto&  OLD   = *m_damage;
+    const size_t START = std::min(OLD.first, first);
+    const size_t END   = std::max(OLD.first + OLD.added, first + removed);
+
+    m_damage = SParagraphDamage{
+        .first   = START,
+        .removed = END + OLD.removed - OLD.added - START,
+        .added   = END + added - removed - START,
+    };
+}
+
+void CTextBuffer::invalidateStarts(size_t from) {
+    m_startsValid = std::min(m_startsValid, from);
+}
+
+void CTextBuffer::updateStarts() {
+    if (m_startsValid >= m_paragraphs.size() && m_starts.size() == m_paragraphs.size())
+        return;
+
+    m_starts.resize(m_paragraphs.size());
+
+    if (m_startsValid == 0) {
+        m_starts[0]   = 0;
+        m_startsValid = 1;
+    }
+
+    for (size_t i = m_startsValid; i < m_paragraphs.size(); ++i) {
+        m_starts[i] = m_starts[i - 1] + m_paragraphs[i - 1].size() + 1 /* \n */;
+    }
+
+    m_startsValid = m_paragraphs.size();
+}
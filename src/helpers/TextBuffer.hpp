@@ -0,0 +1,66 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <optional>
+#include <utility>
+
+namespace Hyprtoolkit {
+
+    // CTextBuffer is an editable text buffer split into paragraphs (runs of text between '\n').
+    // Edits only touch the paragraphs they intersect, and the buffer keeps track of which paragraphs
+    // changed since the last takeDamage(), so that consumers (e.g. the textbox) can re-layout and
+    // re-render only those.
+    // Offsets are byte offsets into the full text, newlines included.
+    class CTextBuffer {
+      public:
+        CTextBuffer();
+        explicit CTextBuffer(const std::string_view& text);
+        ~CTextBuffer() = default;
+
+        // paragraphs [first, first + removed) of the old state were replaced with
+        // paragraphs [first, first + added) of the current state.
+        struct SParagraphDamage {
+            size_t first = 0, removed = 0, added = 0;
+        };
+
+        void                            assign(const std::string_view& text);
+        void                            insert(size_t offset, const std::string_view& text);
+        void                            erase(size_t begin, size_t end);
+
+        size_t                          length() const;
+        bool                            empty() const;
+
+        // materialized text. Built on first use, edits are then applied to it in place.
+        const std::string&              str();
+        // compares without materializing
+        bool                            matches(const std::string_view& text) const;
+
+        size_t                          paragraphs() const;
+        const std::string&              paragraph(size_t idx) const;
+        size_t                          paragraphStart(size_t idx);
+
+        // returns the paragraph idx and the byte offset inside of it
+        std::pair<size_t, size_t>       locate(size_t offset);
+
+        // force a paragraph to be reported in the damage
+        void                            markDirty(size_t idx);
+        std::optional<SParagraphDamage> takeDamage();
+
+      private:
+        void                            damage(size_t first, size_t removed, size_t added);
+        void                            invalidateStarts(size_t from);
+        void                            updateStarts();
+
+        std::vector<std::string>        m_paragraphs;
+        std::vector<size_t>             m_starts;
+        size_t                          m_startsValid = 0;
+        size_t                          m_length      = 0;
+
+        std::string                     m_cached;
+        bool                            m_cacheValid = false;
+
+        std::optional<SParagraphDamage> m_damage;
+    };
+}
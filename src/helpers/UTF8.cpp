@@ -1,8 +1,37 @@
 #include "UTF8.hpp"
+#include "UTF8Simd.hpp"
+
+#include <algorithm>
+#include <cstring>
 #include <string_view>
+#include <hyprutils/memory/Casts.hpp>
 
 using namespace Hyprtoolkit;
 using namespace Hyprtoolkit::UTF8;
+using namespace Hyprutils::Memory;
+
+// codepoints between two entries of a CCodepointIndex
+constexpr size_t INDEX_STRIDE = 64;
+
+static bool isStart(char c) {
+    return (c & 0xC0) != 0x80;
+}
+
+// Walking a string by codepoints steps on its first byte, and then on every byte that
+// isn't a continuation byte. These count and find those steps.
+static size_t countSteps(const char* data, size_t len) {
+    if (len == 0)
+        return 0;
+
+    return 1 + SIMD::countStarts(data + 1, len - 1);
+}
+
+static size_t nthStep(const char* data, size_t len, size_t n) {
+    if (len == 0 || n == 0)
+        return 0;
+
+    return 1 + SIMD::findNthStart(data + 1, len - 1, n - 1);
+}
 
 size_t UTF8::codepointLen(const char* utf8Char, size_t max) {
     size_t len = 1;
@@ -31,111 +60,69 @@ size_t UTF8::codepointLenBefore(const std::string& s, size_t offset) {
 }
 
 size_t UTF8::length(const std::string& s) {
-    if (s.empty())
-        return 0;
-
-    const char* c    = s.c_str();
-    size_t      len  = 0;
-    auto        endp = s.c_str() + s.length();
-    while (c < endp) {
-        c += codepointLen(c, (endp - c));
-        len++;
-    }
-    return len;
+    return countSteps(s.data(), s.length());
 }
 
 /// Converts a byte index to a codepoint index.
 size_t UTF8::offsetToUTF8Len(const std::string& s, size_t offset) {
-    if (s.empty())
-        return 0;
-
-    const char* c    = s.c_str();
-    size_t      len  = 0;
-    auto        endp = std::min(s.c_str() + s.length(), s.c_str() + offset);
-    while (c < endp) {
-        c += codepointLen(c, (endp - c));
-        len++;
-    }
-    return len;
+    return countSteps(s.data(), std::min(offset, s.length()));
 }
 
 /// Converts a codepoint index to a byte index.
 size_t UTF8::utf8ToOffset(const std::string& s, size_t utf8) {
-    if (s.empty())
-        return 0;
-
-    const char* c    = s.c_str();
-    size_t      len  = 0;
-    auto        endp = s.c_str() + s.length();
-    while (c < endp) {
-        if (len >= utf8)
-            return c - s.c_str();
-
-        c += codepointLen(c, (endp - c));
-        len++;
-    }
-    return s.size();
+    return nthStep(s.data(), s.length(), utf8);
 }
 
 std::string UTF8::substr(const std::string& s, size_t start, size_t length) {
     if (s.empty() || length == 0)
         return "";
 
-    bool        started   = false;
-    size_t      byteStart = 0, byteEnd = std::string::npos;
-
-    const char* c    = s.c_str();
-    size_t      len  = 0;
-    auto        endp = s.c_str() + s.length();
-    while (c < endp) {
-        if (len >= start && !started) {
-            started   = true;
-            byteStart = c - s.c_str();
-
-            if (length == std::string::npos)
-                break;
-
-            len = 0;
-        }
-
-        c += codepointLen(c, endp - c);
-
-        len++;
-
-        if (len >= length && started) {
-            byteEnd = c - s.c_str();
-            break;
-        }
-    }
-
-    if (len == 0 || !started)
+    const auto BYTE_START = utf8ToOffset(s, start);
+    if (BYTE_START >= s.length())
         return "";
 
-    if (byteEnd == std::string::npos)
-        return s.substr(byteStart);
+    if (length == std::string::npos || start + length < start)
+        return s.substr(BYTE_START);
 
-    return s.substr(byteStart, byteEnd - byteStart);
+    return s.substr(BYTE_START, utf8ToOffset(s, start + length) - BYTE_START);
 }
 
 size_t UTF8::findFirstOf(const std::string& s, const std::string ch, size_t offset) {
-    while (offset < s.length()) {
-        const auto c     = s.data() + offset;
-        const auto cpLen = codepointLen(c, s.length() - offset);
-        if (std::string_view{c, cpLen} == ch)
-            return offset;
-        offset += cpLen;
+    if (ch.empty())
+        return std::string::npos;
+
+    // let memchr find candidates, and only accept ones that are a whole codepoint we'd step on
+    for (size_t pos = s.find(ch[0], offset); pos != std::string::npos; pos = s.find(ch[0], pos + 1)) {
+        if (pos != offset && !isStart(s[pos]))
+            continue;
+
+        if (codepointLen(&s[pos], s.length() - pos) == ch.length() && s.compare(pos, ch.length(), ch) == 0)
+            return pos;
     }
+
     return std::string::npos;
 }
 
 size_t UTF8::findLastOf(const std::string& s, const std::string ch, size_t offset) {
+    if (ch.empty())
+        return std::string::npos;
+
     offset = std::min(offset, s.length());
-    while (offset > 0) {
-        const auto cpLen = codepointLenBefore(s, offset);
-        offset -= cpLen;
-        if (std::string_view{&s[offset], cpLen} == ch)
-            return offset;
+
+    // same as above, backwards. The codepoint before offset is cut at offset.
+    for (size_t end = offset; end > 0;) {
+        const auto FOUND = sc<const char*>(memrchr(s.data(), ch[0], end));
+        if (!FOUND)
+            break;
+
+        const size_t POS = FOUND - s.data();
+
+        if ((POS == 0 || isStart(s[POS])) && codepointLen(FOUND, offset - POS) == ch.length() && s.compare(POS, ch.length(), ch) == 0)
+            return POS;
+
+        end = POS;
     }
+
     return std::string::npos;
 }
 
@@ -160,3 +147,66 @@ size_t UTF8::findLastNotOf(const std::string& s, const std::string ch, size_t of
     }
     return std::string::npos;
 }
+
+UTF8::CCodepointIndex::CCodepointIndex(const std::string& s) {
+    rebuild(s);
+}
+
+void UTF8::CCodepointIndex::rebuild(const std::string& s) {
+    m_offsets.clear();
+    m_length = 0;
+
+    if (s.empty())
+        return;
+
+    size_t pos = 0;
+    while (true) {
+        m_offsets.emplace_back(pos);
+
+        const size_t NEXT = nthStep(s.data() + pos, s.length() - pos, INDEX_STRIDE);
+        if (pos + NEXT >= s.length())
+            break;
+
+        pos += NEXT;
+    }
+
+    m_length = (m_offsets.size() - 1) * INDEX_STRIDE + countSteps(s.data() + pos, s.length() - pos);
+}
+
+size_t UTF8::CCodepointIndex::length() const {
+    return m_length;
+}
+
+size_t UTF8::CCodepointIndex::offsetToUTF8Len(const std::string& s, size_t offset) const {
+    const size_t END = std::min(offset, s.length());
+
+    if (END == 0 || m_offsets.empty())
+        return 0;
+
+    // last indexed codepoint before END. The first one is at 0, so there always is one.
+    const auto   IT    = std::ranges::upper_bound(m_offsets, END - 1) - 1;
+    const size_t BLOCK = IT - m_offsets.begin();
+
+    return BLOCK * INDEX_STRIDE + countSteps(s.data() + *IT, END - *IT);
+}
+
+size_t UTF8::CCodepointIndex::utf8ToOffset(const std::string& s, size_t utf8) const {
+    if (utf8 >= m_length)
+        return s.length();
+
+    const size_t BASE = m_offsets[utf8 / INDEX_STRIDE];
+
+    return BASE + nthStep(s.data() + BASE, s.length() - BASE, utf8 % INDEX_STRIDE);
+}
+
+std::string UTF8::CCodepointIndex::substr(const std::string& s, size_t start, size_t len) const {
+    if (s.empty() || len == 0 || start >= m_length)
+        return "";
+
+    const auto BYTE_START = utf8ToOffset(s, start);
+
+    if (len == std::string::npos || start + len < start)
+        return s.substr(BYTE_START);
+
+    return s.substr(BYTE_START, utf8ToOffset(s, start + len) - BYTE_START);
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <vector>
 
 namespace Hyprtoolkit::UTF8 {
     size_t      codepointLen(const char* utf8Char, size_t max);
@@ -13,4 +14,25 @@ namespace Hyprtoolkit::UTF8 {
     size_t      findLastOf(const std::string&, const std::string ch, size_t offset = std::string::npos);
     size_t      findFirstNotOf(const std::string&, const std::string ch, size_t offset = 0);
     size_t      findLastNotOf(const std::string&, const std::string ch, size_t offset = std::string::npos);
+
+    /*
+        Sparse table of codepoint offsets in a string, for converting
+        many times on a long text. Rebuild it after the string changes.
+    */
+    class CCodepointIndex {
+      public:
+        CCodepointIndex() = default;
+        explicit CCodepointIndex(const std::string& s);
+
+        void                rebuild(const std::string& s);
+
+        size_t              length() const;
+        size_t              offsetToUTF8Len(const std::string& s, size_t offset) const;
+        size_t              utf8ToOffset(const std::string& s, size_t utf8) const;
+        std::string         substr(const std::string& s, size_t start, size_t len = std::string::npos) const;
+
+      private:
+        std::vector<size_t> m_offsets; // of every STRIDE-th codepoint
+        size_t              m_length = 0;
+    };
 }
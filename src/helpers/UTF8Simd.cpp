@@ -0,0 +1,276 @@
+#include "UTF8Simd.hpp"
+
+#include <bit>
+#include <cstring>
+#include <hyprutils/memory/Casts.hpp>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+using namespace Hyprtoolkit;
+using namespace Hyprtoolkit::UTF8;
+using namespace Hyprutils::Memory;
+
+// continuation bytes are 0x80 - 0xBF, which is -128 - -65 as signed chars
+constexpr int8_t   LAST_CONTINUATION = -65;
+constexpr uint64_t HIGH_BITS         = 0x8080808080808080ULL;
+
+// byte counters in vector accumulators overflow after 255 blocks
+constexpr size_t MAX_ACCUMULATED_BLOCKS = 255;
+
+static bool isStart(char c) {
+    return (c & 0xC0) != 0x80;
+}
+
+static size_t nthSetBit(uint32_t mask, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+        mask &= mask - 1;
+    }
+    return std::countr_zero(mask);
+}
+
+// scalar: 8 bytes at a time in a register.
+// A continuation byte has bit 7 set and bit 6 clear, shifting left by one lines bit 6 up with bit 7.
+static size_t continuationsInWord(uint64_t w) {
+    return std::popcount(w & ~(w << 1) & HIGH_BITS);
+}
+
+static size_t countStartsScalar(const char* data, size_t len) {
+    size_t count = 0;
+    size_t i     = 0;
+
+    for (; i + 8 <= len; i += 8) {
+        uint64_t w;
+        std::memcpy(&w, data + i, 8);
+        count += 8 - continuationsInWord(w);
+    }
+
+    for (; i < len; ++i) {
+        count += isStart(data[i]);
+    }
+
+    return count;
+}
+
+static size_t findNthStartScalar(const char* data, size_t len, size_t n, size_t from = 0) {
+    size_t i = from;
+
+    for (; i + 8 <= len; i += 8) {
+        uint64_t w;
+        std::memcpy(&w, data + i, 8);
+        const size_t STARTS = 8 - continuationsInWord(w);
+        if (n < STARTS)
+            break;
+        n -= STARTS;
+    }
+
+    for (; i < len; ++i) {
+        if (!isStart(data[i]))
+            continue;
+        if (n == 0)
+            return i;
+        n--;
+    }
+
+    return len;
+}
+
+#if defined(__x86_64__)
+
+static size_t countStartsSSE2(const char* data, size_t len) {
+    const __m128i THRESHOLD = _mm_set1_epi8(LAST_CONTINUATION);
+    const __m128i ZERO      = _mm_setzero_si128();
+
+    size_t        count = 0;
+    size_t        i     = 0;
+
+    while (i + 16 <= len) {
+        __m128i acc = ZERO;
+
+        for (size_t blocks = 0; blocks < MAX_ACCUMULATED_BLOCKS && i + 16 <= len; ++blocks, i += 16) {
+            const __m128i V = _mm_loadu_si128(rc<const __m128i*>(data + i));
+            // 0xFF where the byte starts a codepoint, subtracting it counts up by one
+            acc = _mm_sub_epi8(acc, _mm_cmpgt_epi8(V, THRESHOLD));
+        }
+
+        const __m128i SUMS = _mm_sad_epu8(acc, ZERO);
+        count += _mm_cvtsi128_si64(SUMS) + _mm_cvtsi128_si64(_mm_unpackhi_epi64(SUMS, SUMS));
+    }
+
+    return count + countStartsScalar(data + i, len - i);
+}
+
+static size_t findNthStartSSE2(const char* data, size_t len, size_t n) {
+    const __m128i THRESHOLD = _mm_set1_epi8(LAST_CONTINUATION);
+
+    size_t        i = 0;
+
+    for (; i + 16 <= len; i += 16) {
+        const __m128i  V      = _mm_loadu_si128(rc<const __m128i*>(data + i));
+        const uint32_t MASK   = _mm_movemask_epi8(_mm_cmpgt_epi8(V, THRESHOLD));
+        const size_t   STARTS = std::popcount(MASK);
+
+        if (n < STARTS)
+            return i + nthSetBit(MASK, n);
+
+        n -= STARTS;
+    }
+
+    return findNthStartScalar(data, len, n, i);
+}
+
+__attribute__((target("avx2,popcnt"))) static size_t countStartsAVX2(const char* data, size_t len) {
+    const __m256i THRESHOLD = _mm256_set1_epi8(LAST_CONTINUATION);
+    const __m256i ZERO      = _mm256_setzero_si256();
+
+    size_t        count = 0;
+    size_t        i     = 0;
+
+    while (i + 32 <= len) {
+        __m256i acc = ZERO;
+
+        for (size_t blocks = 0; blocks < MAX_ACCUMULATED_BLOCKS && i + 32 <= len; ++blocks, i += 32) {
+            const __m256i V = _mm256_loadu_si256(rc<const __m256i*>(data + i));
+            acc             = _mm256_sub_epi8(acc, _mm256_cmpgt_epi8(V, THRESHOLD));
+        }
+
+        const __m256i SUMS = _mm256_sad_epu8(acc, ZERO);
+        count += _mm256_extract_epi64(SUMS, 0) + _mm256_extract_epi64(SUMS, 1) + _mm256_extract_epi64(SUMS, 2) + _mm256_extract_epi64(SUMS, 3);
+    }
+
+    return count + countStartsScalar(data + i, len - i);
+}
+
+__attribute__((target("avx2,popcnt"))) static size_t findNthStartAVX2(const char* data, size_t len, size_t n) {
+    const __m256i THRESHOLD = _mm256_set1_epi8(LAST_CONTINUATION);
+
+    size_t        i = 0;
+
+    for (; i + 32 <= len; i += 32) {
+        const __m256i  V      = _mm256_loadu_si256(rc<const __m256i*>(data + i));
+        const uint32_t MASK   = _mm256_movemask_epi8(_mm256_cmpgt_epi8(V, THRESHOLD));
+        const size_t   STARTS = std::popcount(MASK);
+
+        if (n < STARTS)
+            return i + nthSetBit(MASK, n);
+
+        n -= STARTS;
+    }
+
+    return findNthStartScalar(data, len, n, i);
+}
+
+#elif defined(__aarch64__)
+
+static size_t countStartsNEON(const char* data, size_t len) {
+    const int8x16_t THRESHOLD = vdupq_n_s8(LAST_CONTINUATION);
+
+    size_t          count = 0;
+    size_t          i     = 0;
+
+    while (i + 16 <= len) {
+        uint8x16_t acc = vdupq_n_u8(0);
+
+        for (size_t blocks = 0; blocks < MAX_ACCUMULATED_BLOCKS && i + 16 <= len; ++blocks, i += 16) {
+            const int8x16_t V = vld1q_s8(rc<const int8_t*>(data + i));
+            acc               = vsubq_u8(acc, vcgtq_s8(V, THRESHOLD));
+        }
+
+        count += vaddlvq_u8(acc);
+    }
+
+    return count + countStartsScalar(data + i, len - i);
+}
+
+static size_t findNthStartNEON(const char* data, size_t len, size_t n) {
+    const int8x16_t THRESHOLD = vdupq_n_s8(LAST_CONTINUATION);
+
+    size_t          i = 0;
+
+    // no movemask on neon, so only count per block and find the exact byte in the one that has it
+    for (; i + 16 <= len; i += 16) {
+        const int8x16_t V      = vld1q_s8(rc<const int8_t*>(data + i));
+        const size_t    STARTS = vaddvq_u8(vshrq_n_u8(vcgtq_s8(V, THRESHOLD), 7));
+
+        if (n < STARTS)
+            break;
+
+        n -= STARTS;
+    }
+
+    return findNthStartScalar(data, len, n, i);
+}
+
+#endif
+
+SIMD::eImplementation SIMD::implementation() {
+    static const auto IMPL = [] {
+#if defined(__x86_64__)
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt"))
+            return IMPL_AVX2;
+        return IMPL_SSE2;
+#elif defined(__aarch64__)
+        return IMPL_NEON;
+#else
+        return IMPL_SCALAR;
+#endif
+    }();
+
+    return IMPL;
+}
+
+std::vector<SIMD::eImplementation> SIMD::supportedImplementations() {
+    std::vector<eImplementation> impls = {IMPL_SCALAR};
+
+#if defined(__x86_64__)
+    impls.emplace_back(IMPL_SSE2);
+    if (implementation() == IMPL_AVX2)
+        impls.emplace_back(IMPL_AVX2);
+#elif defined(__aarch64__)
+    impls.emplace_back(IMPL_NEON);
+#endif
+
+    return impls;
+}
+
+const char* SIMD::implementationName(eImplementation impl) {
+    switch (impl) {
+        case IMPL_SCALAR: return "scalar";
+        case IMPL_SSE2: return "sse2";
+        case IMPL_AVX2: return "avx2";
+        case IMPL_NEON: return "neon";
+    }
+    return "unknown";
+}
+
+size_t SIMD::countStarts(const char* data, size_t len, eImplementation impl) {
+    switch (impl) {
+#if defined(__x86_64__)
+        case IMPL_SSE2: return countStartsSSE2(data, len);
+        case IMPL_AVX2: return countStartsAVX2(data, len);
+#elif defined(__aarch64__)
+        case IMPL_NEON: return countStartsNEON(data, len);
+#endif
+        default: break;
+    }
+
+    return countStartsScalar(data, len);
+}
+
+size_t SIMD::findNthStart(const char* data, size_t len, size_t n, eImplementation impl) {
+    switch (impl) {
+#if defined(__x86_64__)
+        case IMPL_SSE2: return findNthStartSSE2(data, len, n);
+        case IMPL_AVX2: return findNthStartAVX2(data, len, n);
+#elif defined(__aarch64__)
+        case IMPL_NEON: return findNthStartNEON(data, len, n);
+#endif
+        default: break;
+    }
+
+    return findNthStartScalar(data, len, n);
+}
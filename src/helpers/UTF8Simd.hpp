@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Vectorized kernels for the UTF8 helpers. Everything in there boils down to counting
+// or finding bytes that start a codepoint, i.e. aren't continuation bytes (0b10xxxxxx).
+namespace Hyprtoolkit::UTF8::SIMD {
+    enum eImplementation : uint8_t {
+        IMPL_SCALAR = 0,
+        IMPL_SSE2,
+        IMPL_AVX2,
+        IMPL_NEON,
+    };
+
+    // best one this cpu supports, detected once
+    eImplementation              implementation();
+    std::vector<eImplementation> supportedImplementations();
+    const char*                  implementationName(eImplementation impl);
+
+    // number of bytes in [data, data + len) that start a codepoint
+    size_t                       countStarts(const char* data, size_t len, eImplementation impl = implementation());
+
+    // index of the nth (0-based) byte in [data, data + len) that starts a codepoint, len if there are fewer
+    size_t                       findNthStart(const char* data, size_t len, size_t n, eImplementation impl = implementation());
+}
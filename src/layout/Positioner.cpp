@@ -3,6 +3,8 @@
 #include "../element/Element.hpp"
 #include "../window/ToolkitWindow.hpp"
 
+#include <utility>
+
 using namespace Hyprtoolkit;
 using namespace Hyprutils::Math;
 
@@ -10,15 +12,21 @@ void CPositioner::position(SP<IElement> element, const CBox& box, const Hyprutil
 
     initElementIfNeeded(element);
 
+    auto&      data = element->impl->positionerData;
+
+    // laid out right where a scroll moved it: what's on screen was copied along with the scroll
+    const bool SCROLLED = std::exchange(data->scrolled, false) && data->baseBox == box && data->maxSize == maxSize;
+
     // damage old box
-    if (element->impl->window)
-        element->impl->window->damage(element->impl->positionerData->baseBox);
+    if (!SCROLLED)
+        element->impl->damage(data->baseBox);
 
-    element->impl->positionerData->baseBox = box;
+    data->baseBox = box;
+    data->maxSize = maxSize;
     element->reposition(box, maxSize);
 
-    if (element->impl->window)
-        element->impl->window->damage(box);
+    if (!SCROLLED)
+        element->impl->damage(box);
 }
 
 void CPositioner::positionChildren(SP<IElement> element, const SRepositionData& data) {
@@ -28,7 +36,7 @@ void CPositioner::positionChildren(SP<IElement> element, const SRepositionData&
     // position children according to how they wanna be positioned
 
     for (const auto& c : C) {
-        auto itemSize = c->preferredSize(BOX.size());
+        auto itemSize = c->impl->measurePreferred(BOX.size());
 
         if (!itemSize) {
             // no size to base off of, just position
@@ -96,13 +104,79 @@ void CPositioner::repositionNeeded(SP<IElement> element, bool force) {
     if (!element->impl->parent->impl->positionerData || element->impl->parent->impl->positionerData->baseBox.empty()) {
         if (force) {
             initElementIfNeeded(element);
-            position(element, CBox{Vector2D{}, element->preferredSize(Vector2D{}).value_or(Vector2D{})});
+            position(element, CBox{Vector2D{}, element->impl->measurePreferred(Vector2D{}).value_or(Vector2D{})});
         } else if (element->impl->window) // full reflow needed
             element->impl->window->scheduleReposition(element->impl->window->m_rootElement);
         return;
     }
 
-    position(element->impl->parent.lock(), element->impl->parent->impl->positionerData->baseBox);
+    position(element->impl->parent.lock(), element->impl->parent->impl->positionerData->baseBox, element->impl->parent->impl->positionerData->maxSize);
+}
+
+SP<IElement> CPositioner::relayoutRoot(SP<IElement> element) {
+    // still fits the box it has
+    if (element->impl->measuresSame())
+        return element;
+
+    // otherwise up to a relayout boundary: something sized on its own, like an absolute size or a scroll area,
+    // or what didn't change size after all
+    auto root = element;
+    while (root->impl->parent) {
+        root = root->impl->parent.lock();
+
+        if (!root->positioningDependsOnChild() || root->impl->measuresSame())
+            break;
+    }
+
+    return root;
+}
+
+void CPositioner::relayout(const std::vector<WP<IElement>>& changed) {
+    for (const auto& e : changed) {
+        if (e)
+            e->impl->needsLayout = false;
+    }
+
+    // the bit now marks relayout roots, many changes share one
+    std::vector<SP<IElement>> roots;
+    for (const auto& e : changed) {
+        if (!e)
+            continue;
+
+        const auto ROOT = relayoutRoot(e.lock());
+        if (ROOT->impl->needsLayout)
+            continue;
+
+        ROOT->impl->needsLayout = true;
+        roots.emplace_back(ROOT);
+    }
+
+    // a root under another is laid out with it
+    std::vector<SP<IElement>> toLayout;
+    toLayout.reserve(roots.size());
+    for (const auto& root : roots) {
+        bool nested = false;
+        for (auto p = root->impl->parent.lock(); p && !nested; p = p->impl->parent.lock()) {
+            nested = p->impl->needsLayout;
+        }
+
+        if (!nested)
+            toLayout.emplace_back(root);
+    }
+
+    for (const auto& root : roots) {
+        root->impl->needsLayout = false;
+    }
+
+    for (const auto& root : toLayout) {
+        // the window's root, or a new subtree whose parent has to place it
+        if (!root->impl->parent || !root->impl->positionerData) {
+            repositionNeeded(root);
+            continue;
+        }
+
+        position(root, root->impl->positionerData->baseBox, root->impl->positionerData->maxSize);
+    }
 }
 
 void CPositioner::initElementIfNeeded(SP<IElement> el) {
@@ -4,11 +4,17 @@
 #include <hyprutils/math/Vector2D.hpp>
 #include "../helpers/Memory.hpp"
 
+#include <vector>
+
 namespace Hyprtoolkit {
     class IElement;
 
     struct SPositionerData {
-        Hyprutils::Math::CBox baseBox;
+        Hyprutils::Math::CBox     baseBox;
+        Hyprutils::Math::Vector2D maxSize = {-1, -1};
+
+        // moved by a scroll since it was laid out, nothing else changed. See IToolkitWindow::damageScroll
+        bool                      scrolled = false;
     };
 
     struct SRepositionData {
@@ -23,8 +29,12 @@ namespace Hyprtoolkit {
         void positionChildren(SP<IElement> element, const SRepositionData& data = {});
         void repositionNeeded(SP<IElement> element, bool force = false);
 
+        // lays out what changed again, each in the smallest subtree that keeps its box
+        void relayout(const std::vector<WP<IElement>>& changed);
+
       private:
-        void   initElementIfNeeded(SP<IElement> element);
+        void         initElementIfNeeded(SP<IElement> element);
+        SP<IElement> relayoutRoot(SP<IElement> element);
 
         size_t m_depth = 0;
     };
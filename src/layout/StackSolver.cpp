@@ -0,0 +1,140 @@
+#include "StackSolver.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace Hyprtoolkit;
+
+SStackSolution Hyprtoolkit::solveStack(const std::vector<SStackChild>& children, double available, double gap, const SStackPolicy& policy) {
+    SStackSolution solution;
+    solution.sizes.resize(children.size());
+    solution.failed.resize(children.size());
+
+    auto&  sizes = solution.sizes;
+    auto&  used  = solution.used;
+
+    double total = 0; // of every size so far
+
+    // children before the current one that can still shrink, the nearest on top, and by how much in all.
+    // Each goes on and comes off about once, which keeps this linear.
+    std::vector<size_t> shrinkable;
+    double              shrinkableBy = 0;
+
+    const auto          minOf = [&](size_t i) { return children[i].min.value_or(0); };
+    const auto          slack = [&](size_t i) { return sizes[i] - minOf(i); };
+
+    const auto          setSize = [&](size_t i, double size) {
+        total -= sizes[i];
+        sizes[i] = std::max(0.0, size);
+        total += sizes[i];
+    };
+
+    const auto push = [&](size_t i) {
+        if (slack(i) <= 0)
+            return;
+
+        shrinkable.emplace_back(i);
+        shrinkableBy += slack(i);
+    };
+
+    const auto pop = [&] {
+        shrinkableBy -= slack(shrinkable.back());
+        shrinkable.pop_back();
+    };
+
+    // takes needs off the children before, nearest first. If they can't give that much, nothing changes
+    const auto shrink = [&](double needs) {
+        if (needs > shrinkableBy)
+            return false;
+
+        while (needs > 0 && !shrinkable.empty()) {
+            const auto J     = shrinkable.back();
+            const auto SLACK = slack(J);
+
+            pop();
+
+            if (needs <= SLACK) {
+                setSize(J, sizes[J] - needs);
+                push(J);
+                break;
+            }
+
+            setSize(J, minOf(J));
+            needs -= SLACK;
+        }
+
+        return true;
+    };
+
+    for (size_t i = 0; i < children.size(); ++i) {
+        double size = children[i].size;
+
+        if (used + size > available + policy.overflowSlack) {
+            if (policy.tryMinimum) {
+                if (!children[i].min) {
+                    solution.failed[i] = true;
+                    continue;
+                }
+
+                size = *children[i].min;
+
+                if (used + size <= available + 1) {
+                    // squeeze it into what's left
+                    setSize(i, available - used);
+                    push(i);
+                    continue;
+                }
+            }
+
+            if (!shrink(used + size - (available + 1))) {
+                solution.failed[i] = true;
+
+                if (i == 0)
+                    continue;
+
+                // the previous one takes the rest, if it may
+                const auto   LAST  = i - 1;
+                const double GROWN = sizes[LAST] + available - used;
+                if (children[LAST].max && GROWN > *children[LAST].max)
+                    continue;
+
+                if (!shrinkable.empty() && shrinkable.back() == LAST)
+                    pop();
+
+                setSize(LAST, GROWN);
+                push(LAST);
+                continue;
+            }
+
+            setSize(i, size);
+            push(i);
+
+            // every child's gap, like it always was after a shrink
+            used = total + (children.size() * gap);
+            continue;
+        }
+
+        setSize(i, size);
+        push(i);
+
+        used += size + gap;
+        if (policy.wholePixels)
+            used = std::floor(used);
+    }
+
+    if (!children.empty())
+        used -= gap;
+
+    // the first that grows takes what's left
+    if (used < available) {
+        for (size_t i = 0; i < children.size(); ++i) {
+            if (!children[i].grow)
+                continue;
+
+            setSize(i, sizes[i] + available - used);
+            break;
+        }
+    }
+
+    return solution;
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+namespace Hyprtoolkit {
+
+    // One child of a column or row, along the layout's axis
+    struct SStackChild {
+        double                size = 0; // what it'd like
+        std::optional<double> min, max;
+        bool                  grow = false;
+    };
+
+    struct SStackPolicy {
+        // how far past the available space a child still fits
+        double overflowSlack = 1;
+
+        // rows: past that, a child is tried at its minimum, and squeezed into what's left if that fits
+        bool tryMinimum = false;
+
+        // columns: space used is counted in whole pixels
+        bool wholePixels = false;
+    };
+
+    struct SStackSolution {
+        std::vector<size_t> sizes;
+        std::vector<bool>   failed;
+
+        // of the available space, gaps included
+        double used = 0;
+    };
+
+    // Lays children out one after another in the available space. A child that doesn't fit shrinks the ones
+    // before it towards their minimum, nearest first, and if that isn't enough it's left out and the previous
+    // one takes the rest. Then the first that grows takes what's left.
+    // Linear in the number of children.
+    SStackSolution solveStack(const std::vector<SStackChild>& children, double available, double gap, const SStackPolicy& policy);
+}
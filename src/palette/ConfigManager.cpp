@@ -3,6 +3,10 @@
 #include <hyprutils/path/Path.hpp>
 
 #include "../core/InternalBackend.hpp"
+#include "../resource/assetCache/AssetCache.hpp"
+#include "../resource/diskCache/ImageDiskCache.hpp"
+#include "../resource/decode/DecodeScheduler.hpp"
+#include "../renderer/TextureRegistry.hpp"
 
 #include <unistd.h>
 #include <glob.h>
@@ -66,9 +70,18 @@ CConfigManager::CConfigManager() : m_inotifyFd(inotify_init()) {
     m_config->addConfigValue("font_size", Hyprlang::INT{11});
     m_config->addConfigValue("small_font_size", Hyprlang::INT{10});
     m_config->addConfigValue("icon_theme", Hyprlang::STRING{""});
+    m_config->addConfigValue("icon_index_cache", Hyprlang::INT{1});
     m_config->addConfigValue("font_family", Hyprlang::STRING{"Sans Serif"});
     m_config->addConfigValue("font_family_monospace", Hyprlang::STRING{"monospace"});
 
+    m_config->addConfigValue("asset_cache_cpu_mb", Hyprlang::INT{64});
+    m_config->addConfigValue("asset_cache_gpu_mb", Hyprlang::INT{128});
+    m_config->addConfigValue("image_disk_cache", Hyprlang::INT{1});
+    m_config->addConfigValue("image_disk_cache_mb", Hyprlang::INT{256});
+    m_config->addConfigValue("decode_threads", Hyprlang::INT{0});
+    m_config->addConfigValue("gpu_memory_limit_mb", Hyprlang::INT{0});
+    m_config->addConfigValue("icon_low_precision_textures", Hyprlang::INT{0});
+
     m_config->registerHandler(&::handleSource, "source", {.allowFlags = false});
 
     m_config->commence();
@@ -91,6 +104,29 @@ void CConfigManager::parse() {
 
     if (ERROR.error)
         g_logger->log(HT_LOG_ERROR, "Error in config: {}", ERROR.getError());
+
+    auto CACHECPU = Hyprlang::CSimpleConfigValue<Hyprlang::INT>(m_config.get(), "asset_cache_cpu_mb");
+    auto CACHEGPU = Hyprlang::CSimpleConfigValue<Hyprlang::INT>(m_config.get(), "asset_cache_gpu_mb");
+    auto DISK     = Hyprlang::CSimpleConfigValue<Hyprlang::INT>(m_config.get(), "image_disk_cache");
+    auto DISKMB   = Hyprlang::CSimpleConfigValue<Hyprlang::INT>(m_config.get(), "image_disk_cache_mb");
+    auto DECODERS = Hyprlang::CSimpleConfigValue<Hyprlang::INT>(m_config.get(), "decode_threads");
+    auto GPULIMIT = Hyprlang::CSimpleConfigValue<Hyprlang::INT>(m_config.get(), "gpu_memory_limit_mb");
+
+    Asset::assetCache()->setBudget(std::max<Hyprlang::INT>(0, *CACHECPU) * 1024 * 1024, std::max<Hyprlang::INT>(0, *CACHEGPU) * 1024 * 1024);
+    textureRegistry()->setLimit(std::max<Hyprlang::INT>(0, *GPULIMIT) * 1024 * 1024);
+
+    const size_t DISKBYTES = std::max<Hyprlang::INT>(0, *DISKMB) * 1024 * 1024;
+
+    if (!*DISK || DISKBYTES == 0)
+        g_imageDiskCache.reset();
+    else if (!g_imageDiskCache)
+        g_imageDiskCache = makeShared<Asset::CImageDiskCache>(Asset::CImageDiskCache::defaultDirectory(), DISKBYTES);
+    else
+        g_imageDiskCache->setMaxBytes(DISKBYTES);
+
+    // the pool is sized once, a reload doesn't restart it
+    if (!g_decodeScheduler)
+        g_decodeScheduler = Asset::CDecodeScheduler::create(std::max<Hyprlang::INT>(0, *DECODERS));
 }
 
 SP<CPalette> CConfigManager::getPalette() {
@@ -9,6 +9,8 @@
 
 #include "../helpers/Memory.hpp"
 
+#include <functional>
+
 #include "Polygon.hpp"
 
 using namespace Hyprutils::Math;
@@ -33,6 +35,14 @@ namespace Hyprtoolkit {
         struct STextureData {
             ASP<Hyprgraphics::IAsyncResource> resource;
             eImageFitMode                     fitMode = IMAGE_FIT_MODE_STRETCH;
+
+            // alternatively to a resource, already decoded cairo ARGB32 pixels. Only need to live until uploadTexture returns.
+            const uint8_t* pixels = nullptr;
+            Vector2D       pixelSize;
+            size_t         stride = 0;
+
+            // may be stored lossy, at half the size. See packPixels.
+            bool lowPrecision = false;
         };
 
         struct STextureRenderData {
@@ -62,19 +72,25 @@ namespace Hyprtoolkit {
             int                         thick = 2;
         };
 
-        virtual void                 beginRendering(SP<IToolkitWindow> window, SP<Aquamarine::IBuffer> buf) = 0;
-        virtual void                 render(bool ignoreSync = false)                                        = 0;
-        virtual void                 endRendering()                                                         = 0;
-        virtual void                 renderRectangle(const SRectangleRenderData& data)                      = 0;
-        virtual SP<IRendererTexture> uploadTexture(const STextureData& data)                                = 0;
-        virtual void                 renderTexture(const STextureRenderData& data)                          = 0;
-        virtual void                 renderBorder(const SBorderRenderData& data)                            = 0;
-        virtual void                 renderPolygon(const SPolygonRenderData& data)                          = 0;
-        virtual void                 renderLine(const SLineRenderData& data)                                = 0;
-        virtual void                 signalRenderPoint(SP<CSyncTimeline> timeline)                          = 0;
+        // previous is what the window's last frame went to, what it scrolled gets copied from there. See IToolkitWindow::damageScroll
+        virtual void                 beginRendering(SP<IToolkitWindow> window, SP<Aquamarine::IBuffer> buf, SP<Aquamarine::IBuffer> previous = nullptr) = 0;
+        virtual void                 render(bool ignoreSync = false)                                                                                    = 0;
+        virtual void                 endRendering()                                                                                                     = 0;
+        virtual void                 renderRectangle(const SRectangleRenderData& data)                                                                  = 0;
+        virtual SP<IRendererTexture> uploadTexture(const STextureData& data)                                                                            = 0;
+        virtual void                 renderTexture(const STextureRenderData& data)                                                                      = 0;
+        virtual void                 renderBorder(const SBorderRenderData& data)                                                                        = 0;
+        virtual void                 renderPolygon(const SPolygonRenderData& data)                                                                      = 0;
+        virtual void                 renderLine(const SLineRenderData& data)                                                                            = 0;
+        virtual void                 signalRenderPoint(SP<CSyncTimeline> timeline)                                                                      = 0;
 
         virtual SP<CSyncTimeline>    exportSync(SP<Aquamarine::IBuffer> buf) = 0;
 
+        // like uploadTexture, but the copy to the gpu happens off the main thread where possible.
+        // done gets the texture on the main thread once it can be drawn, keep drawing the old one until then.
+        // pixels, if used, need to live until done is called.
+        virtual void                 uploadTextureAsync(const STextureData& data, std::function<void(SP<IRendererTexture>)>&& done) = 0;
+
         virtual bool                 explicitSyncSupported() = 0;
     };
 
@@ -20,5 +20,8 @@ namespace Hyprtoolkit {
         virtual void                      destroy() = 0;
         virtual eImageFitMode             fitMode() = 0;
         virtual Hyprutils::Math::Vector2D size()    = 0;
+
+        // of gpu memory the texture's storage takes
+        virtual size_t bytes() = 0;
     };
 }
@@ -0,0 +1,119 @@
+#include "TextureFormat.hpp"
+
+#include <hyprutils/memory/Casts.hpp>
+
+#include <cstdlib>
+
+using namespace Hyprtoolkit;
+using namespace Hyprutils::Memory;
+
+// premultiplying rounds, a channel can be off by this much from what the color says
+constexpr int MASK_TOLERANCE = 1;
+
+size_t Hyprtoolkit::textureFormatBytesPerPixel(eTextureFormat format) {
+    switch (format) {
+        case TEXTURE_FORMAT_RGBA8: return 4;
+        case TEXTURE_FORMAT_MASK8:
+        case TEXTURE_FORMAT_GRAY8: return 1;
+        case TEXTURE_FORMAT_RGB565:
+        case TEXTURE_FORMAT_RGBA4: return 2;
+        case TEXTURE_FORMAT_RGB16F: return 6;
+    }
+
+    return 4;
+}
+
+static uint16_t quantize(uint8_t v, int bits) {
+    const int MAX = (1 << bits) - 1;
+    return sc<uint16_t>((v * MAX + 127) / 255);
+}
+
+SPackedPixels Hyprtoolkit::packPixels(const uint8_t* pixels, const Hyprutils::Math::Vector2D& size, size_t stride, bool lossy) {
+    SPackedPixels packed;
+
+    const size_t  W = sc<size_t>(size.x), H = sc<size_t>(size.y);
+    if (!pixels || W == 0 || H == 0)
+        return packed;
+
+    // the most opaque pixel says what color a mask would be of
+    const uint8_t* ref = pixels;
+    for (size_t y = 0; y < H && ref[3] != 255; ++y) {
+        const uint8_t* row = pixels + (y * stride);
+        for (size_t x = 0; x < W; ++x) {
+            if (row[(x * 4) + 3] > ref[3])
+                ref = row + (x * 4);
+        }
+    }
+
+    bool mask = true, gray = true, opaque = true;
+
+    for (size_t y = 0; y < H && (mask || gray || lossy); ++y) {
+        const uint8_t* row = pixels + (y * stride);
+        for (size_t x = 0; x < W; ++x) {
+            const uint8_t* px = row + (x * 4);
+
+            if (mask && ref[3] != 0) {
+                for (size_t c = 0; c < 3; ++c) {
+                    const int EXPECTED = ((ref[c] * px[3]) + (ref[3] / 2)) / ref[3];
+                    if (std::abs(px[c] - EXPECTED) > MASK_TOLERANCE) {
+                        mask = false;
+                        break;
+                    }
+                }
+            }
+
+            if (px[3] != 255)
+                opaque = false;
+
+            if (gray && (px[3] != 255 || px[0] != px[1] || px[1] != px[2]))
+                gray = false;
+        }
+    }
+
+    const size_t PIXELS = W * H;
+
+    if (mask) {
+        packed.format = TEXTURE_FORMAT_MASK8;
+        packed.color  = ref[3] == 0 ? CHyprColor{1, 1, 1, 1} : CHyprColor{ref[2] / sc<float>(ref[3]), ref[1] / sc<float>(ref[3]), ref[0] / sc<float>(ref[3]), 1.F};
+        packed.data.resize(PIXELS);
+        for (size_t y = 0; y < H; ++y) {
+            const uint8_t* row = pixels + (y * stride);
+            for (size_t x = 0; x < W; ++x) {
+                packed.data[(y * W) + x] = row[(x * 4) + 3];
+            }
+        }
+        return packed;
+    }
+
+    if (gray) {
+        packed.format = TEXTURE_FORMAT_GRAY8;
+        packed.data.resize(PIXELS);
+        for (size_t y = 0; y < H; ++y) {
+            const uint8_t* row = pixels + (y * stride);
+            for (size_t x = 0; x < W; ++x) {
+                packed.data[(y * W) + x] = row[x * 4];
+            }
+        }
+        return packed;
+    }
+
+    if (!lossy)
+        return packed;
+
+    // 16 bit texels, in the order GL_UNSIGNED_SHORT_5_6_5 and GL_UNSIGNED_SHORT_4_4_4_4 read them
+    packed.format = opaque ? TEXTURE_FORMAT_RGB565 : TEXTURE_FORMAT_RGBA4;
+    packed.data.resize(PIXELS * 2);
+    auto* out = rc<uint16_t*>(packed.data.data());
+    for (size_t y = 0; y < H; ++y) {
+        const uint8_t* row = pixels + (y * stride);
+        for (size_t x = 0; x < W; ++x) {
+            const uint8_t* px = row + (x * 4);
+            if (opaque)
+                out[(y * W) + x] = (quantize(px[2], 5) << 11) | (quantize(px[1], 6) << 5) | quantize(px[0], 5);
+            else
+                out[(y * W) + x] = (quantize(px[2], 4) << 12) | (quantize(px[1], 4) << 8) | (quantize(px[0], 4) << 4) | quantize(px[3], 4);
+        }
+    }
+
+    return packed;
+}
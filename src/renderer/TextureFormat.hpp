@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <hyprutils/math/Vector2D.hpp>
+#include <hyprtoolkit/palette/Color.hpp>
+
+namespace Hyprtoolkit {
+
+    // What a texture's pixels are kept as on the gpu.
+    enum eTextureFormat : uint8_t {
+        TEXTURE_FORMAT_RGBA8 = 0, // as decoded
+        TEXTURE_FORMAT_MASK8,     // one color, only the coverage is stored and the color is applied when drawing, e.g. text
+        TEXTURE_FORMAT_GRAY8,     // opaque and gray
+        TEXTURE_FORMAT_RGB565,    // opaque, lossy
+        TEXTURE_FORMAT_RGBA4,     // lossy
+        TEXTURE_FORMAT_RGB16F,    // hdr
+    };
+
+    size_t textureFormatBytesPerPixel(eTextureFormat format);
+
+    struct SPackedPixels {
+        eTextureFormat       format = TEXTURE_FORMAT_RGBA8;
+
+        // tightly packed rows. Empty for RGBA8, the source pixels are used as they are.
+        std::vector<uint8_t> data;
+
+        // for MASK8, the color the coverage is of
+        CHyprColor           color;
+    };
+
+    // Picks the smallest format that holds cairo ARGB32 (premultiplied, BGRA in memory) pixels as they are.
+    // With lossy, opaque pixels go to RGB565 and others to RGBA4 if they can't go smaller without loss.
+    SPackedPixels packPixels(const uint8_t* pixels, const Hyprutils::Math::Vector2D& size, size_t stride, bool lossy = false);
+};
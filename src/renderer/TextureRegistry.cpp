@@ -0,0 +1,122 @@
+#include "TextureRegistry.hpp"
+
+#include "gl/OpenGL.hpp"
+#include "../core/InternalBackend.hpp"
+#include "../core/Logger.hpp"
+#include "../resource/assetCache/AssetCache.hpp"
+
+using namespace Hyprtoolkit;
+
+SP<CTextureRegistry> Hyprtoolkit::textureRegistry() {
+    static auto registry = makeShared<CTextureRegistry>();
+    return registry;
+}
+
+void CTextureRegistry::set(const void* texture, size_t bytes) {
+    std::lock_guard<std::mutex> lg(m_mutex);
+
+    auto&                       tex = m_textures[texture];
+    m_bytes -= tex.bytes;
+    m_bytes += bytes;
+
+    const bool GREW = bytes > tex.bytes;
+    tex.bytes       = bytes;
+
+    if (GREW)
+        checkLimit();
+}
+
+void CTextureRegistry::remove(const void* texture) {
+    std::lock_guard<std::mutex> lg(m_mutex);
+
+    const auto                  IT = m_textures.find(texture);
+    if (IT == m_textures.end())
+        return;
+
+    m_bytes -= IT->second.bytes;
+    m_textures.erase(IT);
+}
+
+void CTextureRegistry::setOwner(const void* texture, const void* owner) {
+    std::lock_guard<std::mutex> lg(m_mutex);
+
+    if (const auto IT = m_textures.find(texture); IT != m_textures.end())
+        IT->second.owner = owner;
+}
+
+void CTextureRegistry::forgetOwner(const void* owner) {
+    std::lock_guard<std::mutex> lg(m_mutex);
+
+    for (auto& [ptr, tex] : m_textures) {
+        if (tex.owner == owner)
+            tex.owner = nullptr;
+    }
+}
+
+void CTextureRegistry::setPooledBytes(size_t bytes) {
+    std::lock_guard<std::mutex> lg(m_mutex);
+    m_pooledBytes = bytes;
+}
+
+size_t CTextureRegistry::bytesFor(const void* owner) {
+    std::lock_guard<std::mutex> lg(m_mutex);
+
+    size_t                      bytes = 0;
+    for (const auto& [ptr, tex] : m_textures) {
+        if (tex.owner == owner)
+            bytes += tex.bytes;
+    }
+
+    return bytes;
+}
+
+STextureMemoryStats CTextureRegistry::stats() {
+    std::lock_guard<std::mutex> lg(m_mutex);
+
+    return STextureMemoryStats{
+        .textures    = m_textures.size(),
+        .bytes       = m_bytes + m_pooledBytes,
+        .pooledBytes = m_pooledBytes,
+        .limit       = m_limit,
+    };
+}
+
+void CTextureRegistry::setLimit(size_t bytes) {
+    std::lock_guard<std::mutex> lg(m_mutex);
+
+    m_limit = bytes;
+    checkLimit();
+}
+
+void CTextureRegistry::checkLimit() {
+    if (m_limit == 0 || m_bytes + m_pooledBytes <= m_limit || m_trimQueued || !g_backend)
+        return;
+
+    m_trimQueued = true;
+    g_backend->addIdle([] { textureRegistry()->trimToLimit(); });
+}
+
+void CTextureRegistry::trimToLimit() {
+    const auto OVER = [this] {
+        std::lock_guard<std::mutex> lg(m_mutex);
+        return m_limit == 0 || m_bytes + m_pooledBytes <= m_limit ? 0 : m_bytes + m_pooledBytes - m_limit;
+    };
+
+    // nothing draws what's pooled
+    if (OVER() > 0 && g_openGL)
+        g_openGL->dropTexturePool();
+
+    // then what the asset cache only keeps in case it's needed again
+    if (const auto BYTES = OVER(); BYTES > 0) {
+        const auto CACHE = Asset::assetCache();
+        const auto STATS = CACHE->stats();
+        CACHE->trim(STATS.cpuBytes, STATS.gpuBytes > BYTES ? STATS.gpuBytes - BYTES : 0);
+    }
+
+    if (const auto BYTES = OVER(); BYTES > 0)
+        g_logger->log(HT_LOG_DEBUG, "textureRegistry: {} B over the limit, the rest is in use", BYTES);
+
+    // only now, letting go above doesn't need another round
+    std::lock_guard<std::mutex> lg(m_mutex);
+    m_trimQueued = false;
+}
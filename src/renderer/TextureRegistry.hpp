@@ -0,0 +1,64 @@
+#pragma once
+
+#include <mutex>
+#include <unordered_map>
+
+#include "../helpers/Memory.hpp"
+
+namespace Hyprtoolkit {
+
+    struct STextureMemoryStats {
+        size_t textures = 0, bytes = 0;
+
+        // of bytes, storage kept for reuse, see CGLTextureUploader
+        size_t pooledBytes = 0;
+
+        // 0 for none
+        size_t limit = 0;
+    };
+
+    // Every texture's gpu storage, by texture and by the window that last drew it.
+    // Textures may report from any thread. Over the limit, what the caches hold but nothing draws is let go,
+    // on the main thread.
+    class CTextureRegistry {
+      public:
+        CTextureRegistry()  = default;
+        ~CTextureRegistry() = default;
+
+        CTextureRegistry(const CTextureRegistry&) = delete;
+        CTextureRegistry(CTextureRegistry&)       = delete;
+        CTextureRegistry(CTextureRegistry&&)      = delete;
+
+        void                set(const void* texture, size_t bytes);
+        void                remove(const void* texture);
+
+        // owner is the window that drew it
+        void                setOwner(const void* texture, const void* owner);
+        void                forgetOwner(const void* owner);
+
+        void                setPooledBytes(size_t bytes);
+
+        size_t              bytesFor(const void* owner);
+        STextureMemoryStats stats();
+
+        void                setLimit(size_t bytes);
+
+        // lets go of unused textures until under the limit, if possible. Main thread only.
+        void                trimToLimit();
+
+      private:
+        struct STexture {
+            size_t      bytes = 0;
+            const void* owner = nullptr;
+        };
+
+        void                                      checkLimit();
+
+        std::mutex                                m_mutex;
+        std::unordered_map<const void*, STexture> m_textures;
+        size_t                                    m_bytes = 0, m_pooledBytes = 0, m_limit = 0;
+        bool                                      m_trimQueued = false;
+    };
+
+    SP<CTextureRegistry> textureRegistry();
+};
@@ -1,6 +1,7 @@
 #include "Framebuffer.hpp"
 #include "OpenGL.hpp"
 #include "GLTexture.hpp"
+#include "../TextureRegistry.hpp"
 #include "../../core/InternalBackend.hpp"
 #include "GL.hpp"
 
@@ -47,6 +48,7 @@ bool CFramebuffer::alloc(int w, int h, uint32_t drmFormat) {
     if (firstAlloc || m_size != Vector2D(w, h)) {
         m_tex->bind();
         glTexImage2D(GL_TEXTURE_2D, 0, glFormat, w, h, 0, GL_RGBA, glType, nullptr);
+        textureRegistry()->set(m_tex.get(), sc<size_t>(w) * sc<size_t>(h) * 4);
         glBindFramebuffer(GL_FRAMEBUFFER, m_fb);
         glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_tex->m_texID, 0);
 
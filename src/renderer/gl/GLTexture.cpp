@@ -1,11 +1,22 @@
 #include "GLTexture.hpp"
 #include "OpenGL.hpp"
+#include "TextureUploader.hpp"
 
+#include "../TextureRegistry.hpp"
 #include "../../core/InternalBackend.hpp"
 
+#include <hyprutils/memory/Casts.hpp>
+
 using namespace Hyprtoolkit;
+using namespace Hyprutils::Memory;
+
+// where sampling takes each channel from
+constexpr std::array<GLint, 4> SWIZZLE_RGBA = {GL_RED, GL_GREEN, GL_BLUE, GL_ALPHA};
+constexpr std::array<GLint, 4> SWIZZLE_BGRA = {GL_BLUE, GL_GREEN, GL_RED, GL_ALPHA};
+constexpr std::array<GLint, 4> SWIZZLE_MASK = {GL_RED, GL_RED, GL_RED, GL_RED};
+constexpr std::array<GLint, 4> SWIZZLE_GRAY = {GL_RED, GL_RED, GL_RED, GL_ONE};
 
-CGLTexture::CGLTexture(ASP<Hyprgraphics::IAsyncResource> resource) {
+CGLTexture::CGLTexture(ASP<Hyprgraphics::IAsyncResource> resource, bool lowPrecision) : m_lowPrecision(lowPrecision) {
     if (resource->m_ready) {
         m_resource = resource;
         upload();
@@ -22,6 +33,10 @@ CGLTexture::CGLTexture(ASP<Hyprgraphics::IAsyncResource> resource) {
     });
 }
 
+CGLTexture::CGLTexture(const uint8_t* pixels, const Hyprutils::Math::Vector2D& size, size_t stride, bool lowPrecision) : m_size(size), m_lowPrecision(lowPrecision) {
+    uploadPixels(pixels, stride);
+}
+
 CGLTexture::CGLTexture() {
     ;
 }
@@ -33,9 +48,6 @@ CGLTexture::~CGLTexture() {
 void CGLTexture::upload() {
     const cairo_status_t SURFACESTATUS = (cairo_status_t)m_resource->m_asset.cairoSurface->status();
     const auto           CAIROFORMAT   = cairo_image_surface_get_format(m_resource->m_asset.cairoSurface->cairo());
-    const GLint          glIFormat     = CAIROFORMAT == CAIRO_FORMAT_RGB96F ? GL_RGB32F : GL_RGBA;
-    const GLint          glFormat      = CAIROFORMAT == CAIRO_FORMAT_RGB96F ? GL_RGB : GL_RGBA;
-    const GLint          glType        = CAIROFORMAT == CAIRO_FORMAT_RGB96F ? GL_FLOAT : GL_UNSIGNED_BYTE;
 
     allocate();
 
@@ -48,16 +60,63 @@ void CGLTexture::upload() {
     m_type = TEXTURE_RGBA;
     m_size = m_resource->m_asset.pixelSize;
 
+    if (CAIROFORMAT == CAIRO_FORMAT_RGB96F) {
+        // half floats are plenty to draw from, at half the size
+        m_format = TEXTURE_FORMAT_RGB16F;
+        write(m_resource->m_asset.cairoSurface->data(), GL_RGB16F, GL_RGB, GL_FLOAT, SWIZZLE_RGBA);
+    } else
+        uploadPixels(m_resource->m_asset.cairoSurface->data(), cairo_image_surface_get_stride(m_resource->m_asset.cairoSurface->cairo()));
+
+    m_resource.reset();
+}
+
+void CGLTexture::uploadPixels(const uint8_t* pixels, size_t stride) {
+    allocate();
+
+    m_type = TEXTURE_RGBA;
+
+    const auto PACKED = packPixels(pixels, m_size, stride, m_lowPrecision);
+    m_format          = PACKED.format;
+    m_tint            = PACKED.color;
+
+    // packed rows are tight, and as narrow as a byte
+    switch (PACKED.format) {
+        case TEXTURE_FORMAT_MASK8: write(PACKED.data.data(), GL_R8, GL_RED, GL_UNSIGNED_BYTE, SWIZZLE_MASK, 0, 1); break;
+        case TEXTURE_FORMAT_GRAY8: write(PACKED.data.data(), GL_R8, GL_RED, GL_UNSIGNED_BYTE, SWIZZLE_GRAY, 0, 1); break;
+        case TEXTURE_FORMAT_RGB565: write(PACKED.data.data(), GL_RGB565, GL_RGB, GL_UNSIGNED_SHORT_5_6_5, SWIZZLE_RGBA, 0, 2); break;
+        case TEXTURE_FORMAT_RGBA4: write(PACKED.data.data(), GL_RGBA4, GL_RGBA, GL_UNSIGNED_SHORT_4_4_4_4, SWIZZLE_RGBA, 0, 2); break;
+        default: write(pixels, GL_RGBA, GL_RGBA, GL_UNSIGNED_BYTE, SWIZZLE_BGRA, stride / 4); break;
+    }
+}
+
+void CGLTexture::write(const void* pixels, GLint internalFormat, GLenum format, GLenum type, const std::array<GLint, 4>& swizzle, size_t rowLength, GLint alignment) {
     GLCALL(glBindTexture(GL_TEXTURE_2D, m_texID));
     GLCALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR));
     GLCALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR));
-    if (CAIROFORMAT != CAIRO_FORMAT_RGB96F) {
-        GLCALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_R, GL_BLUE));
-        GLCALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_B, GL_RED));
+    GLCALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_R, swizzle[0]));
+    GLCALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_G, swizzle[1]));
+    GLCALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_B, swizzle[2]));
+    GLCALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_A, swizzle[3]));
+
+    if (rowLength)
+        GLCALL(glPixelStorei(GL_UNPACK_ROW_LENGTH, rowLength));
+    if (alignment != 4)
+        GLCALL(glPixelStorei(GL_UNPACK_ALIGNMENT, alignment));
+
+    if (m_storageSize == m_size && m_storageFormat == internalFormat) {
+        GLCALL(glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, m_size.x, m_size.y, format, type, pixels));
+    } else {
+        GLCALL(glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, m_size.x, m_size.y, 0, format, type, pixels));
+        m_storageSize   = m_size;
+        m_storageFormat = internalFormat;
     }
-    GLCALL(glTexImage2D(GL_TEXTURE_2D, 0, glIFormat, m_size.x, m_size.y, 0, glFormat, glType, m_resource->m_asset.cairoSurface->data()));
 
-    m_resource.reset();
+    if (rowLength)
+        GLCALL(glPixelStorei(GL_UNPACK_ROW_LENGTH, 0));
+    if (alignment != 4)
+        GLCALL(glPixelStorei(GL_UNPACK_ALIGNMENT, 4));
+
+    textureRegistry()->set(this, bytes());
 }
 
 size_t CGLTexture::id() {
@@ -73,10 +132,18 @@ void CGLTexture::destroy() {
         g_openGL->makeEGLCurrent();
 
     if (m_allocated) {
-        GLCALL(glDeleteTextures(1, &m_texID));
+        // an uploaded texture's storage can take the next upload of the same size
+        if (g_openGL && g_openGL->m_uploader && m_storageSize != Vector2D{})
+            g_openGL->m_uploader->recycle(m_texID, m_storageSize, m_storageFormat);
+        else
+            GLCALL(glDeleteTextures(1, &m_texID));
         m_texID = 0;
     }
-    m_allocated = false;
+    m_allocated     = false;
+    m_storageSize   = {};
+    m_storageFormat = 0;
+
+    textureRegistry()->remove(this);
 }
 
 void CGLTexture::allocate() {
@@ -96,3 +163,7 @@ eImageFitMode CGLTexture::fitMode() {
 Vector2D CGLTexture::size() {
     return m_size;
 }
+
+size_t CGLTexture::bytes() {
+    return sc<size_t>(m_storageSize.x) * sc<size_t>(m_storageSize.y) * textureFormatBytesPerPixel(m_format);
+}
@@ -5,9 +5,11 @@
 
 #include "GL.hpp"
 
+#include <array>
 #include <cstdint>
 
 #include "../RendererTexture.hpp"
+#include "../TextureFormat.hpp"
 #include "../../helpers/Memory.hpp"
 
 namespace Hyprtoolkit {
@@ -22,7 +24,8 @@ namespace Hyprtoolkit {
 
     class CGLTexture : public IRendererTexture {
       public:
-        CGLTexture(ASP<Hyprgraphics::IAsyncResource>);
+        CGLTexture(ASP<Hyprgraphics::IAsyncResource>, bool lowPrecision = false);
+        CGLTexture(const uint8_t* pixels, const Hyprutils::Math::Vector2D& size, size_t stride, bool lowPrecision = false);
         CGLTexture();
         virtual ~CGLTexture();
 
@@ -31,6 +34,7 @@ namespace Hyprtoolkit {
         virtual void                      destroy();
         virtual eImageFitMode             fitMode();
         virtual Hyprutils::Math::Vector2D size();
+        virtual size_t                    bytes();
 
         eGLTextureType                    m_type      = TEXTURE_RGBA;
         GLenum                            m_target    = GL_TEXTURE_2D;
@@ -41,8 +45,24 @@ namespace Hyprtoolkit {
 
         ASP<Hyprgraphics::IAsyncResource> m_resource;
 
+        // what was last given to glTexImage2D, so that pixels of the same size go into it with glTexSubImage2D
+        Hyprutils::Math::Vector2D         m_storageSize;
+        GLint                             m_storageFormat = 0;
+
+        // what the pixels were packed into, see packPixels. MASK8 is drawn in m_tint.
+        eTextureFormat                    m_format = TEXTURE_FORMAT_RGBA8;
+        CHyprColor                        m_tint;
+        bool                              m_lowPrecision = false;
+
+        // the window that last drew it, what its bytes are attributed to in the texture registry
+        const void*                       m_lastOwner = nullptr;
+
         void                              upload();
+        void                              uploadPixels(const uint8_t* pixels, size_t stride);
         void                              allocate();
         void                              bind();
+
+      private:
+        void write(const void* pixels, GLint internalFormat, GLenum format, GLenum type, const std::array<GLint, 4>& swizzle, size_t rowLength = 0, GLint alignment = 4);
     };
 };
\ No newline at end of file
@@ -5,10 +5,12 @@
 #include "../../core/InternalBackend.hpp"
 #include "../../element/Element.hpp"
 #include "../sync/SyncTimeline.hpp"
+#include "../TextureRegistry.hpp"
 #include "./shaders/Shaders.hpp"
 #include "GLTexture.hpp"
 #include "Renderbuffer.hpp"
 #include "Sync.hpp"
+#include "TextureUploader.hpp"
 
 #include <cmath>
 #include <hyprutils/memory/Casts.hpp>
@@ -204,6 +206,11 @@ void COpenGLRenderer::initEGL(bool gbm) {
     attrs.push_back(0);
     attrs.push_back(EGL_NONE);
 
+    // uploads don't need to preempt anything
+    m_sharedContextAttrs = attrs;
+    if (m_exts.IMG_context_priority)
+        m_sharedContextAttrs.erase(m_sharedContextAttrs.begin(), m_sharedContextAttrs.begin() + 2);
+
     m_eglContext = eglCreateContext(m_eglDisplay, EGL_NO_CONFIG_KHR, EGL_NO_CONTEXT, attrs.data());
     if (m_eglContext == EGL_NO_CONTEXT) {
         RASSERT(false, "EGL: failed to create a context");
@@ -518,10 +525,17 @@ COpenGLRenderer::COpenGLRenderer(int drmFD) : m_drmFD(drmFD) {
 
     m_polyRenderFb = makeShared<CFramebuffer>();
 
+    m_uploader = makeUnique<CGLTextureUploader>(m_eglDisplay, m_eglContext, m_sharedContextAttrs);
+
     RASSERT(eglMakeCurrent(m_eglDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT), "Couldn't unset current EGL!");
 }
 
 COpenGLRenderer::~COpenGLRenderer() {
+    if (m_uploader) {
+        makeEGLCurrent();
+        m_uploader.reset();
+    }
+
     if (m_eglDisplay && m_eglContext != EGL_NO_CONTEXT)
         eglDestroyContext(m_eglDisplay, m_eglContext);
 
@@ -572,7 +586,7 @@ void COpenGLRenderer::waitOnSync() {
     timeline->check(timeline->m_releasePoint, DRM_SYNCOBJ_WAIT_FLAGS_WAIT_FOR_SUBMIT);
 }
 
-void COpenGLRenderer::beginRendering(SP<IToolkitWindow> window, SP<Aquamarine::IBuffer> buf) {
+void COpenGLRenderer::beginRendering(SP<IToolkitWindow> window, SP<Aquamarine::IBuffer> buf, SP<Aquamarine::IBuffer> previous) {
     RASSERT(buf, "GL: null buffer passed to rendering");
 
     makeEGLCurrent();
@@ -586,6 +600,7 @@ void COpenGLRenderer::beginRendering(SP<IToolkitWindow> window, SP<Aquamarine::I
     m_scale           = window->scale();
     m_window          = window;
     m_damage          = window->m_damageRing.getBufferDamage(DAMAGE_RING_PREVIOUS_LEN);
+    m_previousRBO     = previous && !window->m_scrollCopies.empty() ? getRBO(previous) : nullptr;
 }
 
 void COpenGLRenderer::render(bool ignoreSync) {
@@ -597,6 +612,8 @@ void COpenGLRenderer::render(bool ignoreSync) {
 
     glViewport(0, 0, m_window->pixelSize().x, m_window->pixelSize().y);
 
+    copyScrolled();
+
     m_damage.forEachRect([this](const auto& RECT) {
         scissor(&RECT);
         glClearColor(0.0, 0.0, 0.0, 0.0);
@@ -626,6 +643,18 @@ void COpenGLRenderer::renderBreadthfirst(SP<IElement> e) {
         if (std::ranges::find(m_alreadyRendered, el) != m_alreadyRendered.end())
             return;
 
+        // transformed: everything in it is drawn with it, like clipping below
+        const bool TRANSFORMED = el->impl->transformed();
+        if (TRANSFORMED) {
+            m_transforms.emplace_back(el->impl->ownTransform().then(currentTransform()));
+
+            if (m_transforms.back().opacity <= 0.F) {
+                el->impl->breadthfirst([this](SP<IElement> e) { m_alreadyRendered.emplace_back(e); });
+                m_transforms.pop_back();
+                return;
+            }
+        }
+
         el->paint();
 
         m_alreadyRendered.emplace_back(el);
@@ -652,7 +681,7 @@ void COpenGLRenderer::renderBreadthfirst(SP<IElement> e) {
 
         if (el->impl->clipChildren) {
             // clip children: push a clip box and render all children now, then pop box
-            m_clipBoxes.emplace_back(logicalToGL(el->impl->position, false));
+            m_clipBoxes.emplace_back(logicalToGL(currentTransform().bounds(el->impl->position), false));
 
             renderBreadthfirst(el);
 
@@ -663,17 +692,45 @@ void COpenGLRenderer::renderBreadthfirst(SP<IElement> e) {
             // grouped: render all children as one
             renderBreadthfirst(el);
         }
+
+        if (TRANSFORMED) {
+            renderBreadthfirst(el);
+            m_transforms.pop_back();
+        }
     });
 }
 
+void COpenGLRenderer::copyScrolled() {
+    if (!m_previousRBO || m_window->m_scrollCopies.empty())
+        return;
+
+    // last frame's pixels, where they are now. The damage covers what came into view
+    scissor(nullptr);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, m_previousRBO->getFB()->getFBID());
+
+    for (const auto& c : m_window->m_scrollCopies) {
+        const auto TO = c.copyTo(m_scale);
+        if (TO.empty())
+            continue;
+
+        const auto FROM = c.copyFrom(m_scale);
+
+        glBlitFramebuffer(FROM.x, FROM.y, FROM.x + FROM.w, FROM.y + FROM.h, TO.x, TO.y, TO.x + TO.w, TO.y + TO.h, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+    }
+
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+}
+
 void COpenGLRenderer::endRendering() {
     m_currentRBO->unbind();
     m_currentRBO.reset();
+    m_previousRBO.reset();
 
     // FIXME: explicit sync for nvidia!!!!
     glFlush();
 
     m_window->m_damageRing.rotate();
+    m_window->m_scrollCopies.clear();
     m_window.reset();
     m_damage.clear();
 }
@@ -709,6 +766,19 @@ void COpenGLRenderer::scissor(const CBox& box) {
     glEnable(GL_SCISSOR_TEST);
 }
 
+const SRenderTransform& COpenGLRenderer::currentTransform() {
+    static const SRenderTransform IDENTITY;
+    return m_transforms.empty() ? IDENTITY : m_transforms.back();
+}
+
+float COpenGLRenderer::radiusFor(const CBox& drawn, int rounding) {
+    // the shaders round on screen, axis aligned, rotated it'd cut the wrong corners
+    if (drawn.rot != 0)
+        return 0.F;
+
+    return rounding * currentTransform().scale * m_scale;
+}
+
 CRegion COpenGLRenderer::damageWithClip() {
     auto dmg = m_damage.copy();
 
@@ -720,14 +790,16 @@ CRegion COpenGLRenderer::damageWithClip() {
 }
 
 void COpenGLRenderer::renderRectangle(const SRectangleRenderData& data) {
-    const auto ROUNDEDBOX    = logicalToGL(data.box);
-    const auto UNTRANSFORMED = logicalToGL(data.box, false);
-    Mat3x3     matrix        = m_projMatrix.projectBox(ROUNDEDBOX, HYPRUTILS_TRANSFORM_FLIPPED_180, data.box.rot);
-    Mat3x3     glMatrix      = m_projection.copy().multiply(matrix);
+    const auto& TRANSFORM     = currentTransform();
+    const auto  BOX           = TRANSFORM.apply(data.box);
+    const auto  ROUNDEDBOX    = logicalToGL(BOX);
+    const auto  UNTRANSFORMED = logicalToGL(BOX, false);
+    Mat3x3      matrix        = m_projMatrix.projectBox(ROUNDEDBOX, HYPRUTILS_TRANSFORM_FLIPPED_180, BOX.rot);
+    Mat3x3      glMatrix      = m_projection.copy().multiply(matrix);
 
-    const auto DAMAGE = damageWithClip();
+    const auto  DAMAGE = damageWithClip();
 
-    if (DAMAGE.copy().intersect(UNTRANSFORMED).empty())
+    if (DAMAGE.copy().intersect(logicalToGL(TRANSFORM.bounds(data.box), false)).empty())
         return;
 
     glUseProgram(m_rectShader.program);
@@ -735,8 +807,9 @@ void COpenGLRenderer::renderRectangle(const SRectangleRenderData& data) {
     glUniformMatrix3fv(m_rectShader.proj, 1, GL_TRUE, glMatrix.getMatrix().data());
 
     // premultiply the color as well as we don't work with straight alpha
-    const auto COL = data.color;
-    glUniform4f(m_rectShader.color, COL.r * COL.a, COL.g * COL.a, COL.b * COL.a, COL.a);
+    const auto COL   = data.color;
+    const auto ALPHA = COL.a * TRANSFORM.opacity;
+    glUniform4f(m_rectShader.color, COL.r * ALPHA, COL.g * ALPHA, COL.b * ALPHA, ALPHA);
 
     const auto TOPLEFT  = Vector2D(UNTRANSFORMED.x, UNTRANSFORMED.y);
     const auto FULLSIZE = Vector2D(UNTRANSFORMED.width, UNTRANSFORMED.height);
@@ -744,7 +817,7 @@ void COpenGLRenderer::renderRectangle(const SRectangleRenderData& data) {
     // Rounded corners
     glUniform2f(m_rectShader.topLeft, (float)TOPLEFT.x, (float)TOPLEFT.y);
     glUniform2f(m_rectShader.fullSize, (float)FULLSIZE.x, (float)FULLSIZE.y);
-    glUniform1f(m_rectShader.radius, data.rounding * m_scale);
+    glUniform1f(m_rectShader.radius, radiusFor(BOX, data.rounding));
     glUniform1f(m_rectShader.roundingPower, 2);
 
     glVertexAttribPointer(m_rectShader.posAttrib, 2, GL_FLOAT, GL_FALSE, 0, fullVerts);
@@ -760,11 +833,30 @@ void COpenGLRenderer::renderRectangle(const SRectangleRenderData& data) {
 }
 
 SP<IRendererTexture> COpenGLRenderer::uploadTexture(const STextureData& data) {
-    const auto TEX = makeShared<CGLTexture>(data.resource);
+    const auto TEX = data.pixels ? makeShared<CGLTexture>(data.pixels, data.pixelSize, data.stride, data.lowPrecision) : makeShared<CGLTexture>(data.resource, data.lowPrecision);
     TEX->m_fitMode = data.fitMode;
     return TEX;
 }
 
+void COpenGLRenderer::uploadTextureAsync(const STextureData& data, std::function<void(SP<IRendererTexture>)>&& done) {
+    // a resource that isn't there yet is uploaded once it is by the texture itself
+    if (!m_uploader || (!data.pixels && !data.resource->m_ready)) {
+        done(uploadTexture(data));
+        return;
+    }
+
+    makeEGLCurrent();
+    m_uploader->upload(data.resource, data.pixels, data.pixelSize, data.stride, data.fitMode, data.lowPrecision, std::move(done));
+}
+
+void COpenGLRenderer::dropTexturePool() {
+    if (!m_uploader)
+        return;
+
+    makeEGLCurrent();
+    m_uploader->clearRecycled();
+}
+
 static CBox containImage(const CBox& requested, const Vector2D& imageSize) {
     const auto SOURCE_ASPECT_RATIO = requested.w / requested.h;
     const auto IMAGE_ASPECT_RATIO  = imageSize.x / imageSize.y;
@@ -862,15 +954,17 @@ void COpenGLRenderer::renderTexture(const STextureRenderData& data) {
 
     SP<CGLTexture> tex = reinterpretPointerCast<CGLTexture>(data.texture);
 
+    const auto&    TRANSFORM     = currentTransform();
     const auto     SOURCE_BOX    = data.texture->fitMode() == IMAGE_FIT_MODE_CONTAIN ? containImage(data.box, tex->m_size) : data.box;
-    const auto     ROUNDEDBOX    = logicalToGL(SOURCE_BOX);
-    const auto     UNTRANSFORMED = logicalToGL(SOURCE_BOX, false);
-    Mat3x3         matrix        = m_projMatrix.projectBox(ROUNDEDBOX, Hyprutils::Math::HYPRUTILS_TRANSFORM_FLIPPED_180, data.box.rot);
+    const auto     BOX           = TRANSFORM.apply(SOURCE_BOX);
+    const auto     ROUNDEDBOX    = logicalToGL(BOX);
+    const auto     UNTRANSFORMED = logicalToGL(BOX, false);
+    Mat3x3         matrix        = m_projMatrix.projectBox(ROUNDEDBOX, Hyprutils::Math::HYPRUTILS_TRANSFORM_FLIPPED_180, BOX.rot);
     Mat3x3         glMatrix      = m_projection.copy().multiply(matrix);
 
     const auto     DAMAGE = damageWithClip();
 
-    if (DAMAGE.copy().intersect(UNTRANSFORMED).empty())
+    if (DAMAGE.copy().intersect(logicalToGL(TRANSFORM.bounds(SOURCE_BOX), false)).empty())
         return;
 
     CShader* shader = &m_texShader;
@@ -882,19 +976,30 @@ void COpenGLRenderer::renderTexture(const STextureRenderData& data) {
 
     glUniformMatrix3fv(shader->proj, 1, GL_TRUE, glMatrix.getMatrix().data());
     glUniform1i(shader->tex, 0);
-    glUniform1f(shader->alpha, data.a);
+    glUniform1f(shader->alpha, data.a * TRANSFORM.opacity);
     const auto TOPLEFT  = Vector2D(UNTRANSFORMED.x, UNTRANSFORMED.y);
     const auto FULLSIZE = Vector2D(UNTRANSFORMED.width, UNTRANSFORMED.height);
 
     // Rounded corners
     glUniform2f(shader->topLeft, TOPLEFT.x, TOPLEFT.y);
     glUniform2f(shader->fullSize, FULLSIZE.x, FULLSIZE.y);
-    glUniform1f(shader->radius, data.rounding * m_scale);
+    glUniform1f(shader->radius, radiusFor(BOX, data.rounding));
     glUniform1f(shader->roundingPower, 2);
 
     glUniform1i(shader->discardOpaque, 0);
     glUniform1i(shader->discardAlpha, 0);
-    glUniform1i(shader->applyTint, 0);
+
+    // a mask only has coverage, the color is put back here
+    if (tex->m_format == TEXTURE_FORMAT_MASK8) {
+        glUniform1i(shader->applyTint, 1);
+        glUniform3f(shader->tint, tex->m_tint.r, tex->m_tint.g, tex->m_tint.b);
+    } else
+        glUniform1i(shader->applyTint, 0);
+
+    if (tex->m_lastOwner != m_window.get()) {
+        tex->m_lastOwner = m_window.get();
+        textureRegistry()->setOwner(tex.get(), m_window.get());
+    }
 
     if (data.texture->fitMode() == IMAGE_FIT_MODE_STRETCH || data.texture->fitMode() == IMAGE_FIT_MODE_CONTAIN) {
         glVertexAttribPointer(shader->posAttrib, 2, GL_FLOAT, GL_FALSE, 0, fullVerts);
@@ -926,14 +1031,16 @@ void COpenGLRenderer::renderTexture(const STextureRenderData& data) {
 }
 
 void COpenGLRenderer::renderBorder(const SBorderRenderData& data) {
-    const auto ROUNDEDBOX    = logicalToGL(data.box);
-    const auto UNTRANSFORMED = logicalToGL(data.box, false);
-    Mat3x3     matrix        = m_projMatrix.projectBox(ROUNDEDBOX, HYPRUTILS_TRANSFORM_FLIPPED_180, data.box.rot);
-    Mat3x3     glMatrix      = m_projection.copy().multiply(matrix);
+    const auto& TRANSFORM     = currentTransform();
+    const auto  BOX           = TRANSFORM.apply(data.box);
+    const auto  ROUNDEDBOX    = logicalToGL(BOX);
+    const auto  UNTRANSFORMED = logicalToGL(BOX, false);
+    Mat3x3      matrix        = m_projMatrix.projectBox(ROUNDEDBOX, HYPRUTILS_TRANSFORM_FLIPPED_180, BOX.rot);
+    Mat3x3      glMatrix      = m_projection.copy().multiply(matrix);
 
-    const auto DAMAGE = damageWithClip();
+    const auto  DAMAGE = damageWithClip();
 
-    if (DAMAGE.copy().intersect(UNTRANSFORMED).empty())
+    if (DAMAGE.copy().intersect(logicalToGL(TRANSFORM.bounds(data.box), false)).empty())
         return;
 
     glUseProgram(m_borderShader.program);
@@ -946,7 +1053,7 @@ void COpenGLRenderer::renderBorder(const SBorderRenderData& data) {
     glUniform4fv(m_borderShader.gradient, grad.size() / 4, (float*)grad.data());
     glUniform1i(m_borderShader.gradientLength, grad.size() / 4);
     glUniform1f(m_borderShader.angle, (int)(0.F / (M_PI / 180.0)) % 360 * (M_PI / 180.0));
-    glUniform1f(m_borderShader.alpha, 1.F);
+    glUniform1f(m_borderShader.alpha, TRANSFORM.opacity);
     glUniform1i(m_borderShader.gradient2Length, 0);
 
     const auto TOPLEFT  = Vector2D(UNTRANSFORMED.x, UNTRANSFORMED.y);
@@ -955,10 +1062,10 @@ void COpenGLRenderer::renderBorder(const SBorderRenderData& data) {
     glUniform2f(m_borderShader.topLeft, (float)TOPLEFT.x, (float)TOPLEFT.y);
     glUniform2f(m_borderShader.fullSize, (float)FULLSIZE.x, (float)FULLSIZE.y);
     glUniform2f(m_borderShader.fullSizeUntransformed, (float)UNTRANSFORMED.width, (float)UNTRANSFORMED.height);
-    glUniform1f(m_borderShader.radius, data.rounding * m_scale);
-    glUniform1f(m_borderShader.radiusOuter, data.rounding * m_scale);
+    glUniform1f(m_borderShader.radius, radiusFor(BOX, data.rounding));
+    glUniform1f(m_borderShader.radiusOuter, radiusFor(BOX, data.rounding));
     glUniform1f(m_borderShader.roundingPower, 2);
-    glUniform1f(m_borderShader.thick, data.thick * m_scale);
+    glUniform1f(m_borderShader.thick, data.thick * TRANSFORM.scale * m_scale);
 
     glVertexAttribPointer(m_borderShader.posAttrib, 2, GL_FLOAT, GL_FALSE, 0, fullVerts);
     glVertexAttribPointer(m_borderShader.texAttrib, 2, GL_FLOAT, GL_FALSE, 0, fullVerts);
@@ -976,12 +1083,12 @@ void COpenGLRenderer::renderBorder(const SBorderRenderData& data) {
 }
 
 void COpenGLRenderer::renderPolygon(const SPolygonRenderData& data) {
-    const auto ROUNDEDBOX    = logicalToGL(data.box);
-    const auto UNTRANSFORMED = logicalToGL(data.box, false);
+    const auto ROUNDEDBOX = logicalToGL(data.box);
+    const auto DRAWN      = logicalToGL(currentTransform().bounds(data.box), false);
 
     const auto DAMAGE = damageWithClip();
 
-    if (DAMAGE.copy().intersect(UNTRANSFORMED).empty())
+    if (DAMAGE.copy().intersect(DRAWN).empty())
         return;
 
     // We always do 4X MSAA on polygons, otherwise pixel galore
@@ -1041,12 +1148,12 @@ void COpenGLRenderer::renderPolygon(const SPolygonRenderData& data) {
 }
 
 void COpenGLRenderer::renderLine(const SLineRenderData& data) {
-    const auto ROUNDEDBOX    = logicalToGL(data.box);
-    const auto UNTRANSFORMED = logicalToGL(data.box, false);
+    const auto ROUNDEDBOX = logicalToGL(data.box);
+    const auto DRAWN      = logicalToGL(currentTransform().bounds(data.box), false);
 
     const auto DAMAGE = damageWithClip();
 
-    if (DAMAGE.copy().intersect(UNTRANSFORMED).empty())
+    if (DAMAGE.copy().intersect(DRAWN).empty())
         return;
 
     if (data.points.size() <= 1)
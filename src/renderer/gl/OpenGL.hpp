@@ -3,6 +3,7 @@
 #include <hyprutils/math/Mat3x3.hpp>
 
 #include "../Renderer.hpp"
+#include "../../helpers/RenderTransform.hpp"
 
 #include "Shader.hpp"
 
@@ -22,17 +23,19 @@ namespace Hyprtoolkit {
     class CRenderbuffer;
     class CFramebuffer;
     class CEGLSync;
+    class CGLTextureUploader;
 
     class COpenGLRenderer : public IRenderer {
       public:
         COpenGLRenderer(int drmFD);
         virtual ~COpenGLRenderer();
 
-        virtual void                 beginRendering(SP<IToolkitWindow> window, SP<Aquamarine::IBuffer> buf);
+        virtual void                 beginRendering(SP<IToolkitWindow> window, SP<Aquamarine::IBuffer> buf, SP<Aquamarine::IBuffer> previous = nullptr);
         virtual void                 render(bool ignoreSync);
         virtual void                 endRendering();
         virtual void                 renderRectangle(const SRectangleRenderData& data);
         virtual SP<IRendererTexture> uploadTexture(const STextureData& data);
+        virtual void                 uploadTextureAsync(const STextureData& data, std::function<void(SP<IRendererTexture>)>&& done);
         virtual void                 renderTexture(const STextureRenderData& data);
         virtual void                 renderBorder(const SBorderRenderData& data);
         virtual void                 renderPolygon(const SPolygonRenderData& data);
@@ -42,12 +45,18 @@ namespace Hyprtoolkit {
 
         virtual bool                 explicitSyncSupported();
 
+        // deletes the storage kept for reuse by the uploader
+        void                         dropTexturePool();
+
       private:
         CBox                           logicalToGL(const CBox& box, bool transform = true);
         CRegion                        damageWithClip();
+        const SRenderTransform&        currentTransform(); // of what's being painted
+        float                          radiusFor(const CBox& drawn, int rounding);
         void                           scissor(const CBox& box);
         void                           scissor(const pixman_box32_t* box);
         void                           renderBreadthfirst(SP<IElement> el);
+        void                           copyScrolled();
         void                           waitOnSync();
 
         void                           initEGL(bool gbm);
@@ -102,8 +111,10 @@ namespace Hyprtoolkit {
 
         std::vector<SP<CRenderbuffer>> m_rbos;
         SP<CRenderbuffer>              m_currentRBO;
+        SP<CRenderbuffer>              m_previousRBO;
 
         std::vector<CBox>              m_clipBoxes;
+        std::vector<SRenderTransform>  m_transforms;
         std::vector<SP<IElement>>      m_alreadyRendered;
 
         CShader                        m_rectShader;
@@ -115,9 +126,13 @@ namespace Hyprtoolkit {
 
         Vector2D                       m_currentViewport;
 
+        UP<CGLTextureUploader>         m_uploader;
+        std::vector<EGLint>            m_sharedContextAttrs; // what m_eglContext was made with, minus the priority
+
         friend class CRenderbuffer;
         friend class CGLTexture;
         friend class CEGLSync;
+        friend class CGLTextureUploader;
     };
 
     inline SP<COpenGLRenderer> g_openGL;
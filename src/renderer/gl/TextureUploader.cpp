@@ -0,0 +1,232 @@
+#include "TextureUploader.hpp"
+#include "GLTexture.hpp"
+#include "OpenGL.hpp"
+
+#include "../TextureRegistry.hpp"
+#include "../../core/InternalBackend.hpp"
+#include "../../core/Logger.hpp"
+#include "../../helpers/Env.hpp"
+
+#include <hyprutils/memory/Casts.hpp>
+
+#include <algorithm>
+
+using namespace Hyprtoolkit;
+using namespace Hyprutils::Memory;
+
+// storage kept for uploads of the same size. Past this, the least recently let go is given back.
+constexpr size_t MAX_RECYCLED_TEXTURES = 16;
+constexpr size_t MAX_RECYCLED_BYTES    = 32 * 1024 * 1024;
+
+// a gpu that takes longer than this for one upload is stuck, hand it out regardless
+constexpr uint64_t UPLOAD_TIMEOUT_NS = 1000ULL * 1000 * 1000;
+
+static size_t storageBytes(const Vector2D& size, GLint format) {
+    size_t bpp = 4;
+    switch (format) {
+        case GL_R8: bpp = 1; break;
+        case GL_RGB565:
+        case GL_RGBA4: bpp = 2; break;
+        case GL_RGB16F: bpp = 6; break;
+        default: break;
+    }
+
+    return sc<size_t>(size.x) * sc<size_t>(size.y) * bpp;
+}
+
+CGLTextureUploader::CGLTextureUploader(EGLDisplay display, EGLContext shareWith, const std::vector<EGLint>& attrs) : m_display(display) {
+    if (Env::envEnabled("HT_NO_ASYNC_UPLOAD")) {
+        g_logger->log(HT_LOG_DEBUG, "textureUploader: disabled by HT_NO_ASYNC_UPLOAD, uploading on the main thread");
+        return;
+    }
+
+    m_context = eglCreateContext(display, EGL_NO_CONFIG_KHR, shareWith, attrs.data());
+    if (m_context == EGL_NO_CONTEXT) {
+        g_logger->log(HT_LOG_ERROR, "textureUploader: couldn't create a shared context (0x{:x}), uploading on the main thread", eglGetError());
+        return;
+    }
+
+    m_thread = std::thread([this] { uploadThread(); });
+}
+
+CGLTextureUploader::~CGLTextureUploader() {
+    {
+        std::lock_guard<std::mutex> lg(m_mutex);
+        m_exit = true;
+    }
+    m_cv.notify_all();
+
+    if (m_thread.joinable())
+        m_thread.join();
+
+    if (m_context != EGL_NO_CONTEXT)
+        eglDestroyContext(m_display, m_context);
+
+    for (const auto& job : m_queue) {
+        if (job.waitFor)
+            glDeleteSync(job.waitFor);
+    }
+
+    // never handed out, nothing to recycle
+    for (auto& [id, pending] : m_pending) {
+        pending.tex->m_storageSize = {};
+    }
+    m_pending.clear();
+
+    clearRecycled();
+}
+
+bool CGLTextureUploader::ok() const {
+    return m_context != EGL_NO_CONTEXT;
+}
+
+void CGLTextureUploader::upload(ASP<IAsyncResource> resource, const uint8_t* pixels, const Vector2D& pixelSize, size_t stride, eImageFitMode fitMode, bool lowPrecision,
+                                std::function<void(SP<IRendererTexture>)>&& done) {
+    auto tex            = makeShared<CGLTexture>();
+    tex->m_fitMode      = fitMode;
+    tex->m_lowPrecision = lowPrecision;
+    tex->m_size         = pixels ? pixelSize : resource->m_asset.pixelSize;
+
+    if (!ok()) {
+        if (pixels)
+            tex->uploadPixels(pixels, stride);
+        else {
+            tex->m_resource = resource;
+            tex->upload();
+        }
+
+        done(tex);
+        return;
+    }
+
+    SJob job{.id = m_nextID++, .tex = tex.get(), .resource = resource, .pixels = pixels, .stride = stride};
+
+    // what the pixels pack into isn't known until they're looked at, storage of another format is respecified in place
+    if (auto recycled = takeRecycled(tex->m_size); recycled) {
+        tex->m_texID         = recycled->id;
+        tex->m_allocated     = true;
+        tex->m_storageSize   = recycled->size;
+        tex->m_storageFormat = recycled->format;
+        job.waitFor          = recycled->fence;
+    } else
+        tex->allocate();
+
+    m_pending.emplace(job.id, SPending{.tex = tex, .done = std::move(done)});
+
+    {
+        std::lock_guard<std::mutex> lg(m_mutex);
+        m_queue.emplace_back(std::move(job));
+    }
+    m_cv.notify_one();
+}
+
+void CGLTextureUploader::uploadThread() {
+    eglMakeCurrent(m_display, EGL_NO_SURFACE, EGL_NO_SURFACE, m_context);
+
+    while (true) {
+        SJob job;
+
+        {
+            std::unique_lock<std::mutex> lk(m_mutex);
+            m_cv.wait(lk, [this] { return m_exit || !m_queue.empty(); });
+
+            if (m_exit)
+                break;
+
+            job = std::move(m_queue.front());
+            m_queue.pop_front();
+        }
+
+        // recycled storage, the last frame that drew from it might still be going
+        if (job.waitFor) {
+            glWaitSync(job.waitFor, 0, GL_TIMEOUT_IGNORED);
+            glDeleteSync(job.waitFor);
+        }
+
+        if (job.pixels)
+            job.tex->uploadPixels(job.pixels, job.stride);
+        else {
+            job.tex->m_resource = job.resource;
+            job.tex->upload();
+        }
+
+        job.resource.reset();
+
+        // only handed out once it's all on the gpu, so that nothing draws it half done
+        GLsync fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, UPLOAD_TIMEOUT_NS);
+        glDeleteSync(fence);
+
+        if (!g_backend)
+            continue;
+
+        g_backend->addIdle([id = job.id] {
+            if (g_openGL && g_openGL->m_uploader)
+                g_openGL->m_uploader->finish(id);
+        });
+    }
+
+    eglMakeCurrent(m_display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    eglReleaseThread();
+}
+
+void CGLTextureUploader::finish(size_t id) {
+    const auto IT = m_pending.find(id);
+    if (IT == m_pending.end())
+        return;
+
+    auto pending = std::move(IT->second);
+    m_pending.erase(IT);
+
+    pending.done(pending.tex);
+}
+
+void CGLTextureUploader::recycle(GLuint id, const Vector2D& size, GLint format) {
+    if (!ok()) {
+        GLCALL(glDeleteTextures(1, &id));
+        return;
+    }
+
+    m_recycled.emplace_front(SRecycled{.id = id, .size = size, .format = format, .fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0)});
+    m_recycledBytes += storageBytes(size, format);
+
+    trimRecycled();
+}
+
+std::optional<CGLTextureUploader::SRecycled> CGLTextureUploader::takeRecycled(const Vector2D& size) {
+    const auto IT = std::ranges::find_if(m_recycled, [&](const auto& r) { return r.size == size; });
+    if (IT == m_recycled.end())
+        return std::nullopt;
+
+    auto recycled = *IT;
+    m_recycled.erase(IT);
+    m_recycledBytes -= storageBytes(recycled.size, recycled.format);
+    textureRegistry()->setPooledBytes(m_recycledBytes);
+
+    return recycled;
+}
+
+void CGLTextureUploader::trimRecycled() {
+    while (!m_recycled.empty() && (m_recycled.size() > MAX_RECYCLED_TEXTURES || m_recycledBytes > MAX_RECYCLED_BYTES)) {
+        auto& r = m_recycled.back();
+
+        GLCALL(glDeleteTextures(1, &r.id));
+        glDeleteSync(r.fence);
+        m_recycledBytes -= storageBytes(r.size, r.format);
+
+        m_recycled.pop_back();
+    }
+
+    textureRegistry()->setPooledBytes(m_recycledBytes);
+}
+
+void CGLTextureUploader::clearRecycled() {
+    for (auto& r : m_recycled) {
+        GLCALL(glDeleteTextures(1, &r.id));
+        glDeleteSync(r.fence);
+    }
+
+    m_recycled.clear();
+    m_recycledBytes = 0;
+    textureRegistry()->setPooledBytes(0);
+}
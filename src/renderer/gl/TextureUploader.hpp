@@ -0,0 +1,98 @@
+#pragma once
+
+#include <hyprtoolkit/types/ImageTypes.hpp>
+#include <hyprutils/math/Vector2D.hpp>
+#include <hyprgraphics/resource/resources/AsyncResource.hpp>
+
+#include "GL.hpp"
+
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "../../helpers/Memory.hpp"
+
+namespace Hyprtoolkit {
+    class CGLTexture;
+    class IRendererTexture;
+
+    // Copies pixels into textures on a thread of its own, with a context shared with the renderer's,
+    // so that big images and text don't stall the frame they arrive in. A texture is only handed out
+    // once the gpu has all of it, until then whoever asked keeps drawing what they had.
+    // Storage of textures that were let go is kept for a bit, and the next upload of the same size
+    // writes into it instead of allocating new storage. What's kept is reported to the texture registry as pooled.
+    class CGLTextureUploader {
+      public:
+        // attrs are the renderer context's, a shared context has to match them
+        CGLTextureUploader(EGLDisplay display, EGLContext shareWith, const std::vector<EGLint>& attrs);
+        ~CGLTextureUploader();
+
+        CGLTextureUploader(const CGLTextureUploader&) = delete;
+        CGLTextureUploader(CGLTextureUploader&)       = delete;
+        CGLTextureUploader(CGLTextureUploader&&)      = delete;
+
+        // false if there's no upload thread, uploads are synchronous then
+        bool ok() const;
+
+        // main thread only. Either a ready resource, or pixels that live until done is called. done is called on the main thread.
+        void upload(ASP<Hyprgraphics::IAsyncResource> resource, const uint8_t* pixels, const Hyprutils::Math::Vector2D& pixelSize, size_t stride, eImageFitMode fitMode,
+                    bool lowPrecision, std::function<void(SP<IRendererTexture>)>&& done);
+
+        // storage of a texture nobody uses anymore. Main thread only, with the renderer's context current.
+        void recycle(GLuint id, const Hyprutils::Math::Vector2D& size, GLint format);
+
+        // deletes the recycled storage. Main thread only, with the renderer's context current.
+        void clearRecycled();
+
+      private:
+        struct SRecycled {
+            GLuint                    id = 0;
+            Hyprutils::Math::Vector2D size;
+            GLint                     format = 0;
+            GLsync                    fence  = nullptr; // the last frame that could've used it
+        };
+
+        // what the upload thread gets. Holds no texture refs, those aren't safe to drop off the main thread.
+        struct SJob {
+            size_t                            id  = 0;
+            CGLTexture*                       tex = nullptr;
+            ASP<Hyprgraphics::IAsyncResource> resource;
+            const uint8_t*                    pixels  = nullptr;
+            size_t                            stride  = 0;
+            GLsync                            waitFor = nullptr;
+        };
+
+        struct SPending {
+            SP<CGLTexture>                            tex;
+            std::function<void(SP<IRendererTexture>)> done;
+        };
+
+        void                                 uploadThread();
+        void                                 finish(size_t id);
+        std::optional<SRecycled>             takeRecycled(const Hyprutils::Math::Vector2D& size);
+        void                                 trimRecycled();
+
+        EGLDisplay                           m_display = nullptr;
+        EGLContext                           m_context = EGL_NO_CONTEXT;
+        std::thread                          m_thread;
+
+        std::mutex                           m_mutex;
+        std::condition_variable              m_cv;
+        std::list<SJob>                      m_queue;
+        bool                                 m_exit = false;
+
+        std::unordered_map<size_t, SPending> m_pending;  // main thread only, like everything below
+        std::list<SRecycled>                 m_recycled; // most recently let go first
+        size_t                               m_recycledBytes = 0;
+        size_t                               m_nextID        = 1;
+    };
+};
@@ -1,5 +1,8 @@
 #include "AssetCache.hpp"
 
+#include "../../core/InternalBackend.hpp"
+#include "../../core/Logger.hpp"
+
 using namespace Hyprtoolkit;
 using namespace Hyprtoolkit::Asset;
 
@@ -9,19 +12,139 @@ SP<CAssetCache> Asset::assetCache() {
 }
 
 SP<CAssetCacheEntry> CAssetCache::get(const std::string_view& source) {
-    for (const auto& e : m_entries) {
-        if (e && e->source() == source)
-            return e.lock();
+    const auto IT = m_slots.find(source);
+
+    if (IT == m_slots.end() || !IT->second.entry) {
+        if (IT != m_slots.end())
+            m_slots.erase(IT);
+
+        m_stats.misses++;
+        return nullptr;
+    }
+
+    m_stats.hits++;
+
+    auto& slot = IT->second;
+    if (slot.retained)
+        m_retained.splice(m_retained.begin(), m_retained, *slot.retained);
+
+    return slot.entry.lock();
+}
+
+void CAssetCache::cache(SP<CAssetCacheEntry> entry, bool retain) {
+    if (m_slots.size() >= m_gcThreshold)
+        gc();
+
+    auto& slot = m_slots[std::string{entry->source()}];
+
+    release(slot);
+
+    slot.entry = entry;
+
+    if (!retain)
+        return;
+
+    if (entry->status() != CACHE_ENTRY_DONE) {
+        // pending entries only live for as long as someone waits for them, so that a load
+        // nobody wants anymore can be cancelled. Sizes are only known once it's loaded, too.
+        slot.retainWhenDone = true;
+        entry->m_events.done.listenStatic([this, weak = WP<CAssetCacheEntry>{entry}] { onEntryDone(weak); });
+        return;
     }
 
-    return nullptr;
+    m_retained.emplace_front(entry);
+    slot.retained = m_retained.begin();
+
+    charge(slot);
+    trim(m_cpuBudget, m_gpuBudget);
+}
+
+void CAssetCache::onEntryDone(WP<CAssetCacheEntry> entry) {
+    if (!entry)
+        return;
+
+    const auto IT = m_slots.find(entry->source());
+
+    // replaced in the meantime
+    if (IT == m_slots.end() || IT->second.entry != entry || !IT->second.retainWhenDone)
+        return;
+
+    auto& slot          = IT->second;
+    slot.retainWhenDone = false;
+
+    // failed, findable while in use but not kept around, so that it's tried again later
+    if (!entry->tex())
+        return;
+
+    m_retained.emplace_front(entry.lock());
+    slot.retained = m_retained.begin();
+
+    charge(slot);
+    trim(m_cpuBudget, m_gpuBudget);
+}
+
+void CAssetCache::charge(SSlot& slot) {
+    m_stats.cpuBytes -= slot.cpuBytes;
+    m_stats.gpuBytes -= slot.gpuBytes;
+
+    slot.cpuBytes = slot.entry->cpuBytes();
+    slot.gpuBytes = slot.entry->gpuBytes();
+
+    m_stats.cpuBytes += slot.cpuBytes;
+    m_stats.gpuBytes += slot.gpuBytes;
+}
+
+void CAssetCache::release(SSlot& slot) {
+    slot.retainWhenDone = false;
+
+    if (!slot.retained)
+        return;
+
+    m_stats.cpuBytes -= slot.cpuBytes;
+    m_stats.gpuBytes -= slot.gpuBytes;
+    slot.cpuBytes = 0;
+    slot.gpuBytes = 0;
+
+    m_retained.erase(*slot.retained);
+    slot.retained.reset();
+}
+
+void CAssetCache::setBudget(size_t cpuBytes, size_t gpuBytes) {
+    m_cpuBudget = cpuBytes;
+    m_gpuBudget = gpuBytes;
+
+    trim(m_cpuBudget, m_gpuBudget);
 }
 
-void CAssetCache::cache(SP<CAssetCacheEntry> entry) {
-    gc();
-    m_entries.emplace_back(entry);
+void CAssetCache::trim(size_t cpuBytes, size_t gpuBytes) {
+    size_t evicted = 0;
+
+    while (!m_retained.empty() && (m_stats.cpuBytes > cpuBytes || m_stats.gpuBytes > gpuBytes || (cpuBytes == 0 && gpuBytes == 0))) {
+        // the slot has to be found before the entry can go away with the list's ref
+        const auto IT = m_slots.find(m_retained.back()->source());
+
+        if (IT != m_slots.end() && IT->second.retained)
+            release(IT->second);
+        else
+            m_retained.pop_back();
+
+        evicted++;
+    }
+
+    m_stats.evictions += evicted;
+
+    if (evicted)
+        g_logger->log(HT_LOG_DEBUG, "assetCache: evicted {} entries, retaining {} ({} B cpu, {} B gpu)", evicted, m_retained.size(), m_stats.cpuBytes, m_stats.gpuBytes);
 }
 
 void CAssetCache::gc() {
-    std::erase_if(m_entries, [](const auto& e) { return !e; });
+    std::erase_if(m_slots, [](const auto& e) { return !e.second.entry; });
+
+    m_gcThreshold = std::max<size_t>(64, m_slots.size() * 2);
+}
+
+SAssetCacheStats CAssetCache::stats() const {
+    auto stats     = m_stats;
+    stats.retained = m_retained.size();
+    return stats;
 }
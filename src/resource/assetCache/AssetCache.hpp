@@ -2,14 +2,26 @@
 
 #include "AssetCacheEntry.hpp"
 
-#include <vector>
+#include <list>
+#include <optional>
+#include <string>
+#include <unordered_map>
 
 namespace Hyprtoolkit::Asset {
 
+    struct SAssetCacheStats {
+        size_t hits = 0, misses = 0, evictions = 0;
+
+        // of the retained tier only
+        size_t retained = 0, cpuBytes = 0, gpuBytes = 0;
+    };
+
     // AssetCache is a cache for loading assets. Since we keep assets (images) as
     // textures in VRAM, we don't want to load the same raster asset multiple times.
-    // IMPORTANT: AssetCache holds only WEAK references to the entries. You need
-    // to hold your own ref somewhere to avoid the asset going dead
+    // Every entry stays findable for as long as anyone holds it. On top of that, the
+    // cache itself retains the most recently used entries until they don't fit in the byte
+    // budget anymore, so that an asset that goes out of use briefly (scrolled away, popup closed)
+    // doesn't have to be decoded and uploaded again.
     class CAssetCache {
       public:
         CAssetCache()  = default;
@@ -19,15 +31,51 @@ namespace Hyprtoolkit::Asset {
         CAssetCache(CAssetCache&)       = delete;
         CAssetCache(CAssetCache&&)      = delete;
 
-        // TODO: implement this for svg images. These can be loaded at different res's
         SP<CAssetCacheEntry> get(const std::string_view& source);
-        void                 cache(SP<CAssetCacheEntry> entry);
+
+        // retain = false only makes the entry findable while it's in use, for sources that can't be identified reliably
+        void                 cache(SP<CAssetCacheEntry> entry, bool retain = true);
+
+        // limits of the retained tier. Trims right away if needed.
+        void                 setBudget(size_t cpuBytes, size_t gpuBytes);
+
+        // drops retained entries, least recently used first, until the retained tier fits in the given bytes.
+        // Entries still in use elsewhere stay alive and findable.
+        void                 trim(size_t cpuBytes = 0, size_t gpuBytes = 0);
+
+        SAssetCacheStats     stats() const;
 
       private:
-        void                              gc();
+        struct SStringHash {
+            using is_transparent = void;
+
+            size_t operator()(const std::string_view& s) const {
+                return std::hash<std::string_view>{}(s);
+            }
+        };
+
+        struct SSlot {
+            WP<CAssetCacheEntry>                                     entry;
+            std::optional<std::list<SP<CAssetCacheEntry>>::iterator> retained;
+            bool                                                     retainWhenDone = false; // pending, gets retained once done
+
+            // what was added to the totals for this entry
+            size_t cpuBytes = 0, gpuBytes = 0;
+        };
+
+        void                                                                 onEntryDone(WP<CAssetCacheEntry> entry);
+        void                                                                 charge(SSlot& slot);
+        void                                                                 release(SSlot& slot);
+        void                                                                 gc();
+
+        std::unordered_map<std::string, SSlot, SStringHash, std::equal_to<>> m_slots;
+        std::list<SP<CAssetCacheEntry>>                                      m_retained; // most recently used first
+
+        size_t                                                               m_cpuBudget = 64 * 1024 * 1024, m_gpuBudget = 128 * 1024 * 1024;
+        size_t                                                               m_gcThreshold = 64;
 
-        std::vector<WP<CAssetCacheEntry>> m_entries;
+        SAssetCacheStats                                                     m_stats;
     };
 
     SP<CAssetCache> assetCache();
-};
\ No newline at end of file
+};
@@ -1,5 +1,10 @@
 #include "AssetCacheEntry.hpp"
 
+#include "../../renderer/RendererTexture.hpp"
+#include "../decode/DecodeScheduler.hpp"
+
+#include <hyprutils/memory/Casts.hpp>
+
 using namespace Hyprtoolkit;
 using namespace Hyprtoolkit::Asset;
 
@@ -23,8 +28,40 @@ eAssetCacheEntryStatus CAssetCacheEntry::status() const {
     return m_status;
 }
 
+size_t CAssetCacheEntry::cpuBytes() const {
+    return m_cpuBytes;
+}
+
+size_t CAssetCacheEntry::gpuBytes() const {
+    return m_tex ? m_tex->bytes() : 0;
+}
+
+void CAssetCacheEntry::setCPUBytes(size_t bytes) {
+    m_cpuBytes = bytes;
+}
+
 void CAssetCacheEntry::texDone(SP<IRendererTexture> tex) {
     m_tex    = tex;
     m_status = CACHE_ENTRY_DONE;
+    m_ticket.reset();
     m_events.done.emit();
 }
+
+Hyprutils::Math::Vector2D CAssetCacheEntry::sourceSize() const {
+    if (m_sourceSize)
+        return *m_sourceSize;
+
+    return m_tex ? m_tex->size() : Hyprutils::Math::Vector2D{};
+}
+
+void CAssetCacheEntry::setSourceSize(const Hyprutils::Math::Vector2D& size) {
+    m_sourceSize = size;
+}
+
+void CAssetCacheEntry::setTicket(SP<CDecodeTicket> ticket) {
+    m_ticket = ticket;
+}
+
+WP<CDecodeTicket> CAssetCacheEntry::ticket() const {
+    return m_ticket;
+}
@@ -1,8 +1,10 @@
 #pragma once
 
+#include <optional>
 #include <string_view>
 
 #include <hyprutils/signal/Signal.hpp>
+#include <hyprutils/math/Vector2D.hpp>
 
 #include "../../helpers/Memory.hpp"
 
@@ -11,6 +13,8 @@ namespace Hyprtoolkit {
 }
 
 namespace Hyprtoolkit::Asset {
+    class CDecodeTicket;
+
     enum eAssetCacheEntryStatus : uint8_t {
         CACHE_ENTRY_PENDING = 0,
         CACHE_ENTRY_DONE    = 1,
@@ -30,9 +34,24 @@ namespace Hyprtoolkit::Asset {
         SP<IRendererTexture>   tex() const;
         eAssetCacheEntryStatus status() const;
 
+        // what keeping this entry alive costs, in bytes. GPU is the texture,
+        // CPU is whatever the owner keeps around next to it.
+        size_t                 cpuBytes() const;
+        size_t                 gpuBytes() const;
+        void                   setCPUBytes(size_t bytes);
+
+        // pixel size of what the texture was made from. Larger than the texture if it was scaled down
+        // after decoding, the texture's size otherwise.
+        Hyprutils::Math::Vector2D sourceSize() const;
+        void                      setSourceSize(const Hyprutils::Math::Vector2D& size);
+
         // if created without a tex, this will mark asset as done
         void texDone(SP<IRendererTexture> tex);
 
+        // the load this entry is waiting for. Held until it's done, dropping the entry before that cancels it.
+        void              setTicket(SP<CDecodeTicket> ticket);
+        WP<CDecodeTicket> ticket() const;
+
         bool operator==(const CAssetCacheEntry& e) const {
             return m_tex == e.m_tex;
         }
@@ -42,8 +61,11 @@ namespace Hyprtoolkit::Asset {
         } m_events;
 
       private:
-        const std::string      m_source;
-        SP<IRendererTexture>   m_tex;
-        eAssetCacheEntryStatus m_status = CACHE_ENTRY_PENDING;
+        const std::string                        m_source;
+        SP<IRendererTexture>                     m_tex;
+        eAssetCacheEntryStatus                   m_status   = CACHE_ENTRY_PENDING;
+        size_t                                   m_cpuBytes = 0;
+        std::optional<Hyprutils::Math::Vector2D> m_sourceSize;
+        SP<CDecodeTicket>                        m_ticket;
     };
 };
\ No newline at end of file
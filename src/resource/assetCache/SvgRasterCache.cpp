@@ -0,0 +1,128 @@
+#include "SvgRasterCache.hpp"
+
+#include "../../renderer/RendererTexture.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include <hyprutils/memory/Casts.hpp>
+
+using namespace Hyprtoolkit;
+using namespace Hyprtoolkit::Asset;
+using namespace Hyprutils::Math;
+using namespace Hyprutils::Memory;
+
+// below this, the ladder goes in steps of SMALL_RASTER_STEP. Small icons are where a blurry pixel shows the most.
+constexpr double SMALL_RASTER      = 64;
+constexpr double SMALL_RASTER_STEP = 4;
+
+// above SMALL_RASTER, rasters are this many steps per doubling apart, i.e. at most ~9% larger than needed
+constexpr double STEPS_PER_OCTAVE = 8;
+
+// sizes remembered per svg
+constexpr size_t MAX_RASTERS_PER_SVG = 4;
+
+SP<CSvgRasterCache> Asset::svgRasterCache() {
+    static auto cache = makeShared<CSvgRasterCache>();
+    return cache;
+}
+
+static double ladderSideFor(double px) {
+    if (px <= SMALL_RASTER)
+        return std::max(SMALL_RASTER_STEP, std::ceil(px / SMALL_RASTER_STEP) * SMALL_RASTER_STEP);
+
+    // start a step below the estimate, the rounded sizes can be off by one from the exact ones
+    int step = std::max(0, sc<int>(std::floor(std::log2(px / SMALL_RASTER) * STEPS_PER_OCTAVE)) - 1);
+    while (true) {
+        const double SIDE = std::round(SMALL_RASTER * std::exp2(step / STEPS_PER_OCTAVE));
+        if (SIDE >= px)
+            return SIDE;
+        step++;
+    }
+}
+
+Vector2D CSvgRasterCache::rasterSizeFor(const Vector2D& box) {
+    if (box.x <= 0 || box.y <= 0)
+        return {};
+
+    const bool   WIDE   = box.x >= box.y;
+    const double LONGER = WIDE ? box.x : box.y, SHORTER = WIDE ? box.y : box.x;
+
+    // scaled sizes come with some float noise, 24.0000001 shouldn't need a 28px raster
+    const double SIDE  = ladderSideFor(std::ceil(LONGER - 0.001));
+    const double OTHER = std::max(1.0, std::round(SHORTER * SIDE / LONGER));
+
+    return WIDE ? Vector2D{SIDE, OTHER} : Vector2D{OTHER, SIDE};
+}
+
+void CSvgRasterCache::add(const std::string& svg, SP<CAssetCacheEntry> entry) {
+    if (!entry || !entry->tex())
+        return;
+
+    if (m_svgs.size() >= m_gcThreshold)
+        gc();
+
+    auto&      rasters = m_svgs[svg];
+    const auto SIZE    = entry->tex()->size();
+
+    std::erase_if(rasters, [&SIZE](const auto& r) { return !r.entry || r.size == SIZE; });
+
+    rasters.insert(rasters.begin(), SRaster{.size = SIZE, .entry = entry});
+
+    if (rasters.size() > MAX_RASTERS_PER_SVG)
+        rasters.resize(MAX_RASTERS_PER_SVG);
+}
+
+SP<CAssetCacheEntry> CSvgRasterCache::nearest(const std::string& svg, const Vector2D& size) {
+    const auto IT = m_svgs.find(svg);
+    if (IT == m_svgs.end())
+        return nullptr;
+
+    auto& rasters = IT->second;
+    std::erase_if(rasters, [](const auto& r) { return !r.entry; });
+
+    if (rasters.empty()) {
+        m_svgs.erase(IT);
+        return nullptr;
+    }
+
+    const auto COVERS = [&size](const SRaster& r) { return r.size.x >= size.x && r.size.y >= size.y; };
+    const auto AREA   = [](const SRaster& r) { return r.size.x * r.size.y; };
+
+    auto       best = rasters.begin();
+    for (auto it = rasters.begin(); it != rasters.end(); ++it) {
+        if (COVERS(*it) != COVERS(*best)) {
+            if (COVERS(*it))
+                best = it;
+            continue;
+        }
+
+        // among the ones that cover it the smallest, otherwise the largest
+        if (COVERS(*it) ? AREA(*it) < AREA(*best) : AREA(*it) > AREA(*best))
+            best = it;
+    }
+
+    auto entry = best->entry.lock();
+
+    std::rotate(rasters.begin(), best, best + 1);
+
+    return entry;
+}
+
+size_t CSvgRasterCache::count(const std::string& svg) {
+    const auto IT = m_svgs.find(svg);
+    if (IT == m_svgs.end())
+        return 0;
+
+    return std::ranges::count_if(IT->second, [](const auto& r) { return !!r.entry; });
+}
+
+void CSvgRasterCache::gc() {
+    for (auto& [svg, rasters] : m_svgs) {
+        std::erase_if(rasters, [](const auto& r) { return !r.entry; });
+    }
+
+    std::erase_if(m_svgs, [](const auto& e) { return e.second.empty(); });
+
+    m_gcThreshold = std::max<size_t>(64, m_svgs.size() * 2);
+}
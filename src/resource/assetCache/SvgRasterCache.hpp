@@ -0,0 +1,51 @@
+#pragma once
+
+#include "AssetCacheEntry.hpp"
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Hyprtoolkit::Asset {
+
+    // SvgRasterCache remembers which sizes each svg has been rasterized at, so that whichever
+    // one is already there can be shown while the size that's actually needed is made.
+    // It doesn't keep rasters alive by itself, that's up to the asset cache and its budget.
+    class CSvgRasterCache {
+      public:
+        CSvgRasterCache()  = default;
+        ~CSvgRasterCache() = default;
+
+        CSvgRasterCache(const CSvgRasterCache&) = delete;
+        CSvgRasterCache(CSvgRasterCache&)       = delete;
+        CSvgRasterCache(CSvgRasterCache&&)      = delete;
+
+        // the pixel size to rasterize at to cover box. The longer side is rounded up along a ladder of
+        // sizes (multiples of 4 up to 64, then 8 steps per doubling), the shorter one keeps the box's
+        // aspect ratio. Sizes on the ladder map to themselves, so 0x0 for an empty box.
+        static Hyprutils::Math::Vector2D rasterSizeFor(const Hyprutils::Math::Vector2D& box);
+
+        // a finished raster of svg. Only the few most recently used sizes of each svg are remembered.
+        void                             add(const std::string& svg, SP<CAssetCacheEntry> entry);
+
+        // the smallest finished raster of svg that covers size, or the largest one if none does.
+        // nullptr if there's none at all.
+        SP<CAssetCacheEntry>             nearest(const std::string& svg, const Hyprutils::Math::Vector2D& size);
+
+        // sizes remembered for svg
+        size_t                           count(const std::string& svg);
+
+      private:
+        struct SRaster {
+            Hyprutils::Math::Vector2D size;
+            WP<CAssetCacheEntry>      entry;
+        };
+
+        void                                                  gc();
+
+        std::unordered_map<std::string, std::vector<SRaster>> m_svgs; // per svg, most recently used first
+        size_t                                                m_gcThreshold = 64;
+    };
+
+    SP<CSvgRasterCache> svgRasterCache();
+};
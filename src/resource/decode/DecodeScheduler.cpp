@@ -0,0 +1,240 @@
+#include "DecodeScheduler.hpp"
+
+#include "../../core/InternalBackend.hpp"
+#include "../../core/Logger.hpp"
+
+#include <algorithm>
+
+using namespace Hyprtoolkit;
+using namespace Hyprtoolkit::Asset;
+
+// decoding is memory bound soon enough, more than this rarely helps
+constexpr size_t MAX_AUTO_WORKERS = 4;
+
+CDecodeTicket::~CDecodeTicket() {
+    cancel();
+}
+
+void CDecodeTicket::cancel() {
+    if (m_job == 0)
+        return;
+
+    if (const auto SCHEDULER = m_scheduler.lock())
+        SCHEDULER->cancel(m_job, m_waiter);
+
+    m_job = 0;
+}
+
+void CDecodeTicket::setPriority(eDecodePriority priority) {
+    if (m_job == 0)
+        return;
+
+    if (const auto SCHEDULER = m_scheduler.lock())
+        SCHEDULER->setPriority(m_job, m_waiter, priority);
+}
+
+SP<CDecodeScheduler> CDecodeScheduler::create(size_t workers) {
+    auto p    = SP<CDecodeScheduler>(new CDecodeScheduler(workers));
+    p->m_self = p;
+    return p;
+}
+
+CDecodeScheduler::CDecodeScheduler(size_t workers) {
+    if (workers == 0)
+        workers = std::clamp<size_t>(std::thread::hardware_concurrency() / 2, 1, MAX_AUTO_WORKERS);
+
+    for (size_t i = 0; i < workers; ++i) {
+        m_workers.emplace_back([this] { workerThread(); });
+    }
+
+    g_logger->log(HT_LOG_DEBUG, "decodeScheduler: started with {} workers", workers);
+}
+
+CDecodeScheduler::~CDecodeScheduler() {
+    {
+        std::lock_guard<std::mutex> lg(m_mutex);
+        m_exit = true;
+    }
+    m_cv.notify_all();
+    m_idleCV.notify_all();
+
+    for (auto& w : m_workers) {
+        if (w.joinable())
+            w.join();
+    }
+}
+
+SP<CDecodeTicket> CDecodeScheduler::submit(const std::string& key, eDecodePriority priority, std::function<void()>&& work, std::function<void()>&& done) {
+    auto ticket         = SP<CDecodeTicket>(new CDecodeTicket());
+    ticket->m_scheduler = m_self;
+
+    {
+        std::lock_guard<std::mutex> lg(m_mutex);
+
+        m_stats.submitted++;
+
+        const size_t WAITER = m_nextID++;
+        ticket->m_waiter    = WAITER;
+
+        if (const auto IT = m_byKey.find(key); IT != m_byKey.end()) {
+            auto& job = m_jobs.at(IT->second);
+            job.waiters.emplace_back(SWaiter{.id = WAITER, .priority = priority, .done = std::move(done)});
+            reprioritize(job);
+
+            ticket->m_job = job.id;
+            m_stats.deduplicated++;
+            return ticket;
+        }
+
+        const size_t ID  = m_nextID++;
+        auto&        job = m_jobs[ID];
+        job.id           = ID;
+        job.key          = key;
+        job.priority     = priority;
+        job.work         = std::move(work);
+        job.waiters.emplace_back(SWaiter{.id = WAITER, .priority = priority, .done = std::move(done)});
+
+        m_byKey[key] = ID;
+        m_queue.emplace(priority, ID);
+
+        ticket->m_job = ID;
+    }
+
+    m_cv.notify_one();
+
+    return ticket;
+}
+
+void CDecodeScheduler::reprioritize(SJob& job) {
+    if (job.running || job.waiters.empty())
+        return;
+
+    const auto PRIORITY = std::ranges::min_element(job.waiters, {}, &SWaiter::priority)->priority;
+    if (PRIORITY == job.priority)
+        return;
+
+    m_queue.erase({job.priority, job.id});
+    job.priority = PRIORITY;
+    m_queue.emplace(job.priority, job.id);
+}
+
+void CDecodeScheduler::cancel(size_t jobID, size_t waiter) {
+    std::lock_guard<std::mutex> lg(m_mutex);
+
+    const auto IT = m_jobs.find(jobID);
+    if (IT == m_jobs.end())
+        return;
+
+    auto& job = IT->second;
+    std::erase_if(job.waiters, [waiter](const auto& w) { return w.id == waiter; });
+
+    if (!job.waiters.empty()) {
+        reprioritize(job);
+        return;
+    }
+
+    // too late, it finishes but nobody gets told. Its work was its submitter's, so the next submit
+    // with the key gets a job of its own instead of waiting on this one.
+    if (job.running) {
+        forgetKey(job);
+        return;
+    }
+
+    m_queue.erase({job.priority, job.id});
+    forgetKey(job);
+    m_jobs.erase(IT);
+    m_stats.cancelled++;
+
+    if (m_queue.empty() && m_running == 0)
+        m_idleCV.notify_all();
+}
+
+void CDecodeScheduler::forgetKey(const SJob& job) {
+    // might be a newer job's by now
+    if (const auto IT = m_byKey.find(job.key); IT != m_byKey.end() && IT->second == job.id)
+        m_byKey.erase(IT);
+}
+
+void CDecodeScheduler::setPriority(size_t jobID, size_t waiter, eDecodePriority priority) {
+    std::lock_guard<std::mutex> lg(m_mutex);
+
+    const auto IT = m_jobs.find(jobID);
+    if (IT == m_jobs.end())
+        return;
+
+    auto& job = IT->second;
+    for (auto& w : job.waiters) {
+        if (w.id == waiter)
+            w.priority = priority;
+    }
+
+    reprioritize(job);
+}
+
+void CDecodeScheduler::workerThread() {
+    while (true) {
+        std::function<void()> work;
+        size_t                id = 0;
+
+        {
+            std::unique_lock<std::mutex> lk(m_mutex);
+            m_cv.wait(lk, [this] { return m_exit || !m_queue.empty(); });
+
+            if (m_exit)
+                return;
+
+            id = m_queue.begin()->second;
+            m_queue.erase(m_queue.begin());
+
+            auto& job   = m_jobs.at(id);
+            job.running = true;
+            work        = std::move(job.work);
+            m_running++;
+        }
+
+        if (work)
+            work();
+
+        std::vector<std::function<void()>> dones;
+
+        {
+            std::lock_guard<std::mutex> lg(m_mutex);
+
+            auto& job = m_jobs.at(id);
+            for (auto& w : job.waiters) {
+                dones.emplace_back(std::move(w.done));
+            }
+
+            forgetKey(job);
+            m_jobs.erase(id);
+            m_stats.decoded++;
+        }
+
+        for (const auto& done : dones) {
+            if (done)
+                done();
+        }
+
+        {
+            std::lock_guard<std::mutex> lg(m_mutex);
+            m_running--;
+
+            if (m_queue.empty() && m_running == 0)
+                m_idleCV.notify_all();
+        }
+    }
+}
+
+void CDecodeScheduler::flush() {
+    std::unique_lock<std::mutex> lk(m_mutex);
+    m_idleCV.wait(lk, [this] { return m_exit || (m_queue.empty() && m_running == 0); });
+}
+
+size_t CDecodeScheduler::workers() const {
+    return m_workers.size();
+}
+
+SDecodeStats CDecodeScheduler::stats() {
+    std::lock_guard<std::mutex> lg(m_mutex);
+    return m_stats;
+}
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "../../helpers/Memory.hpp"
+
+namespace Hyprtoolkit::Asset {
+
+    enum eDecodePriority : uint8_t {
+        DECODE_PRIORITY_VISIBLE = 0, // on screen right now
+        DECODE_PRIORITY_NEAR,        // within about a viewport of being on screen
+        DECODE_PRIORITY_PREFETCH,    // anything else
+    };
+
+    struct SDecodeStats {
+        size_t submitted = 0, decoded = 0, cancelled = 0, deduplicated = 0;
+    };
+
+    class CDecodeScheduler;
+
+    // Handle of a submitted decode. Dropping it cancels the request: if nobody else
+    // waits for the same decode and it hasn't started yet, it never runs.
+    class CDecodeTicket {
+      public:
+        ~CDecodeTicket();
+
+        CDecodeTicket(const CDecodeTicket&) = delete;
+        CDecodeTicket(CDecodeTicket&)       = delete;
+        CDecodeTicket(CDecodeTicket&&)      = delete;
+
+        void cancel();
+        void setPriority(eDecodePriority priority);
+
+      private:
+        CDecodeTicket() = default;
+
+        WP<CDecodeScheduler> m_scheduler;
+        size_t               m_job = 0, m_waiter = 0;
+
+        friend class CDecodeScheduler;
+    };
+
+    // Runs decodes on a small pool of workers, most visible first. Requests with the same key
+    // while one is queued or running share it, and are all told when it's done.
+    class CDecodeScheduler {
+      public:
+        // 0 picks a worker count from the cpu count
+        static SP<CDecodeScheduler> create(size_t workers = 0);
+        ~CDecodeScheduler();
+
+        CDecodeScheduler(const CDecodeScheduler&) = delete;
+        CDecodeScheduler(CDecodeScheduler&)       = delete;
+        CDecodeScheduler(CDecodeScheduler&&)      = delete;
+
+        // work runs on a worker, then done, on the same worker, for every ticket that wasn't cancelled.
+        // If a decode with the same key is pending, work is dropped and done waits for that one.
+        // A running decode nobody waits for anymore doesn't count, it's not told about new waiters.
+        SP<CDecodeTicket> submit(const std::string& key, eDecodePriority priority, std::function<void()>&& work, std::function<void()>&& done);
+
+        // waits until nothing is queued or running
+        void              flush();
+
+        size_t            workers() const;
+        SDecodeStats      stats();
+
+      private:
+        CDecodeScheduler(size_t workers);
+
+        struct SWaiter {
+            size_t                id       = 0;
+            eDecodePriority       priority = DECODE_PRIORITY_PREFETCH;
+            std::function<void()> done;
+        };
+
+        struct SJob {
+            size_t                id = 0;
+            std::string           key;
+            eDecodePriority       priority = DECODE_PRIORITY_PREFETCH;
+            std::function<void()> work;
+            std::vector<SWaiter>  waiters;
+            bool                  running = false;
+        };
+
+        void                                         cancel(size_t job, size_t waiter);
+        void                                         setPriority(size_t job, size_t waiter, eDecodePriority priority);
+        void                                         reprioritize(SJob& job);
+        void                                         forgetKey(const SJob& job);
+        void                                         workerThread();
+
+        WP<CDecodeScheduler>                         m_self;
+        std::vector<std::thread>                     m_workers;
+
+        std::mutex                                   m_mutex;
+        std::condition_variable                      m_cv, m_idleCV;
+        std::unordered_map<size_t, SJob>             m_jobs;
+        std::unordered_map<std::string, size_t>      m_byKey;
+        std::set<std::pair<eDecodePriority, size_t>> m_queue; // priority, then id, i.e. first come first served
+        size_t                                       m_nextID = 1, m_running = 0;
+        bool                                         m_exit = false;
+
+        SDecodeStats                                 m_stats;
+
+        friend class CDecodeTicket;
+    };
+};
@@ -0,0 +1,375 @@
+#include "ImageDiskCache.hpp"
+
+#include "../../core/InternalBackend.hpp"
+#include "../../core/Logger.hpp"
+#include "../../helpers/Hash.hpp"
+
+#include <hyprgraphics/resource/resources/AsyncResource.hpp>
+#include <hyprutils/memory/Casts.hpp>
+#include <cairo/cairo.h>
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstring>
+#include <format>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace Hyprtoolkit;
+using namespace Hyprtoolkit::Asset;
+
+constexpr uint32_t CACHE_MAGIC   = 0x43495448; // "HTIC"
+constexpr uint32_t CACHE_VERSION = 3;
+
+// pixels start aligned, so that they can be handed to the gpu straight from the mapping
+constexpr size_t PIXELS_ALIGNMENT = 64;
+
+// evicting goes a bit below the cap, so that it doesn't run on every store
+constexpr float EVICT_TO = 0.9F;
+
+// stores are best-effort, don't pile up pixels if the disk is slow
+constexpr size_t MAX_QUEUED_STORES = 64;
+
+struct SCacheFileHeader {
+    uint32_t magic   = CACHE_MAGIC;
+    uint32_t version = CACHE_VERSION;
+    uint64_t keyHash = 0;
+    uint32_t width = 0, height = 0, stride = 0;
+    uint32_t sourceWidth = 0, sourceHeight = 0;
+    uint32_t pathLen        = 0;
+    uint64_t pixelsChecksum = 0;
+    uint64_t headerChecksum = 0; // of everything above
+};
+
+// checksummed as raw bytes, so there must not be any padding
+static_assert(sizeof(SCacheFileHeader) == 56);
+
+static uint64_t headerChecksum(const SCacheFileHeader& header) {
+    return Hash::xxh64(&header, offsetof(SCacheFileHeader, headerChecksum));
+}
+
+static size_t pixelsOffset(size_t pathLen) {
+    const size_t END = sizeof(SCacheFileHeader) + pathLen;
+    return (END + PIXELS_ALIGNMENT - 1) / PIXELS_ALIGNMENT * PIXELS_ALIGNMENT;
+}
+
+CMappedImage::~CMappedImage() {
+    if (m_mapped)
+        munmap(m_mapped, m_mapSize);
+}
+
+const uint8_t* CMappedImage::pixels() const {
+    return m_pixels;
+}
+
+Hyprutils::Math::Vector2D CMappedImage::size() const {
+    return m_size;
+}
+
+size_t CMappedImage::stride() const {
+    return m_stride;
+}
+
+Hyprutils::Math::Vector2D CMappedImage::sourceSize() const {
+    return m_sourceSize;
+}
+
+CImageDiskCache::CImageDiskCache(const std::filesystem::path& dir, size_t maxBytes) : m_dir(dir), m_maxBytes(maxBytes) {
+    std::error_code ec;
+    std::filesystem::create_directories(m_dir, ec);
+
+    if (ec)
+        g_logger->log(HT_LOG_ERROR, "imageDiskCache: can't create {}: {}", m_dir.string(), ec.message());
+
+    size_t total = 0;
+    for (const auto& e : std::filesystem::directory_iterator(m_dir, ec)) {
+        if (e.is_regular_file(ec))
+            total += e.file_size(ec);
+    }
+    m_bytes = total;
+
+    m_writer = std::thread([this] { writerThread(); });
+}
+
+CImageDiskCache::~CImageDiskCache() {
+    {
+        std::lock_guard<std::mutex> lg(m_queueMutex);
+        m_exit = true;
+    }
+    m_queueCV.notify_all();
+
+    if (m_writer.joinable())
+        m_writer.join();
+}
+
+std::filesystem::path CImageDiskCache::defaultDirectory() {
+    const char* xdg = getenv("XDG_CACHE_HOME");
+    if (xdg && xdg[0] == '/')
+        return std::filesystem::path{xdg} / "hyprtoolkit" / "images";
+
+    const char* home = getenv("HOME");
+    return std::filesystem::path{home ? home : "/tmp"} / ".cache" / "hyprtoolkit" / "images";
+}
+
+std::optional<CImageDiskCache::SResolvedKey> CImageDiskCache::resolve(const SImageCacheKey& key) const {
+    struct stat st;
+    if (key.path.empty() || stat(key.path.c_str(), &st) != 0)
+        return std::nullopt;
+
+    SResolvedKey resolved;
+    resolved.sourceMtime = sc<uint64_t>(st.st_mtim.tv_sec) * 1000000000ULL + st.st_mtim.tv_nsec;
+    resolved.sourceSize  = st.st_size;
+
+    const uint32_t FIELDS[] = {
+        sc<uint32_t>(key.pixelSize.x),
+        sc<uint32_t>(key.pixelSize.y),
+        std::bit_cast<uint32_t>(key.scale),
+    };
+
+    uint64_t hash = Hash::xxh64(key.path.data(), key.path.size());
+    hash          = Hash::xxh64(&resolved.sourceMtime, sizeof(resolved.sourceMtime), hash);
+    hash          = Hash::xxh64(&resolved.sourceSize, sizeof(resolved.sourceSize), hash);
+    hash          = Hash::xxh64(FIELDS, sizeof(FIELDS), hash);
+
+    resolved.hash = hash;
+    resolved.file = m_dir / std::format("{:016x}.htic", hash);
+
+    return resolved;
+}
+
+SP<CMappedImage> CImageDiskCache::load(const SImageCacheKey& key) {
+    const auto RESOLVED = resolve(key);
+    if (!RESOLVED)
+        return nullptr;
+
+    const int FD = open(RESOLVED->file.c_str(), O_RDONLY | O_CLOEXEC);
+    if (FD < 0)
+        return nullptr;
+
+    struct stat st;
+    if (fstat(FD, &st) != 0 || sc<size_t>(st.st_size) < sizeof(SCacheFileHeader)) {
+        close(FD);
+        return nullptr;
+    }
+
+    auto image       = SP<CMappedImage>(new CMappedImage());
+    image->m_mapSize = st.st_size;
+    image->m_mapped  = mmap(nullptr, image->m_mapSize, PROT_READ, MAP_PRIVATE, FD, 0);
+    close(FD);
+
+    if (image->m_mapped == MAP_FAILED) {
+        image->m_mapped = nullptr;
+        return nullptr;
+    }
+
+    const auto BYTES = sc<const uint8_t*>(image->m_mapped);
+
+    SCacheFileHeader header;
+    std::memcpy(&header, BYTES, sizeof(header));
+
+    const auto CORRUPT = [&](const char* why) -> SP<CMappedImage> {
+        drop(RESOLVED->file, image->m_mapSize, why);
+        return nullptr;
+    };
+
+    if (header.magic != CACHE_MAGIC || header.version != CACHE_VERSION || header.headerChecksum != headerChecksum(header))
+        return CORRUPT("bad header");
+
+    const size_t OFFSET = pixelsOffset(header.pathLen);
+
+    if (header.stride < header.width * 4 || image->m_mapSize != OFFSET + sc<size_t>(header.stride) * header.height)
+        return CORRUPT("bad size");
+
+    // a hash collision is astronomically unlikely, but cheap to rule out
+    if (header.keyHash != RESOLVED->hash || std::string_view{rc<const char*>(BYTES + sizeof(header)), header.pathLen} != key.path)
+        return CORRUPT("key mismatch");
+
+    // starts reading in the pixels, verify or the upload will need them soon
+    madvise(image->m_mapped, image->m_mapSize, MADV_WILLNEED);
+
+    image->m_pixels         = BYTES + OFFSET;
+    image->m_size           = {sc<double>(header.width), sc<double>(header.height)};
+    image->m_sourceSize     = {sc<double>(header.sourceWidth), sc<double>(header.sourceHeight)};
+    image->m_stride         = header.stride;
+    image->m_pixelsChecksum = header.pixelsChecksum;
+    image->m_file           = RESOLVED->file;
+
+    // mtime is what eviction goes by
+    utimensat(AT_FDCWD, RESOLVED->file.c_str(), nullptr, 0);
+
+    return image;
+}
+
+bool CImageDiskCache::verify(const CMappedImage& image) {
+    if (Hash::xxh64(image.m_pixels, image.m_stride * sc<size_t>(image.m_size.y)) == image.m_pixelsChecksum)
+        return true;
+
+    drop(image.m_file, image.m_mapSize, "bad checksum");
+    return false;
+}
+
+void CImageDiskCache::drop(const std::filesystem::path& file, size_t bytes, const char* why) {
+    g_logger->log(HT_LOG_DEBUG, "imageDiskCache: dropping {}: {}", file.string(), why);
+    std::error_code ec;
+    if (std::filesystem::remove(file, ec))
+        m_bytes -= std::min<size_t>(m_bytes, bytes);
+}
+
+bool CImageDiskCache::store(const SImageCacheKey& key, const uint8_t* pixels, const Hyprutils::Math::Vector2D& size, size_t stride, const Hyprutils::Math::Vector2D& sourceSize) {
+    const auto RESOLVED = resolve(key);
+    if (!RESOLVED || !pixels || size.x <= 0 || size.y <= 0)
+        return false;
+
+    SCacheFileHeader header;
+    header.keyHash        = RESOLVED->hash;
+    header.width          = size.x;
+    header.height         = size.y;
+    header.stride         = stride;
+    header.sourceWidth    = sourceSize.x > 0 ? sourceSize.x : size.x;
+    header.sourceHeight   = sourceSize.y > 0 ? sourceSize.y : size.y;
+    header.pathLen        = key.path.size();
+    header.pixelsChecksum = Hash::xxh64(pixels, stride * header.height);
+    header.headerChecksum = headerChecksum(header);
+
+    const size_t OFFSET = pixelsOffset(header.pathLen);
+    const size_t TOTAL  = OFFSET + stride * header.height;
+
+    // written next to it and renamed over, so that readers never see a partial file
+    const auto TMP = RESOLVED->file.string() + std::format(".{}.tmp", gettid());
+    const int  FD  = open(TMP.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (FD < 0)
+        return false;
+
+    std::vector<uint8_t> head(OFFSET, 0);
+    std::memcpy(head.data(), &header, sizeof(header));
+    std::memcpy(head.data() + sizeof(header), key.path.data(), key.path.size());
+
+    const bool OK = write(FD, head.data(), head.size()) == sc<ssize_t>(head.size()) && write(FD, pixels, TOTAL - OFFSET) == sc<ssize_t>(TOTAL - OFFSET);
+    close(FD);
+
+    // what the rename replaces, if anything, isn't there anymore
+    struct stat  st;
+    const size_t REPLACED = stat(RESOLVED->file.c_str(), &st) == 0 ? sc<size_t>(st.st_size) : 0;
+
+    if (!OK || rename(TMP.c_str(), RESOLVED->file.c_str()) != 0) {
+        unlink(TMP.c_str());
+        return false;
+    }
+
+    m_bytes -= std::min<size_t>(m_bytes, REPLACED);
+    m_bytes += TOTAL;
+
+    if (m_bytes > m_maxBytes)
+        evict();
+
+    return true;
+}
+
+void CImageDiskCache::storeAsync(const SImageCacheKey& key, ASP<Hyprgraphics::IAsyncResource> resource, const Hyprutils::Math::Vector2D& sourceSize) {
+    if (!resource || !resource->m_asset.cairoSurface || cairo_image_surface_get_format(resource->m_asset.cairoSurface->cairo()) != CAIRO_FORMAT_ARGB32)
+        return;
+
+    {
+        std::lock_guard<std::mutex> lg(m_queueMutex);
+        if (m_queue.size() >= MAX_QUEUED_STORES)
+            return;
+        m_queue.emplace_back(SStoreJob{.key = key, .resource = resource, .sourceSize = sourceSize});
+    }
+
+    m_queueCV.notify_all();
+}
+
+void CImageDiskCache::writerThread() {
+    while (true) {
+        std::vector<SStoreJob> jobs;
+
+        {
+            std::unique_lock<std::mutex> lk(m_queueMutex);
+            m_queueCV.wait(lk, [this] { return m_exit || !m_queue.empty(); });
+
+            if (m_exit)
+                return;
+
+            jobs   = std::move(m_queue);
+            m_busy = jobs.size();
+            m_queue.clear();
+        }
+
+        for (const auto& job : jobs) {
+            const auto SURFACE = job.resource->m_asset.cairoSurface->cairo();
+
+            cairo_surface_flush(SURFACE);
+
+            store(job.key, cairo_image_surface_get_data(SURFACE), {sc<double>(cairo_image_surface_get_width(SURFACE)), sc<double>(cairo_image_surface_get_height(SURFACE))},
+                  cairo_image_surface_get_stride(SURFACE), job.sourceSize);
+        }
+
+        {
+            std::lock_guard<std::mutex> lg(m_queueMutex);
+            m_busy = 0;
+        }
+        m_queueCV.notify_all();
+    }
+}
+
+void CImageDiskCache::setMaxBytes(size_t maxBytes) {
+    m_maxBytes = maxBytes;
+
+    if (m_bytes > m_maxBytes)
+        evict();
+}
+
+void CImageDiskCache::flush() {
+    std::unique_lock<std::mutex> lk(m_queueMutex);
+    m_queueCV.wait(lk, [this] { return m_exit || (m_queue.empty() && m_busy == 0); });
+}
+
+void CImageDiskCache::evict() {
+    std::lock_guard<std::mutex> lg(m_evictMutex);
+
+    struct SFile {
+        std::filesystem::path           path;
+        std::filesystem::file_time_type time;
+        size_t                          size = 0;
+    };
+
+    std::vector<SFile> files;
+    size_t             total = 0;
+    std::error_code    ec;
+
+    for (const auto& e : std::filesystem::directory_iterator(m_dir, ec)) {
+        if (!e.is_regular_file(ec) || e.path().extension() != ".htic")
+            continue;
+
+        files.emplace_back(SFile{.path = e.path(), .time = e.last_write_time(ec), .size = e.file_size(ec)});
+        total += files.back().size;
+    }
+
+    std::ranges::sort(files, [](const auto& a, const auto& b) { return a.time < b.time; });
+
+    const size_t TARGET  = m_maxBytes * EVICT_TO;
+    size_t       removed = 0;
+
+    for (const auto& f : files) {
+        if (total <= TARGET)
+            break;
+
+        if (!std::filesystem::remove(f.path, ec))
+            continue;
+
+        total -= f.size;
+        removed++;
+    }
+
+    m_bytes = total;
+
+    if (removed)
+        g_logger->log(HT_LOG_DEBUG, "imageDiskCache: evicted {} entries, {} B left", removed, total);
+}
+
+size_t CImageDiskCache::bytes() const {
+    return m_bytes;
+}
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <hyprutils/math/Vector2D.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../../helpers/Memory.hpp"
+
+namespace Hyprgraphics {
+    class IAsyncResource;
+}
+
+namespace Hyprtoolkit::Asset {
+
+    struct SImageCacheKey {
+        std::string               path;
+        Hyprutils::Math::Vector2D pixelSize; // what it was rendered at, 0x0 for the native size
+        float                     scale = 1.F;
+    };
+
+    // A cache file mapped into memory. Pixels are cairo ARGB32, i.e. premultiplied
+    // and native endian, ready to upload as-is.
+    class CMappedImage {
+      public:
+        ~CMappedImage();
+
+        CMappedImage(const CMappedImage&) = delete;
+        CMappedImage(CMappedImage&)       = delete;
+        CMappedImage(CMappedImage&&)      = delete;
+
+        const uint8_t*            pixels() const;
+        Hyprutils::Math::Vector2D size() const;
+        size_t                    stride() const;
+
+        // what the pixels were scaled down from, size() if they weren't
+        Hyprutils::Math::Vector2D sourceSize() const;
+
+      private:
+        CMappedImage() = default;
+
+        void*                     m_mapped         = nullptr;
+        size_t                    m_mapSize        = 0;
+        const uint8_t*            m_pixels         = nullptr;
+        Hyprutils::Math::Vector2D m_size           = {};
+        Hyprutils::Math::Vector2D m_sourceSize     = {};
+        size_t                    m_stride         = 0;
+        uint64_t                  m_pixelsChecksum = 0;
+        std::filesystem::path     m_file;
+
+        friend class CImageDiskCache;
+    };
+
+    // Persistent cache of decoded images, so that the same icons don't have to be
+    // decoded again on every start. Entries are keyed by the source's path, mtime and size,
+    // and the size and scale they were rendered at. Loads check the header on the calling thread,
+    // the pixels are checked by verify(), off the main thread. Stores happen on a writer thread.
+    class CImageDiskCache {
+      public:
+        CImageDiskCache(const std::filesystem::path& dir, size_t maxBytes);
+        ~CImageDiskCache();
+
+        CImageDiskCache(const CImageDiskCache&) = delete;
+        CImageDiskCache(CImageDiskCache&)       = delete;
+        CImageDiskCache(CImageDiskCache&&)      = delete;
+
+        // $XDG_CACHE_HOME/hyprtoolkit/images
+        static std::filesystem::path defaultDirectory();
+
+        // nullptr if there is no entry with a valid header. The pixels aren't checked yet, see verify.
+        SP<CMappedImage>             load(const SImageCacheKey& key);
+
+        // checksums all the pixels, which reads the whole file. Drops the entry if they don't match.
+        // Thread-safe.
+        bool                         verify(const CMappedImage& image);
+
+        // pixels have to be cairo ARGB32. sourceSize is what they were scaled down from, if they were.
+        bool                         store(const SImageCacheKey& key, const uint8_t* pixels, const Hyprutils::Math::Vector2D& size, size_t stride,
+                                           const Hyprutils::Math::Vector2D& sourceSize = {});
+
+        // stores the resource's surface on the writer thread, if it's something we can cache
+        void                         storeAsync(const SImageCacheKey& key, ASP<Hyprgraphics::IAsyncResource> resource, const Hyprutils::Math::Vector2D& sourceSize = {});
+
+        // removes the least recently used entries until the cache fits in maxBytes
+        void                         evict();
+
+        // evicts right away if the cache doesn't fit anymore
+        void                         setMaxBytes(size_t maxBytes);
+
+        // waits for pending stores
+        void                         flush();
+
+        size_t                       bytes() const;
+
+      private:
+        struct SStoreJob {
+            SImageCacheKey                    key;
+            ASP<Hyprgraphics::IAsyncResource> resource;
+            Hyprutils::Math::Vector2D         sourceSize;
+        };
+
+        // a key with the source's current state
+        struct SResolvedKey {
+            std::filesystem::path file;
+            uint64_t              hash = 0, sourceMtime = 0, sourceSize = 0;
+        };
+
+        std::optional<SResolvedKey> resolve(const SImageCacheKey& key) const;
+        void                        drop(const std::filesystem::path& file, size_t bytes, const char* why);
+        void                        writerThread();
+
+        std::filesystem::path       m_dir;
+        std::atomic<size_t>         m_maxBytes = 0;
+        std::atomic<size_t>         m_bytes    = 0;
+
+        std::mutex                  m_evictMutex;
+
+        std::thread                 m_writer;
+        std::mutex                  m_queueMutex;
+        std::condition_variable     m_queueCV;
+        std::vector<SStoreJob>      m_queue;
+        size_t                      m_busy = 0;
+        bool                        m_exit = false;
+    };
+};
@@ -0,0 +1,115 @@
+#include "Prefetcher.hpp"
+
+#include <hyprtoolkit/palette/Palette.hpp>
+#include <hyprutils/memory/Casts.hpp>
+#include <hyprgraphics/resource/resources/TextResource.hpp>
+#include <hyprgraphics/color/Color.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+#include "../../core/InternalBackend.hpp"
+#include "../../element/Element.hpp"
+#include "../../element/image/Image.hpp"
+#include "../../system/Icons.hpp"
+#include "../../system/Fonts.hpp"
+
+using namespace Hyprtoolkit;
+using namespace Hyprutils::Memory;
+
+void CPrefetcher::prefetch(const SPrefetchRequest& request) {
+    dropFinished();
+
+    if (request.type == SPrefetchRequest::HT_PREFETCH_TEXT)
+        prefetchText(request);
+    else
+        prefetchImage(request);
+}
+
+size_t CPrefetcher::pending() const {
+    return std::ranges::count_if(m_loading, [](const auto& e) { return e->m_impl->waitingForTex; });
+}
+
+void CPrefetcher::prefetchImage(const SPrefetchRequest& request) {
+    SImageData data;
+    data.fitMode = request.fitMode;
+
+    if (request.type == SPrefetchRequest::HT_PREFETCH_ICON) {
+        if (!g_iconFactory)
+            return;
+
+        data.icon = g_iconFactory->lookupIcon(request.source);
+        if (!data.icon->exists())
+            return;
+    } else if (!request.data.empty())
+        data.data = request.data;
+    else
+        data.path = request.source;
+
+    if (request.size.x > 0 && request.size.y > 0)
+        data.size = CDynamicSize{CDynamicSize::HT_SIZE_ABSOLUTE, CDynamicSize::HT_SIZE_ABSOLUTE, request.size};
+    else
+        data.size = CDynamicSize{CDynamicSize::HT_SIZE_AUTO, CDynamicSize::HT_SIZE_AUTO, {1, 1}};
+
+    // never attached to a window, so it goes with the box and scale it would have been laid out at,
+    // and loads at the lowest priority until something visible shares the load.
+    auto element               = CImageElement::create(data);
+    element->impl->position    = Hyprutils::Math::CBox{{}, request.size};
+    element->m_impl->lastScale = request.scale;
+    element->renderTex();
+
+    if (!element->m_impl->waitingForTex)
+        return;
+
+    if (element->m_impl->cacheEntry) {
+        element->m_impl->cacheEntry->m_events.done.listenStatic([] {
+            g_backend->addIdle([] {
+                if (g_prefetcher)
+                    g_prefetcher->dropFinished();
+            });
+        });
+    }
+
+    m_loading.emplace_back(std::move(element));
+}
+
+void CPrefetcher::prefetchText(const SPrefetchRequest& request) {
+    if (!g_fontManager || request.source.empty())
+        return;
+
+    const auto   FAMILY = !request.fontFamily.empty() ? request.fontFamily : (g_palette ? g_palette->m_vars.fontFamily : "Sans Serif");
+
+    const auto   SIZE   = std::round(request.fontSize.ptSize() * request.scale);
+
+    PangoLayout* layout = g_fontManager->createLayout();
+
+    // same description the text element measures with, so the font is loaded and the glyphs shaped once
+    pango_layout_set_font_description(layout, g_fontManager->fontDescription(FAMILY, sc<int>(SIZE) * PANGO_SCALE));
+    pango_layout_set_text(layout, request.source.c_str(), -1);
+
+    int w = 0, h = 0;
+    pango_layout_get_pixel_size(layout, &w, &h);
+
+    g_object_unref(layout);
+
+    // that's only the measuring side. Rendering is on the gatherer's threads, with their own font map, so it's rendered there
+    // once too and thrown away. That loads the font where it's rendered, and fills cairo's glyph cache, which all threads share.
+    if (!g_asyncResourceGatherer)
+        return;
+
+    char*       escaped = g_markup_escape_text(request.source.c_str(), -1);
+    std::string escapedText{escaped};
+    g_free(escaped);
+
+    auto resource = makeAtomicShared<Hyprgraphics::CTextResource>(Hyprgraphics::CTextResource::STextResourceData{
+        .text     = std::move(escapedText),
+        .font     = FAMILY,
+        .fontSize = sc<size_t>(SIZE),
+    });
+
+    g_asyncResourceGatherer->enqueue(ASP<Hyprgraphics::IAsyncResource>(resource));
+}
+
+void CPrefetcher::dropFinished() {
+    std::erase_if(m_loading, [](const auto& e) { return !e->m_impl->waitingForTex; });
+}
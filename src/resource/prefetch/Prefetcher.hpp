@@ -0,0 +1,37 @@
+#pragma once
+
+#include <hyprtoolkit/core/Prefetch.hpp>
+
+#include <vector>
+
+#include "../../helpers/Memory.hpp"
+
+namespace Hyprtoolkit {
+    class CImageElement;
+
+    // Loads what's about to be shown into the shared caches, see IBackend::prefetch().
+    // Images and icons are loaded by an image element that's never shown, so that they end up under
+    // the exact cache key an element showing them later computes. Text warms the font and glyph caches,
+    // both where it's measured and where it's rendered.
+    class CPrefetcher {
+      public:
+        CPrefetcher()  = default;
+        ~CPrefetcher() = default;
+
+        CPrefetcher(const CPrefetcher&) = delete;
+        CPrefetcher(CPrefetcher&)       = delete;
+        CPrefetcher(CPrefetcher&&)      = delete;
+
+        void   prefetch(const SPrefetchRequest& request);
+
+        // images still loading
+        size_t pending() const;
+
+      private:
+        void                           prefetchImage(const SPrefetchRequest& request);
+        void                           prefetchText(const SPrefetchRequest& request);
+        void                           dropFinished();
+
+        std::vector<SP<CImageElement>> m_loading;
+    };
+};
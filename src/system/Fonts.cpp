@@ -0,0 +1,95 @@
+#include "Fonts.hpp"
+
+#include <format>
+
+#include "../core/InternalBackend.hpp"
+#include "../core/Logger.hpp"
+
+using namespace Hyprtoolkit;
+
+// families times sizes times scales, only a handful in practice. Past this they're all dropped and made again.
+constexpr size_t MAX_DESCRIPTIONS = 64;
+
+CFontManager::CFontManager() : m_created(std::chrono::steady_clock::now()) {
+    m_prewarmThread = std::thread([this] {
+        const auto BEGIN = std::chrono::steady_clock::now();
+
+        m_fontMap = pango_cairo_font_map_new();
+
+        // loading any font makes fontconfig read its config and caches
+        auto ctx  = pango_font_map_create_context(m_fontMap);
+        auto desc = pango_font_description_from_string("Sans Serif");
+        pango_font_description_set_size(desc, 11 * PANGO_SCALE);
+
+        if (auto font = pango_font_map_load_font(m_fontMap, ctx, desc); font)
+            g_object_unref(font);
+
+        pango_font_description_free(desc);
+        g_object_unref(ctx);
+
+        m_prewarmTook = std::chrono::steady_clock::now() - BEGIN;
+    });
+}
+
+CFontManager::~CFontManager() {
+    if (m_prewarmThread.joinable())
+        m_prewarmThread.join();
+
+    for (const auto& [k, v] : m_descriptions) {
+        pango_font_description_free(v);
+    }
+
+    if (m_context)
+        g_object_unref(m_context);
+    if (m_fontMap)
+        g_object_unref(m_fontMap);
+}
+
+void CFontManager::waitForPrewarm() {
+    if (m_context)
+        return;
+
+    const auto BEGIN = std::chrono::steady_clock::now();
+
+    m_prewarmThread.join();
+
+    const auto WAITED = std::chrono::steady_clock::now() - BEGIN;
+
+    g_logger->log(HT_LOG_DEBUG, "fonts: prewarm took {:.2f}ms, first use {:.2f}ms after start, waited {:.2f}ms",
+                  std::chrono::duration<float, std::milli>(m_prewarmTook).count(), std::chrono::duration<float, std::milli>(BEGIN - m_created).count(),
+                  std::chrono::duration<float, std::milli>(WAITED).count());
+
+    m_context = pango_font_map_create_context(m_fontMap);
+
+    // match what a layout on a cairo image surface gets, which is what text is rendered with
+    auto surface = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, 1, 1 /* dummy value */);
+    auto cairo   = cairo_create(surface);
+    pango_cairo_update_context(cairo, m_context);
+    cairo_destroy(cairo);
+    cairo_surface_destroy(surface);
+}
+
+PangoLayout* CFontManager::createLayout() {
+    waitForPrewarm();
+    return pango_layout_new(m_context);
+}
+
+const PangoFontDescription* CFontManager::fontDescription(const std::string& family, int pangoSize) {
+    const auto KEY = std::format("{}@{}", family, pangoSize);
+
+    if (const auto IT = m_descriptions.find(KEY); IT != m_descriptions.end())
+        return IT->second;
+
+    if (m_descriptions.size() >= MAX_DESCRIPTIONS) {
+        for (const auto& [k, v] : m_descriptions) {
+            pango_font_description_free(v);
+        }
+        m_descriptions.clear();
+    }
+
+    PangoFontDescription* desc = pango_font_description_from_string(family.c_str());
+    pango_font_description_set_size(desc, pangoSize);
+
+    m_descriptions[KEY] = desc;
+    return desc;
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <pango/pangocairo.h>
+
+#include <chrono>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+namespace Hyprtoolkit {
+
+    // Shared pango state for measuring text on the main thread.
+    // Creating a font map is what initializes fontconfig, which is slow, so it's done
+    // on a thread as soon as the manager is created, and only waited on at first use.
+    // Only measuring shares it: hyprgraphics rasterizes text on its own threads, with pango's
+    // per-thread default font map, which this can't be handed to.
+    class CFontManager {
+      public:
+        CFontManager();
+        ~CFontManager();
+
+        // new layout on the shared context. Unref when done.
+        PangoLayout*                createLayout();
+
+        // cached, owned by the manager, valid until the next call. Size is in pango units.
+        const PangoFontDescription* fontDescription(const std::string& family, int pangoSize);
+
+      private:
+        void                                                   waitForPrewarm();
+
+        std::thread                                            m_prewarmThread;
+        PangoFontMap*                                          m_fontMap = nullptr;
+        PangoContext*                                          m_context = nullptr;
+
+        std::chrono::steady_clock::time_point                  m_created;
+        std::chrono::steady_clock::duration                    m_prewarmTook;
+
+        std::unordered_map<std::string, PangoFontDescription*> m_descriptions;
+    };
+}
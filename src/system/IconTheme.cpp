@@ -0,0 +1,627 @@
+#include "IconTheme.hpp"
+#include "../core/InternalBackend.hpp"
+#include "../helpers/Hash.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <limits>
+
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <hyprutils/memory/Casts.hpp>
+#include <hyprutils/string/String.hpp>
+#include <hyprutils/string/ConstVarList.hpp>
+#include <hyprutils/utils/ScopeGuard.hpp>
+
+extern "C" {
+#include "iniparser.h"
+}
+
+using namespace Hyprtoolkit;
+using namespace Hyprutils::Memory;
+using namespace Hyprutils::String;
+using namespace Hyprutils::Utils;
+
+constexpr uint32_t UNTHEMED = std::numeric_limits<uint32_t>::max();
+
+// themes inheriting deeper than this are broken anyways
+constexpr size_t   MAX_INHERIT_DEPTH = 16;
+
+constexpr auto     CACHE_MAGIC = "hyprtoolkit-icon-index 2";
+
+constexpr uint32_t WATCH_MASK = IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_CLOSE_WRITE | IN_DELETE_SELF | IN_MOVE_SELF;
+
+static std::optional<eIconFormat> formatOf(const std::string_view& ext) {
+    if (ext == ".png")
+        return ICON_FORMAT_PNG;
+    if (ext == ".svg")
+        return ICON_FORMAT_SVG;
+    // xpm is allowed by the spec, but nothing can decode it
+    return std::nullopt;
+}
+
+static const char* extensionOf(eIconFormat format) {
+    switch (format) {
+        case ICON_FORMAT_PNG: return ".png";
+        case ICON_FORMAT_SVG: return ".svg";
+    }
+    return "";
+}
+
+static uint64_t mtimeOf(const std::string& path) {
+    struct stat st;
+    if (stat(path.c_str(), &st) != 0 || !S_ISDIR(st.st_mode))
+        return 0;
+
+    // never 0 for something that exists
+    return std::max<uint64_t>(1, sc<uint64_t>(st.st_mtim.tv_sec) * 1000000000ULL + st.st_mtim.tv_nsec);
+}
+
+static std::vector<std::string> splitList(const char* list, char separator = ',') {
+    std::vector<std::string> result;
+    if (!list)
+        return result;
+
+    CConstVarList items(list, 0, separator, true);
+    for (const auto& i : items) {
+        auto item = trim(std::string{i});
+        if (!item.empty())
+            result.emplace_back(std::move(item));
+    }
+
+    return result;
+}
+
+bool SIconDirectory::matchesSize(int iconSize, int iconScale) const {
+    if (scale != iconScale)
+        return false;
+
+    switch (type) {
+        case ICON_DIRECTORY_FIXED: return size == iconSize;
+        case ICON_DIRECTORY_SCALABLE: return minSize <= iconSize && iconSize <= maxSize;
+        case ICON_DIRECTORY_THRESHOLD: return size - threshold <= iconSize && iconSize <= size + threshold;
+    }
+
+    return false;
+}
+
+int SIconDirectory::sizeDistance(int iconSize, int iconScale) const {
+    const int WANTED = iconSize * iconScale;
+
+    switch (type) {
+        case ICON_DIRECTORY_FIXED: return std::abs(size * scale - WANTED);
+        case ICON_DIRECTORY_SCALABLE:
+            if (WANTED < minSize * scale)
+                return minSize * scale - WANTED;
+            if (WANTED > maxSize * scale)
+                return WANTED - maxSize * scale;
+            return 0;
+        case ICON_DIRECTORY_THRESHOLD:
+            // the spec's pseudocode says MinSize and MaxSize here, everyone implements it like this
+            if (WANTED < (size - threshold) * scale)
+                return (size - threshold) * scale - WANTED;
+            if (WANTED > (size + threshold) * scale)
+                return WANTED - (size + threshold) * scale;
+            return 0;
+    }
+
+    return std::numeric_limits<int>::max();
+}
+
+CIconThemeIndex::CIconThemeIndex(const std::string& theme, std::vector<std::string> baseDirs, std::string cacheDir) :
+    m_requestedTheme(theme), m_baseDirs(std::move(baseDirs)), m_cacheDir(std::move(cacheDir)), m_inotifyFd(inotify_init1(IN_NONBLOCK | IN_CLOEXEC)) {
+    rebuild();
+}
+
+std::vector<std::string> CIconThemeIndex::defaultBaseDirs() {
+    std::vector<std::string> dirs;
+
+    const char*              home = getenv("HOME");
+    if (home)
+        dirs.emplace_back(std::string{home} + "/.icons");
+
+    const char* dataHome = getenv("XDG_DATA_HOME");
+    if (dataHome && dataHome[0] == '/')
+        dirs.emplace_back(std::string{dataHome} + "/icons");
+    else if (home)
+        dirs.emplace_back(std::string{home} + "/.local/share/icons");
+
+    const char* dataDirs = getenv("XDG_DATA_DIRS");
+    for (const auto& d : splitList(dataDirs && dataDirs[0] ? dataDirs : "/usr/local/share:/usr/share", ':')) {
+        dirs.emplace_back(d + "/icons");
+    }
+
+    dirs.emplace_back("/usr/share/pixmaps");
+
+    // the same dir twice would only list everything twice
+    std::vector<std::string> unique;
+    for (auto& d : dirs) {
+        if (!std::ranges::contains(unique, d))
+            unique.emplace_back(std::move(d));
+    }
+
+    return unique;
+}
+
+std::string CIconThemeIndex::defaultCacheDirectory() {
+    const char* xdg = getenv("XDG_CACHE_HOME");
+    if (xdg && xdg[0] == '/')
+        return std::string{xdg} + "/hyprtoolkit/icons";
+
+    const char* home = getenv("HOME");
+    return std::string{home ? home : "/tmp"} + "/.cache/hyprtoolkit/icons";
+}
+
+const SIconFile* CIconThemeIndex::bestFile(const std::vector<SIconFile>& files, int size, int scale) {
+    if (files.empty())
+        return nullptr;
+
+    // all fallbacks, or all from the same theme. The first one made for the size wins.
+    for (const auto& f : files) {
+        if (!f.directory || f.directory->matchesSize(size, scale))
+            return &f;
+    }
+
+    const SIconFile* closest  = nullptr;
+    int              distance = std::numeric_limits<int>::max();
+
+    for (const auto& f : files) {
+        const auto D = f.directory->sizeDistance(size, scale);
+        if (D < distance) {
+            closest  = &f;
+            distance = D;
+        }
+    }
+
+    return closest;
+}
+
+std::vector<SIconFile> CIconThemeIndex::lookup(const std::string& name) {
+    if (m_dirty)
+        rebuild();
+
+    auto IT = m_icons.find(name);
+
+    // icon dirs aren't watched, a miss might be an icon that was installed since
+    if (IT == m_icons.end() && std::chrono::steady_clock::now() - m_lastRecheck >= RECHECK_INTERVAL) {
+        m_lastRecheck = std::chrono::steady_clock::now();
+
+        if (locationsChanged()) {
+            g_logger->log(HT_LOG_DEBUG, "iconTheme: icon dirs changed, reindexing");
+            rebuild();
+            IT = m_icons.find(name);
+        }
+    }
+
+    if (IT == m_icons.end())
+        return {};
+
+    std::vector<SIconFile> files;
+
+    const auto             THEME = m_locations[IT->second.front().location].theme;
+
+    for (const auto& e : IT->second) {
+        const auto& LOCATION = m_locations[e.location];
+        if (LOCATION.theme != THEME)
+            break;
+
+        files.emplace_back(SIconFile{
+            .path      = LOCATION.path + "/" + name + extensionOf(e.format),
+            .format    = e.format,
+            .directory = THEME == UNTHEMED ? std::nullopt : std::optional{m_themes[THEME].directories[LOCATION.directory]},
+        });
+    }
+
+    return files;
+}
+
+std::vector<std::string> CIconThemeIndex::themes() const {
+    std::vector<std::string> names;
+    names.reserve(m_themes.size());
+
+    for (const auto& t : m_themes) {
+        names.emplace_back(t.name);
+    }
+
+    return names;
+}
+
+size_t CIconThemeIndex::icons() const {
+    return m_icons.size();
+}
+
+bool CIconThemeIndex::loadedFromCache() const {
+    return m_fromCache;
+}
+
+int CIconThemeIndex::watchFD() const {
+    return m_watches.empty() ? -1 : m_inotifyFd.get();
+}
+
+void CIconThemeIndex::onWatchEvent() {
+    alignas(inotify_event) std::array<char, 4096> buffer = {};
+    while (read(m_inotifyFd.get(), buffer.data(), buffer.size()) > 0) {
+        ;
+    }
+
+    if (!m_dirty)
+        g_logger->log(HT_LOG_DEBUG, "iconTheme: icon themes changed, reindexing on the next lookup");
+
+    m_dirty = true;
+}
+
+void CIconThemeIndex::invalidate() {
+    m_dirty = true;
+}
+
+void CIconThemeIndex::rebuild() {
+    const auto BEGIN = std::chrono::steady_clock::now();
+
+    m_themes.clear();
+    m_locations.clear();
+    m_icons.clear();
+    m_dirty     = false;
+    m_fromCache = false;
+
+    auto theme = m_requestedTheme;
+    if (!theme.empty() && !themeExists(theme)) {
+        g_logger->log(HT_LOG_WARNING, "iconTheme: theme {} isn't installed, using the default one", theme);
+        theme.clear();
+    }
+
+    if (theme.empty())
+        theme = resolveDefaultTheme();
+
+    if (!theme.empty())
+        addTheme(theme, 0);
+
+    // everything falls back to hicolor last
+    addTheme("hicolor", 0);
+
+    if (m_themes.empty())
+        g_logger->log(HT_LOG_ERROR, "iconTheme: no icon theme found, only unthemed icons will work");
+
+    collectLocations();
+
+    if (!loadCache()) {
+        scan();
+        saveCache();
+    }
+
+    plantWatches();
+
+    m_lastRecheck = std::chrono::steady_clock::now();
+
+    g_logger->log(HT_LOG_DEBUG, "iconTheme: indexed {} icons from {} themes in {:.2f}ms{}", m_icons.size(), m_themes.size(),
+                  std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - BEGIN).count(), m_fromCache ? " (cached)" : "");
+}
+
+bool CIconThemeIndex::locationsChanged() const {
+    return std::ranges::any_of(m_locations, [](const auto& l) { return mtimeOf(l.path) != l.mtime; });
+}
+
+bool CIconThemeIndex::themeExists(const std::string& name) const {
+    for (const auto& base : m_baseDirs) {
+        std::error_code ec;
+        if (std::filesystem::exists(base + "/" + name + "/index.theme", ec) && !ec)
+            return true;
+    }
+
+    return false;
+}
+
+std::string CIconThemeIndex::resolveDefaultTheme() const {
+    // first, whatever the "default" theme points to
+    for (const auto& base : m_baseDirs) {
+        const auto  PATH = base + "/default/index.theme";
+
+        std::error_code ec;
+        if (!std::filesystem::is_regular_file(PATH, ec) || ec)
+            continue;
+
+        dictionary* ini = iniparser_load(PATH.c_str());
+        CScopeGuard x([ini] {
+            if (ini)
+                iniparser_freedict(ini);
+        });
+
+        if (!ini)
+            continue;
+
+        for (const auto& parent : splitList(iniparser_getstring(ini, "Icon Theme:Inherits", nullptr))) {
+            if (themeExists(parent))
+                return parent;
+        }
+    }
+
+    // otherwise anything that's installed, hicolor is added anyways
+    std::vector<std::string> installed;
+    for (const auto& base : m_baseDirs) {
+        std::error_code ec;
+        for (auto it = std::filesystem::directory_iterator(base, ec); !ec && it != std::filesystem::directory_iterator(); it.increment(ec)) {
+            const auto NAME = it->path().filename().string();
+            if (NAME == "hicolor" || NAME == "default")
+                continue;
+
+            std::error_code ec2;
+            if (std::filesystem::exists(it->path() / "index.theme", ec2) && !ec2)
+                installed.emplace_back(NAME);
+        }
+    }
+
+    if (installed.empty())
+        return "";
+
+    // directory order isn't stable, the choice should be
+    std::ranges::sort(installed);
+    return installed.front();
+}
+
+void CIconThemeIndex::addTheme(const std::string& name, size_t depth) {
+    if (depth > MAX_INHERIT_DEPTH || std::ranges::any_of(m_themes, [&name](const auto& t) { return t.name == name; }))
+        return;
+
+    STheme theme{.name = name};
+
+    for (const auto& base : m_baseDirs) {
+        std::error_code ec;
+        if (std::filesystem::is_directory(base + "/" + name, ec) && !ec)
+            theme.roots.emplace_back(base + "/" + name);
+    }
+
+    const auto INDEX = std::ranges::find_if(theme.roots, [](const auto& r) {
+        std::error_code ec;
+        return std::filesystem::is_regular_file(r + "/index.theme", ec) && !ec;
+    });
+
+    if (INDEX == theme.roots.end()) {
+        g_logger->log(HT_LOG_TRACE, "iconTheme: skipping theme {} (no index.theme)", name);
+        return;
+    }
+
+    dictionary* ini = iniparser_load((*INDEX + "/index.theme").c_str());
+    CScopeGuard x([ini] {
+        if (ini)
+            iniparser_freedict(ini);
+    });
+
+    if (!ini) {
+        g_logger->log(HT_LOG_TRACE, "iconTheme: skipping theme {} (iniparser failed)", name);
+        return;
+    }
+
+    auto directories = splitList(iniparser_getstring(ini, "Icon Theme:Directories", nullptr));
+    for (auto& d : splitList(iniparser_getstring(ini, "Icon Theme:ScaledDirectories", nullptr))) {
+        if (!std::ranges::contains(directories, d))
+            directories.emplace_back(std::move(d));
+    }
+
+    for (const auto& d : directories) {
+        SIconDirectory dir{.name = d};
+
+        dir.size = iniparser_getint(ini, (d + ":Size").c_str(), 0);
+        if (dir.size <= 0) {
+            g_logger->log(HT_LOG_TRACE, "iconTheme: {}: skipping directory {} (no size)", name, d);
+            continue;
+        }
+
+        dir.scale     = std::max(1, iniparser_getint(ini, (d + ":Scale").c_str(), 1));
+        dir.minSize   = iniparser_getint(ini, (d + ":MinSize").c_str(), dir.size);
+        dir.maxSize   = iniparser_getint(ini, (d + ":MaxSize").c_str(), dir.size);
+        dir.threshold = iniparser_getint(ini, (d + ":Threshold").c_str(), 2);
+
+        const std::string TYPE = iniparser_getstring(ini, (d + ":Type").c_str(), "Threshold");
+        if (TYPE == "Fixed")
+            dir.type = ICON_DIRECTORY_FIXED;
+        else if (TYPE == "Scalable")
+            dir.type = ICON_DIRECTORY_SCALABLE;
+        else
+            dir.type = ICON_DIRECTORY_THRESHOLD;
+
+        theme.directories.emplace_back(std::move(dir));
+    }
+
+    const auto PARENTS = splitList(iniparser_getstring(ini, "Icon Theme:Inherits", nullptr));
+
+    g_logger->log(HT_LOG_TRACE, "iconTheme: theme {} has {} dirs in {} places, inherits {} themes", name, theme.directories.size(), theme.roots.size(), PARENTS.size());
+
+    // before the parents, so that a cycle ends here
+    m_themes.emplace_back(std::move(theme));
+
+    for (const auto& p : PARENTS) {
+        addTheme(p, depth + 1);
+    }
+}
+
+void CIconThemeIndex::collectLocations() {
+    for (uint32_t t = 0; t < m_themes.size(); ++t) {
+        const auto& THEME = m_themes[t];
+        for (uint32_t d = 0; d < THEME.directories.size(); ++d) {
+            for (const auto& root : THEME.roots) {
+                auto path = root + "/" + THEME.directories[d].name;
+                m_locations.emplace_back(SLocation{.path = path, .mtime = mtimeOf(path), .theme = t, .directory = d});
+            }
+        }
+    }
+
+    for (const auto& base : m_baseDirs) {
+        m_locations.emplace_back(SLocation{.path = base, .mtime = mtimeOf(base), .theme = UNTHEMED});
+    }
+}
+
+void CIconThemeIndex::scan() {
+    for (uint32_t i = 0; i < m_locations.size(); ++i) {
+        if (m_locations[i].mtime == 0)
+            continue;
+
+        std::error_code ec;
+        for (auto it = std::filesystem::directory_iterator(m_locations[i].path, ec); !ec && it != std::filesystem::directory_iterator(); it.increment(ec)) {
+            const auto FORMAT = formatOf(it->path().extension().string());
+            if (!FORMAT)
+                continue;
+
+            std::error_code ec2;
+            if (it->is_directory(ec2))
+                continue;
+
+            m_icons[it->path().stem().string()].emplace_back(SEntry{.location = i, .format = *FORMAT});
+        }
+    }
+
+    // listing order is whatever the filesystem likes, lookups need the spec's
+    for (auto& [name, entries] : m_icons) {
+        std::ranges::sort(entries, [](const auto& a, const auto& b) { return a.location != b.location ? a.location < b.location : a.format < b.format; });
+    }
+}
+
+std::string CIconThemeIndex::cacheFile() const {
+    std::string id;
+    for (const auto& t : m_themes) {
+        id += t.name + "\n";
+    }
+
+    for (const auto& b : m_baseDirs) {
+        id += b + "\n";
+    }
+
+    return std::format("{}/{:016x}.idx", m_cacheDir, Hash::xxh64(id.data(), id.size()));
+}
+
+bool CIconThemeIndex::loadCache() {
+    if (m_cacheDir.empty())
+        return false;
+
+    std::ifstream in(cacheFile());
+    if (!in.good())
+        return false;
+
+    std::string line;
+    if (!std::getline(in, line) || line != CACHE_MAGIC)
+        return false;
+
+    // only good for as long as every directory is still exactly what was listed
+    size_t locations = 0;
+    if (!(in >> locations) || locations != m_locations.size())
+        return false;
+
+    for (const auto& l : m_locations) {
+        uint64_t    mtime = 0;
+        std::string path;
+
+        in >> mtime;
+        in.get();
+        std::getline(in, path);
+
+        if (!in || mtime != l.mtime || path != l.path)
+            return false;
+    }
+
+    size_t entries = 0;
+    if (!(in >> entries))
+        return false;
+
+    std::unordered_map<std::string, std::vector<SEntry>> icons;
+
+    for (size_t i = 0; i < entries; ++i) {
+        uint32_t    location = 0, format = 0;
+        std::string name;
+
+        in >> location >> format;
+        in.get();
+        std::getline(in, name);
+
+        if (!in || location >= m_locations.size() || format > ICON_FORMAT_SVG)
+            return false;
+
+        icons[name].emplace_back(SEntry{.location = location, .format = sc<eIconFormat>(format)});
+    }
+
+    m_icons     = std::move(icons);
+    m_fromCache = true;
+    return true;
+}
+
+void CIconThemeIndex::saveCache() const {
+    if (m_cacheDir.empty())
+        return;
+
+    std::error_code ec;
+    std::filesystem::create_directories(m_cacheDir, ec);
+    if (ec)
+        return;
+
+    const auto PATH = cacheFile();
+    const auto TMP  = std::format("{}.{}.tmp", PATH, getpid());
+
+    {
+        std::ofstream out(TMP, std::ios::trunc);
+        if (!out.good())
+            return;
+
+        out << CACHE_MAGIC << "\n" << m_locations.size() << "\n";
+
+        for (const auto& l : m_locations) {
+            out << l.mtime << " " << l.path << "\n";
+        }
+
+        size_t entries = 0;
+        for (const auto& [name, e] : m_icons) {
+            entries += e.size();
+        }
+
+        out << entries << "\n";
+
+        for (const auto& [name, e] : m_icons) {
+            for (const auto& entry : e) {
+                out << entry.location << " " << sc<uint32_t>(entry.format) << " " << name << "\n";
+            }
+        }
+
+        if (!out.good()) {
+            out.close();
+            std::filesystem::remove(TMP, ec);
+            return;
+        }
+    }
+
+    // readers only ever see a complete one
+    std::filesystem::rename(TMP, PATH, ec);
+    if (ec)
+        std::filesystem::remove(TMP, ec);
+}
+
+void CIconThemeIndex::plantWatches() {
+    if (!m_inotifyFd.isValid())
+        return;
+
+    for (const auto& w : m_watches) {
+        inotify_rm_watch(m_inotifyFd.get(), w);
+    }
+
+    m_watches.clear();
+
+    const auto WATCH = [this](const std::string& path) {
+        const int WD = inotify_add_watch(m_inotifyFd.get(), path.c_str(), WATCH_MASK);
+        if (WD >= 0)
+            m_watches.emplace_back(WD);
+    };
+
+    // base dirs for themes getting installed, roots for index.theme changing. Not the icon dirs, a few big
+    // themes have thousands of them, which would use up the user's watches. See lookup.
+    for (const auto& base : m_baseDirs) {
+        WATCH(base);
+    }
+
+    for (const auto& t : m_themes) {
+        for (const auto& root : t.roots) {
+            WATCH(root);
+        }
+    }
+}
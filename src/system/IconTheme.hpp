@@ -0,0 +1,127 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <hyprutils/os/FileDescriptor.hpp>
+
+namespace Hyprtoolkit {
+
+    enum eIconDirectoryType : uint8_t {
+        ICON_DIRECTORY_FIXED = 0,
+        ICON_DIRECTORY_SCALABLE,
+        ICON_DIRECTORY_THRESHOLD,
+    };
+
+    // in the order the spec prefers them within a directory
+    enum eIconFormat : uint8_t {
+        ICON_FORMAT_PNG = 0,
+        ICON_FORMAT_SVG,
+    };
+
+    // a subdirectory of a theme, as its index.theme describes it
+    struct SIconDirectory {
+        std::string        name;
+        int                size = 0, scale = 1, minSize = 0, maxSize = 0, threshold = 2;
+        eIconDirectoryType type = ICON_DIRECTORY_THRESHOLD;
+
+        bool               matchesSize(int iconSize, int iconScale) const;
+        int                sizeDistance(int iconSize, int iconScale) const;
+    };
+
+    struct SIconFile {
+        std::string                   path;
+        eIconFormat                   format = ICON_FORMAT_PNG;
+        std::optional<SIconDirectory> directory; // empty for the unthemed fallbacks
+    };
+
+    // Index of an icon theme, everything it inherits and hicolor, in the spec's lookup order, followed by
+    // the unthemed fallbacks. Every directory of those is listed once when it's built, after which a lookup
+    // is a single map access. The listing can be persisted, it's used again for as long as none of the
+    // directories changed. The base dirs and theme roots are watched, and a change there rebuilds the index
+    // on the next lookup. The icon dirs are only checked by a lookup that misses, at most every RECHECK_INTERVAL.
+    class CIconThemeIndex {
+      public:
+        static constexpr std::chrono::milliseconds RECHECK_INTERVAL{1000};
+
+        // an empty theme picks the system's default. An empty cacheDir doesn't persist anything.
+        CIconThemeIndex(const std::string& theme, std::vector<std::string> baseDirs = defaultBaseDirs(), std::string cacheDir = "");
+        ~CIconThemeIndex() = default;
+
+        CIconThemeIndex(const CIconThemeIndex&) = delete;
+        CIconThemeIndex(CIconThemeIndex&)       = delete;
+        CIconThemeIndex(CIconThemeIndex&&)      = delete;
+
+        // $HOME/.icons, $XDG_DATA_HOME/icons, $XDG_DATA_DIRS/icons and /usr/share/pixmaps
+        static std::vector<std::string> defaultBaseDirs();
+        static std::string              defaultCacheDirectory();
+
+        // the first of files to use for size logical pixels at scale, per the spec. nullptr if files is empty.
+        static const SIconFile*         bestFile(const std::vector<SIconFile>& files, int size, int scale);
+
+        // every file of the icon in the first theme that has it, or in the fallbacks if none does
+        std::vector<SIconFile>          lookup(const std::string& name);
+
+        // searched in this order. Empty if not even hicolor is installed.
+        std::vector<std::string>        themes() const;
+        size_t                          icons() const;
+        bool                            loadedFromCache() const;
+
+        // readable once something in the themes changed, -1 if nothing is watched
+        int                             watchFD() const;
+        void                            onWatchEvent();
+
+        // rebuilds on the next lookup
+        void                            invalidate();
+
+      private:
+        struct STheme {
+            std::string                 name;
+            std::vector<std::string>    roots; // the theme's dir in every base dir that has it
+            std::vector<SIconDirectory> directories;
+        };
+
+        // a directory that gets listed
+        struct SLocation {
+            std::string path;
+            uint64_t    mtime     = 0; // 0 if it doesn't exist
+            uint32_t    theme     = 0;
+            uint32_t    directory = 0;
+        };
+
+        struct SEntry {
+            uint32_t    location = 0;
+            eIconFormat format   = ICON_FORMAT_PNG;
+        };
+
+        void                                                 rebuild();
+        bool                                                 locationsChanged() const;
+        bool                                                 themeExists(const std::string& name) const;
+        std::string                                          resolveDefaultTheme() const;
+        void                                                 addTheme(const std::string& name, size_t depth);
+        void                                                 collectLocations();
+        void                                                 scan();
+        bool                                                 loadCache();
+        void                                                 saveCache() const;
+        std::string                                          cacheFile() const;
+        void                                                 plantWatches();
+
+        std::string                                          m_requestedTheme;
+        std::vector<std::string>                             m_baseDirs;
+        std::string                                          m_cacheDir;
+
+        std::vector<STheme>                                  m_themes;
+        std::vector<SLocation>                               m_locations; // in lookup order, unthemed last
+        std::unordered_map<std::string, std::vector<SEntry>> m_icons;     // entries in lookup order
+
+        bool                                                 m_dirty = true, m_fromCache = false;
+        std::chrono::steady_clock::time_point                m_lastRecheck;
+
+        Hyprutils::OS::CFileDescriptor                       m_inotifyFd;
+        std::vector<int>                                     m_watches;
+    };
+};
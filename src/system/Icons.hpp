@@ -2,7 +2,9 @@
 
 #include <hyprtoolkit/system/Icons.hpp>
 
-#include <optional>
+#include "IconTheme.hpp"
+#include "../helpers/Memory.hpp"
+
 #include <vector>
 
 namespace Hyprtoolkit {
@@ -14,11 +16,15 @@ namespace Hyprtoolkit {
         CSystemIconDescription(const std::string& name);
         virtual ~CSystemIconDescription() = default;
 
-        virtual bool exists();
-        virtual bool scalable();
+        virtual bool           exists();
+        virtual bool           scalable();
+
+        // the file to draw it from at size logical pixels, scale times that on screen
+        std::string            pathFor(int size, int scale) const;
 
-        std::string  m_bestPath = "";
-        bool         m_scalable = false;
+        std::string            m_bestPath = ""; // for when the size isn't known
+        bool                   m_scalable = false;
+        std::vector<SIconFile> m_files;
     };
 
     class CSystemIconFactory : public ISystemIconFactory {
@@ -33,8 +39,7 @@ namespace Hyprtoolkit {
         virtual Hyprutils::Memory::CSharedPointer<ISystemIconDescription> lookupIcon(const std::string& iconName);
 
       private:
-        std::optional<std::string> m_themeDir;
-        std::vector<std::string>   m_iconDirs;
+        UP<CIconThemeIndex> m_index;
 
         friend class CSystemIconDescription;
     };
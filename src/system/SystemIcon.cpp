@@ -1,49 +1,28 @@
 #include "Icons.hpp"
 #include "../core/InternalBackend.hpp"
 
-#include <filesystem>
+#include <algorithm>
 
 using namespace Hyprtoolkit;
 
+// for m_bestPath, which is used when the size isn't known
+constexpr int DEFAULT_ICON_SIZE = 48;
+
 CSystemIconDescription::CSystemIconDescription() {
     ;
 }
 
 CSystemIconDescription::CSystemIconDescription(const std::string& name) {
-    if (g_iconFactory->m_iconDirs.empty())
+    if (!g_iconFactory || !g_iconFactory->m_index)
         return;
 
-    const auto THEME_DIR = g_iconFactory->m_themeDir.value();
-
-    bool       found = false;
-
-    for (const auto& sd : g_iconFactory->m_iconDirs) {
-        auto fullDirPath = THEME_DIR + "/";
-        fullDirPath += sd;
-
-        std::error_code ec;
-        if (!std::filesystem::exists(fullDirPath, ec) || ec)
-            continue;
-
-        auto iconPath = fullDirPath + "/";
-        iconPath += name + ".svg"; // FUCK them raster themes in the year of our Lord 2025
+    m_files = g_iconFactory->m_index->lookup(name);
 
-        if (!std::filesystem::exists(iconPath, ec) || ec)
-            continue;
-
-        m_bestPath = iconPath;
-        found      = true;
-        break;
-    }
+    if (m_files.empty())
+        return;
 
-    if (!found) {
-        // try /usr/share/pixmaps
-        std::error_code ec;
-        if (std::filesystem::exists("/usr/share/pixmaps/" + name + ".svg", ec) || ec) {
-            found      = true;
-            m_bestPath = "/usr/share/pixmaps/" + name + ".svg";
-        }
-    }
+    m_scalable = std::ranges::any_of(m_files, [](const auto& f) { return f.format == ICON_FORMAT_SVG || (f.directory && f.directory->type == ICON_DIRECTORY_SCALABLE); });
+    m_bestPath = pathFor(DEFAULT_ICON_SIZE, 1);
 }
 
 bool CSystemIconDescription::exists() {
@@ -52,4 +31,9 @@ bool CSystemIconDescription::exists() {
 
 bool CSystemIconDescription::scalable() {
     return m_scalable;
-}
\ No newline at end of file
+}
+
+std::string CSystemIconDescription::pathFor(int size, int scale) const {
+    const auto BEST = CIconThemeIndex::bestFile(m_files, size, std::max(1, scale));
+    return BEST ? BEST->path : m_bestPath;
+}
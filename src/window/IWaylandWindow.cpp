@@ -49,6 +49,9 @@ bool CWaylandBuffer::good() {
 }
 
 void IWaylandWindow::onScaleUpdate() {
+    // sizes of what's rastered depend on the scale
+    m_rootElement->impl->breadthfirst([](SP<IElement> e) { e->impl->resetMeasureCache(); });
+
     configure(m_waylandState.logicalSize, m_waylandState.serial);
 }
 
@@ -65,6 +68,7 @@ void IWaylandWindow::configure(const Vector2D& size, uint32_t serial) {
     damageEntire();
 
     m_rootElement->reposition({0, 0, m_waylandState.logicalSize.x, m_waylandState.logicalSize.y});
+    invalidateHover();
 }
 
 void IWaylandWindow::resizeSwapchain(const Vector2D& pixelSize) {
@@ -85,6 +89,8 @@ void IWaylandWindow::resizeSwapchain(const Vector2D& pixelSize) {
 }
 
 void IWaylandWindow::onPreRender() {
+    // hover first, scrolling goes to what's under the pointer
+    flushMotion();
 
     const bool ANY_REPOSITION = !m_needsReposition.empty();
 
@@ -101,6 +107,10 @@ void IWaylandWindow::onPreRender() {
 
     CRegion rg;
     for (const auto& ch : m_rootElement->impl->children) {
+        // may be faded or moved off of its box at any frame, without a reposition
+        if (ch->impl->renderTransform)
+            continue;
+
         auto opaque = ch->opaqueBox();
 
         if (opaque.empty())
@@ -168,18 +178,25 @@ void IWaylandWindow::render() {
     auto currentBuffer    = m_waylandState.wlBuffers[m_waylandState.bufIdx];
     m_waylandState.bufIdx = (m_waylandState.bufIdx + 1) % 2;
 
+    // the other one has the last frame, if it has been rendered to since it was made
+    const auto PREVIOUS = m_waylandState.wlBuffers[m_waylandState.bufIdx];
+    const bool CAN_COPY = PREVIOUS && PREVIOUS->m_hasFrame;
+
     onPreRender();
 
     if (!currentBuffer)
         return;
 
+    prepareScrollCopies(CAN_COPY);
+
     m_needsFrame = false;
 
-    g_renderer->beginRendering(m_self.lock(), currentBuffer->m_buffer.lock());
+    g_renderer->beginRendering(m_self.lock(), currentBuffer->m_buffer.lock(), CAN_COPY ? PREVIOUS->m_buffer.lock() : SP<Aquamarine::IBuffer>{});
 
     prepareExplicit(currentBuffer);
 
     g_renderer->render(currentBuffer->m_firstTimeIgnoreSync);
+    currentBuffer->m_hasFrame = true;
 
     m_waylandState.frameCallback = makeShared<CCWlCallback>(m_waylandState.surface->sendFrame());
     m_waylandState.frameCallback->setDone([this](CCWlCallback* r, uint32_t frameTime) { onCallback(); });
@@ -205,12 +222,15 @@ void IWaylandWindow::render() {
         m_lastFrame = std::chrono::steady_clock::now();
     }
 
-    m_needsFrame = m_needsFrame || g_animationManager->shouldTickForNext();
+    m_needsFrame = m_needsFrame || g_animationManager->shouldTickForNext() || !m_pendingRasters.empty() || m_kineticScroll.active();
 }
 
 void IWaylandWindow::onCallback() {
     m_waylandState.frameCallback.reset();
 
+    // might need a frame
+    flushMotion();
+
     if (m_needsFrame)
         render();
 }
@@ -235,6 +255,9 @@ SP<IWindow> IWaylandWindow::openPopup(const SWindowCreationData& data) {
 }
 
 void IWaylandWindow::mouseButton(const Input::eMouseButton button, bool state) {
+    // where it was clicked
+    flushMotion();
+
     if (m_popups.empty() || !state || m_ignoreNextButtonEvent) {
         m_ignoreNextButtonEvent = false;
         IToolkitWindow::mouseButton(button, state);
@@ -255,7 +278,36 @@ void IWaylandWindow::mouseMove(const Hyprutils::Math::Vector2D& local) {
     if (!m_popups.empty())
         return;
 
-    IToolkitWindow::mouseMove(local);
+    m_pendingMotion = local;
+
+    // a frame on its way handles it once it's done, see onCallback. Otherwise, once the events that came in with it are
+    if (m_waylandState.frameCallback || m_motionFlushScheduled)
+        return;
+
+    m_motionFlushScheduled = true;
+    g_backend->addIdle([this, self = m_self] {
+        if (!self)
+            return;
+
+        m_motionFlushScheduled = false;
+        flushMotion();
+    });
+}
+
+void IWaylandWindow::flushMotion() {
+    if (!m_pendingMotion)
+        return;
+
+    const auto POS = *m_pendingMotion;
+    m_pendingMotion.reset();
+
+    IToolkitWindow::mouseMove(POS);
+}
+
+void IWaylandWindow::mouseLeave() {
+    m_pendingMotion.reset();
+
+    IToolkitWindow::mouseLeave();
 }
 
 void IWaylandWindow::mouseAxis(const Input::eAxisAxis axis, float delta) {
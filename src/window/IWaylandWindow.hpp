@@ -31,6 +31,7 @@ namespace Hyprtoolkit {
         bool              m_pendingRelease = false;
         SP<CSyncTimeline> m_timeline;
         bool              m_firstTimeIgnoreSync = true;
+        bool              m_hasFrame            = false; // was rendered to, so has a whole frame in it
 
         struct {
             SP<CCWlBuffer>                    buffer;
@@ -52,6 +53,7 @@ namespace Hyprtoolkit {
         virtual void                      mouseMove(const Hyprutils::Math::Vector2D& local);
         virtual void                      mouseButton(const Input::eMouseButton button, bool state);
         virtual void                      mouseAxis(const Input::eAxisAxis axis, float delta);
+        virtual void                      mouseLeave();
         virtual void                      setIMTo(const Hyprutils::Math::CBox& box, const std::string& str, size_t cursor);
         virtual void                      resetIM();
         virtual void                      onPreRender();
@@ -67,11 +69,18 @@ namespace Hyprtoolkit {
         void         prepareExplicit(SP<CWaylandBuffer>);
         void         submitExplicit(SP<CWaylandBuffer>);
 
+        // handles the last motion that came in, if any did since
+        void         flushMotion();
+
         float        m_fractionalScale = 1.0;
 
         bool         m_open                  = false;
         bool         m_ignoreNextButtonEvent = false;
 
+        // motion is handled once a frame, only where the pointer ended up matters
+        std::optional<Hyprutils::Math::Vector2D> m_pendingMotion;
+        bool                                     m_motionFlushScheduled = false;
+
         struct {
             SP<CCWlSurface>                         surface;
             SP<CCXdgSurface>                        xdgSurface;
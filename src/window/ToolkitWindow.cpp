@@ -6,13 +6,21 @@
 #include "../element/Element.hpp"
 #include "../element/text/Text.hpp"
 #include "../element/rectangle/Rectangle.hpp"
+#include "../renderer/TextureRegistry.hpp"
 #include "../Macros.hpp"
 
 #include <hyprtoolkit/core/Timer.hpp>
 
 #include <algorithm>
+#include <chrono>
+#include <unordered_set>
+#include <utility>
 
 using namespace Hyprtoolkit;
+using namespace Hyprutils::Math;
+
+// main thread time spent on pending rasters per frame, the rest is left stretched for the next ones
+constexpr std::chrono::microseconds RASTER_FRAME_BUDGET{4000};
 
 struct Hyprtoolkit::SToolkitWindowData {
     void         lock(const Hyprutils::Math::Vector2D& coord = {});
@@ -46,9 +54,19 @@ SToolkitFocusLock::~SToolkitFocusLock() {
         m_el->impl->toolkitWindowData->unlock();
 }
 
+IToolkitWindow::~IToolkitWindow() {
+    textureRegistry()->forgetOwner(this);
+}
+
 void IToolkitWindow::damage(Hyprutils::Math::CRegion&& rg) {
     rg.scale(scale());
 
+    if (g_backend->batching()) {
+        m_batch.damage.add(rg);
+        g_backend->batched(m_self);
+        return;
+    }
+
     if (m_damageRing.damage(std::move(rg)))
         scheduleFrame();
 }
@@ -59,7 +77,168 @@ void IToolkitWindow::damageEntire() {
     scheduleFrame();
 }
 
+// what of e shows, inside every parent clipping it and the window
+static CBox visibleBox(SP<IElement> e, const Vector2D& windowSize) {
+    CBox box = e->impl->position.intersection({{}, windowSize});
+
+    for (auto parent = e->impl->parent; parent; parent = parent->impl->parent) {
+        if (parent->impl->clipChildren)
+            box = box.intersection(parent->impl->position);
+    }
+
+    return box;
+}
+
+// the order elements are painted in, see COpenGLRenderer::renderBreadthfirst
+static void paintOrder(SP<IElement> e, std::vector<SP<IElement>>& order, std::unordered_set<IElement*>& seen) {
+    e->impl->breadthfirst([&order, &seen](SP<IElement> el) {
+        if (!seen.emplace(el.get()).second)
+            return;
+
+        order.emplace_back(el);
+
+        if (el->impl->clipChildren || el->impl->grouped || el->impl->transformed())
+            paintOrder(el, order, seen);
+    });
+}
+
+static bool isInside(SP<IElement> e, SP<IElement> ancestor) {
+    for (auto p = e; p; p = p->impl->parent.lock()) {
+        if (p == ancestor)
+            return true;
+    }
+
+    return false;
+}
+
+CBox SScrollCopy::copyTo(float scale) const {
+    return box.copy().intersection(box.copy().translate(delta)).scale(scale).round();
+}
+
+CBox SScrollCopy::copyFrom(float scale) const {
+    return copyTo(scale).translate(-(delta * scale).round());
+}
+
+void IToolkitWindow::damageScroll(SP<IElement> e, const Vector2D& delta) {
+    // moved out from under the pointer
+    invalidateHover();
+
+    const auto BOX = visibleBox(e, pixelSize() / scale());
+    if (BOX.empty())
+        return;
+
+    // held back by a batch, it has to move along as well
+    if (!m_batch.damage.empty())
+        m_damageRing.damage(std::exchange(m_batch.damage, CRegion{}));
+
+    // whatever was stale in there moved with the rest
+    m_damageRing.scroll(BOX.copy().scale(scale()), delta * scale());
+
+    auto copy = std::ranges::find_if(m_scrollCopies, [&e](const auto& c) { return c.element.lock() == e; });
+    if (copy == m_scrollCopies.end())
+        m_scrollCopies.emplace_back(SScrollCopy{.element = e, .box = BOX, .delta = delta});
+    else if (copy->box == BOX)
+        copy->delta += delta;
+    else {
+        // moved itself since, nothing to copy
+        m_scrollCopies.erase(copy);
+        damage(CRegion{BOX});
+        return;
+    }
+
+    // what came into view
+    CRegion exposed{BOX};
+    exposed.subtract(BOX.copy().translate(delta));
+    damage(std::move(exposed));
+}
+
+void IToolkitWindow::prepareScrollCopies(bool canCopy) {
+    if (m_scrollCopies.empty())
+        return;
+
+    const auto                    SCALE = scale();
+
+    std::vector<SP<IElement>>     order;
+    std::unordered_set<IElement*> seen;
+
+    const auto                    COPYABLE = [&](const SScrollCopy& c) {
+        if (!canCopy || !c.element)
+            return false;
+
+        // pixels can only move by whole pixels
+        const auto PIXELS = c.delta * SCALE;
+        if (PIXELS != PIXELS.round())
+            return false;
+
+        // moved or resized since, or copying over another one
+        const auto EL = c.element.lock();
+        if (visibleBox(EL, pixelSize() / SCALE) != c.box || std::ranges::count_if(m_scrollCopies, [&c](const auto& o) { return o.box.overlaps(c.box); }) > 1)
+            return false;
+
+        // not drawn where it's laid out
+        if (!EL->impl->drawTransform().identity())
+            return false;
+
+        if (order.empty())
+            paintOrder(m_rootElement, order, seen);
+
+        const auto IT = std::ranges::find(order, EL);
+        if (IT == order.end())
+            return false;
+
+        // what's behind it got copied along, so it has to look the same everywhere: nothing, or an opaque rectangle
+        for (auto behind = std::make_reverse_iterator(IT); behind != order.rend(); ++behind) {
+            const auto& B     = *behind;
+            const auto  DRAWN = B->impl->drawTransform();
+            if (B->impl->paintsNothing || !DRAWN.bounds(B->impl->position).overlaps(c.box))
+                continue;
+
+            if (!DRAWN.identity() || B->opaqueBox().translate(B->impl->position.pos()).intersection(c.box) != c.box)
+                return false;
+
+            break;
+        }
+
+        // what's painted over it got copied along too, it's painted again where it was and where it went
+        for (auto over = IT + 1; over != order.end(); ++over) {
+            const auto& O     = *over;
+            const auto  DRAWN = O->impl->drawTransform().bounds(O->impl->position);
+            if (!DRAWN.overlaps(c.box) || isInside(O, EL))
+                continue;
+
+            const auto WAS = DRAWN.intersection(c.box);
+            CRegion    rg{WAS};
+            rg.add(WAS.copy().translate(c.delta).intersection(c.box));
+            damage(std::move(rg));
+        }
+
+        return true;
+    };
+
+    std::erase_if(m_scrollCopies, [&](const SScrollCopy& c) {
+        if (COPYABLE(c))
+            return false;
+
+        damage(CRegion{c.box});
+        return true;
+    });
+}
+
+void IToolkitWindow::endBatch() {
+    CRegion    rg    = std::exchange(m_batch.damage, CRegion{});
+    const bool FRAME = std::exchange(m_batch.frame, false);
+
+    if (m_damageRing.damage(std::move(rg)) || FRAME)
+        scheduleFrame();
+}
+
 void IToolkitWindow::scheduleFrame() {
+    if (g_backend->batching()) {
+        m_batch.frame = true;
+        g_backend->batched(m_self);
+        return;
+    }
+
     m_needsFrame = true;
 
     if (m_scheduledRender) {
@@ -82,62 +261,108 @@ void IToolkitWindow::scheduleFrame() {
 }
 
 void IToolkitWindow::onPreRender() {
+    applyScroll();
+
     g_animationManager->tick();
 
-    // simplify repositions: step 1, expand ancestors
-    for (auto& e : m_needsReposition) {
-        if (!e)
-            continue;
-        while (e->impl->parent && e->impl->parent->positioningDependsOnChild()) {
-            e = e->impl->parent;
-        }
-    }
+    layoutPending();
 
-    // step 2: many will be repeated. Only calculate those that don't have any parent above already
-    // scheduled
-    std::erase_if(m_needsReposition, [this](WP<IElement> e) {
-        if (!e)
-            return true;
+    runPendingRasters();
 
-        while (e->impl->parent) {
-            if (std::ranges::find(m_needsReposition, e->impl->parent) != m_needsReposition.end())
-                return true;
+    // rasters can change sizes
+    layoutPending();
+}
 
-            e = e->impl->parent.lock();
-        }
+void IToolkitWindow::layoutPending() {
+    if (m_needsReposition.empty())
+        return;
 
-        return false;
-    });
+    // anything laid out might schedule more, that's for the next round
+    const auto CHANGED = std::move(m_needsReposition);
+    m_needsReposition.clear();
 
-    // step 3: eliminate same-parent nodes
-    // since repositionNeeded will reposition the parent's children,
-    // we don't need to do it 200 times if the parent has 200 children and all need a reposition
-    std::vector<WP<IElement>> parents;
-    parents.reserve(m_needsReposition.size());
-    std::erase_if(m_needsReposition, [&parents](WP<IElement> e) {
-        if (std::ranges::contains(parents, e->impl->parent))
-            return true;
+    g_positioner->relayout(CHANGED);
 
-        parents.emplace_back(e->impl->parent);
-        return false;
-    });
+    invalidateHover();
+}
 
-    for (const auto& e : m_needsReposition) {
-        g_positioner->repositionNeeded(e.lock());
-    }
-    m_needsReposition.clear();
+void IToolkitWindow::scheduleReposition(WP<IElement> e) {
+    if (!e)
+        return;
 
-    if (m_needsReposition.empty())
+    // whatever changed might change its size, and has to be painted again
+    e->impl->invalidateMeasure();
+    if (e->impl->positionerData)
+        e->impl->positionerData->scrolled = false;
+
+    if (e->impl->needsLayout)
         return;
 
-    g_positioner->position(m_rootElement, {{}, pixelSize() / scale()});
+    e->impl->needsLayout = true;
+    m_needsReposition.emplace_back(e);
+    scheduleFrame();
 }
 
-void IToolkitWindow::scheduleReposition(WP<IElement> e) {
-    m_needsReposition.emplace_back(e);
+void IToolkitWindow::scheduleRaster(WP<IElement> e, std::function<void()>&& fn) {
+    m_pendingRasters.emplace_back(SPendingRaster{.element = e, .fn = std::move(fn)});
     scheduleFrame();
 }
 
+bool IToolkitWindow::isElementVisible(SP<IElement> e, double margin) {
+    const auto& BOX = e->impl->position;
+
+    if (!BOX.overlaps(Hyprutils::Math::CBox{{}, pixelSize() / scale()}.expand(margin)))
+        return false;
+
+    for (auto parent = e->impl->parent; parent; parent = parent->impl->parent) {
+        if (parent->impl->clipChildren && !BOX.overlaps(parent->impl->position.copy().expand(margin)))
+            return false;
+    }
+
+    return true;
+}
+
+void IToolkitWindow::runPendingRasters() {
+    if (m_pendingRasters.empty())
+        return;
+
+    // rasters can queue more, so work on our own copy
+    auto pending = std::move(m_pendingRasters);
+    m_pendingRasters.clear();
+
+    std::erase_if(pending, [](const auto& r) { return !r.element; });
+
+    for (auto& r : pending) {
+        r.visible = isElementVisible(r.element.lock());
+        r.area    = r.element->impl->position.w * r.element->impl->position.h;
+    }
+
+    // visible first, and the bigger the element, the more obvious the blur
+    std::ranges::stable_sort(pending, [](const auto& a, const auto& b) {
+        if (a.visible != b.visible)
+            return a.visible;
+        return a.area > b.area;
+    });
+
+    const auto BEGIN = std::chrono::steady_clock::now();
+    size_t     done  = 0;
+
+    // always do at least one, so that a slow raster can't stall convergence
+    while (done < pending.size() && (done == 0 || std::chrono::steady_clock::now() - BEGIN < RASTER_FRAME_BUDGET)) {
+        auto& r  = pending[done++];
+        auto  el = r.element.lock();
+
+        if (!el)
+            continue;
+
+        r.fn();
+    }
+
+    TRACE(g_logger->log(HT_LOG_TRACE, "rasters: {} done this frame, {} left", done, pending.size() - done));
+
+    m_pendingRasters.insert(m_pendingRasters.end(), std::make_move_iterator(pending.begin() + done), std::make_move_iterator(pending.end()));
+}
+
 void IToolkitWindow::initElementIfNeeded(SP<IElement> e) {
     if (e->impl->toolkitWindowData)
         return;
@@ -149,29 +374,70 @@ void IToolkitWindow::initElementIfNeeded(SP<IElement> e) {
 void IToolkitWindow::updateFocus(const Hyprutils::Math::Vector2D& coords) {
     m_mousePos = coords;
 
+    // still over the same elements, nothing to resolve
+    if (m_hoverCache.valid && (!m_mainHoverElement || m_mainHoverElement->m_el) && m_hoverCache.under.containsPoint(coords) &&
+        std::ranges::none_of(m_hoverCache.others, [&coords](const CBox& box) { return box.containsPoint(coords); })) {
+        if (m_pointerFn)
+            setCursor(m_pointerFn());
+        return;
+    }
+
     SP<IElement>                       el;
     std::vector<SP<SToolkitFocusLock>> alwaysHover;
-    m_rootElement->impl->breadthfirst([this, &el, &alwaysHover, coords](SP<IElement> current) {
-        if (current->acceptsMouseInput() && current->impl->position.containsPoint(coords)) {
-            // check for any parent being a clip
-            auto parent = current->impl->parent;
-            while (parent) {
-                if (parent->impl->clipChildren && !parent->impl->position.containsPoint(coords))
-                    return; // nope
-
-                parent = parent->impl->parent;
+
+    // what of each element takes input, inside its clipping parents
+    std::vector<CBox> under, others;
+
+    // breadth first, like breadthfirst(), carrying what the clipping parents leave of each level
+    std::vector<std::pair<SP<IElement>, std::optional<CBox>>> level = {{m_rootElement, std::nullopt}};
+    while (!level.empty()) {
+        std::vector<std::pair<SP<IElement>, std::optional<CBox>>> next;
+
+        for (const auto& [current, clip] : level) {
+            const auto& POS = current->impl->position;
+
+            if (current->acceptsMouseInput()) {
+                const auto BOX = clip ? POS.intersection(*clip) : POS;
+
+                if (BOX.containsPoint(coords)) {
+                    el = current;
+                    under.emplace_back(BOX);
+                    if (current->alwaysGetMouseInput()) {
+                        initElementIfNeeded(el);
+                        alwaysHover.emplace_back(makeShared<SToolkitFocusLock>(el, coords - el->impl->position.pos()));
+                    }
+                } else if (!BOX.empty())
+                    others.emplace_back(BOX);
             }
-            el = current;
-            if (current->alwaysGetMouseInput()) {
-                initElementIfNeeded(el);
-                alwaysHover.emplace_back(makeShared<SToolkitFocusLock>(el, coords - el->impl->position.pos()));
+
+            std::optional<CBox> childClip = clip;
+            if (current->impl->clipChildren)
+                childClip = clip ? clip->intersection(POS) : POS;
+
+            for (const auto& c : current->impl->children) {
+                next.emplace_back(c, childClip);
             }
         }
-    });
+
+        level = std::move(next);
+    }
 
     m_hoveredElements = alwaysHover;
 
+    // only what overlaps all of under matters
+    CBox stable = m_rootElement->impl->position;
+    for (const auto& box : under) {
+        stable = stable.intersection(box);
+    }
+    std::erase_if(others, [&stable](const CBox& box) { return box.intersection(stable).empty(); });
+
+    m_hoverCache = {.under = stable, .others = std::move(others), .valid = stable.containsPoint(coords)};
+
     if ((el == (m_mainHoverElement ? m_mainHoverElement->m_el : WP<IElement>{})) || m_mouseIsDown /* Lock focus while mouse is down */) {
+        // locked on what was under it, this has to be resolved again once released
+        if (el != (m_mainHoverElement ? m_mainHoverElement->m_el : WP<IElement>{}))
+            m_hoverCache.valid = false;
+
         if (m_pointerFn)
             setCursor(m_pointerFn());
         return;
@@ -211,7 +477,12 @@ void IToolkitWindow::updateFocus(const Hyprutils::Math::Vector2D& coords) {
         m_tooltip.hoverTooltipTimer.reset();
 }
 
+void IToolkitWindow::invalidateHover() {
+    m_hoverCache.valid = false;
+}
+
 void IToolkitWindow::mouseEnter(const Hyprutils::Math::Vector2D& local) {
+    invalidateHover();
     updateFocus(local);
 
     if (m_mainHoverElement && m_mainHoverElement->m_el)
@@ -246,7 +517,14 @@ void IToolkitWindow::mouseMove(const Hyprutils::Math::Vector2D& local) {
 void IToolkitWindow::mouseButton(const Input::eMouseButton button, bool state) {
     m_mouseIsDown = state;
 
+    // a release unlocks the focus, see updateFocus
+    if (!state)
+        invalidateHover();
+
     if (state) {
+        // a click catches a fling
+        m_kineticScroll.cancel();
+
         if (m_mainHoverElement && m_mainHoverElement->m_el && m_mainHoverElement->m_el->acceptsKeyboardInput() && m_keyboardFocus != m_mainHoverElement->m_el) {
             // enter this element
             if (m_keyboardFocus)
@@ -282,7 +560,32 @@ void IToolkitWindow::mouseAxis(const Input::eAxisAxis axis, float delta) {
     }
 }
 
+void IToolkitWindow::mouseAxisFrame(const Input::SAxisFrame& frame) {
+    if (frame.delta != Vector2D{})
+        m_kineticScroll.push(frame.delta, frame.time, frame.finger);
+
+    if (frame.stop)
+        m_kineticScroll.lift(frame.time);
+
+    if (m_kineticScroll.active())
+        scheduleFrame();
+}
+
+void IToolkitWindow::applyScroll() {
+    if (!m_kineticScroll.active())
+        return;
+
+    const auto DELTA = m_kineticScroll.frame();
+
+    if (DELTA.x != 0)
+        mouseAxis(Input::AXIS_AXIS_HORIZONTAL, DELTA.x);
+    if (DELTA.y != 0)
+        mouseAxis(Input::AXIS_AXIS_VERTICAL, DELTA.y);
+}
+
 void IToolkitWindow::mouseLeave() {
+    invalidateHover();
+    m_kineticScroll.cancel();
     m_mainHoverElement.reset();
     m_hoveredElements.clear();
 }
@@ -326,6 +629,10 @@ Hyprutils::Math::Vector2D IToolkitWindow::cursorPos() {
     return m_mousePos;
 }
 
+size_t IToolkitWindow::gpuBytes() {
+    return textureRegistry()->bytesFor(this);
+}
+
 void IToolkitWindow::openTooltip(const std::string& s, const Hyprutils::Math::Vector2D& pos) {
     if (m_tooltip.tooltipPopup)
         return;
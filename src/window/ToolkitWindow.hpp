@@ -4,6 +4,7 @@
 #include <hyprtoolkit/types/PointerShape.hpp>
 
 #include "../helpers/DamageRing.hpp"
+#include "../helpers/KineticScroll.hpp"
 #include "../helpers/Memory.hpp"
 #include "../core/Input.hpp"
 
@@ -23,10 +24,31 @@ namespace Hyprtoolkit {
         WP<IElement> m_el;
     };
 
+    // A re-rasterization that can wait, e.g. after a scale change. The element keeps
+    // drawing its stale texture, stretched, until its turn comes.
+    struct SPendingRaster {
+        WP<IElement>          element;
+        std::function<void()> fn;
+
+        bool                  visible = false;
+        double                area    = 0;
+    };
+
+    // content that moved on screen since the last frame, see IToolkitWindow::damageScroll
+    struct SScrollCopy {
+        WP<IElement>              element;
+        Hyprutils::Math::CBox     box; // what of it is visible, logical
+        Hyprutils::Math::Vector2D delta;
+
+        // in pixels, where last frame's pixels go and where they come from. Empty if none of them stay in view
+        Hyprutils::Math::CBox     copyTo(float scale) const;
+        Hyprutils::Math::CBox     copyFrom(float scale) const;
+    };
+
     class IToolkitWindow : public IWindow {
       public:
-        IToolkitWindow()          = default;
-        virtual ~IToolkitWindow() = default;
+        IToolkitWindow() = default;
+        virtual ~IToolkitWindow();
 
         /*
             Schedules a frame event as well.
@@ -36,10 +58,18 @@ namespace Hyprtoolkit {
         virtual void                      scheduleFrame();
         virtual void                      damageEntire();
 
+        /*
+            What's in e moved by delta since the last frame, e.g. scrolled. Takes logical coordinates (unscaled).
+            What stays in view is copied over from the last frame when it can be, only what came into view gets painted.
+        */
+        virtual void                      damageScroll(SP<IElement> e, const Hyprutils::Math::Vector2D& delta);
+
         virtual Hyprutils::Math::Vector2D cursorPos();
+        virtual size_t                    gpuBytes();
         virtual void                      onPreRender();
         virtual void                      render() = 0;
         virtual void                      scheduleReposition(WP<IElement> e);
+        virtual void                      scheduleRaster(WP<IElement> e, std::function<void()>&& fn);
 
         virtual SP<IWindow>               openPopup(const SWindowCreationData& data) = 0;
 
@@ -47,6 +77,7 @@ namespace Hyprtoolkit {
         virtual void                      mouseMove(const Hyprutils::Math::Vector2D& local);
         virtual void                      mouseButton(const Input::eMouseButton button, bool state);
         virtual void                      mouseAxis(const Input::eAxisAxis axis, float delta);
+        virtual void                      mouseAxisFrame(const Input::SAxisFrame& frame); // applied on the next frame, see applyScroll
         virtual void                      mouseLeave();
 
         virtual void                      keyboardKey(const Input::SKeyboardKeyEvent& e);
@@ -54,6 +85,7 @@ namespace Hyprtoolkit {
         virtual void                      setKeyboardFocus(SP<IElement>);
 
         virtual void                      updateFocus(const Hyprutils::Math::Vector2D& coords);
+        virtual void                      invalidateHover(); // what's under the pointer might have changed, resolve it again on the next move
         virtual void                      setCursor(ePointerShape shape) = 0;
 
         virtual void                      setIMTo(const Hyprutils::Math::CBox& box, const std::string& str, size_t cursor);
@@ -63,6 +95,20 @@ namespace Hyprtoolkit {
         virtual void                      closeTooltip();
 
         void                              initElementIfNeeded(SP<IElement>);
+        void                              runPendingRasters();
+        void                              layoutPending();
+
+        // the outermost CBackend::batch is over, see m_batch
+        void                              endBatch();
+
+        // scrolls by what came in since the last frame, and by the fling if one is going
+        void                              applyScroll();
+
+        // before rendering: damages the scrolls that can't be copied. canCopy if the last frame's buffer is there to copy from
+        void                              prepareScrollCopies(bool canCopy);
+
+        // whether any of e is on screen, with the window and every clipping parent grown by margin
+        bool                              isElementVisible(SP<IElement> e, double margin = 0);
 
         // Damage ring is in pixel coords
         CDamageRing                        m_damageRing;
@@ -81,6 +127,23 @@ namespace Hyprtoolkit {
         std::function<ePointerShape()>     m_pointerFn       = nullptr;
 
         std::vector<WP<IElement>>          m_needsReposition;
+        std::vector<SPendingRaster>        m_pendingRasters;
+        std::vector<SScrollCopy>           m_scrollCopies;
+        CKineticScroll                     m_kineticScroll;
+
+        // Where the pointer can move with the same elements under it: inside under, outside all of others.
+        // Valid until anything is laid out or moved, see invalidateHover.
+        struct {
+            Hyprutils::Math::CBox              under;
+            std::vector<Hyprutils::Math::CBox> others;
+            bool                               valid = false;
+        } m_hoverCache;
+
+        // held back inside CBackend::batch
+        struct {
+            Hyprutils::Math::CRegion damage; // pixel coords, like the ring
+            bool                     frame = false;
+        } m_batch;
 
         struct {
             SP<IToolkitWindow>    tooltipPopup;
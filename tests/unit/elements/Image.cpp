@@ -0,0 +1,67 @@
+#include <gtest/gtest.h>
+
+#include <element/image/Image.hpp>
+#include <element/Element.hpp>
+#include <resource/decode/DecodeScheduler.hpp>
+#include <core/InternalBackend.hpp>
+
+#include "../tricks/Tricks.hpp"
+
+#include <cairo/cairo.h>
+
+#include <filesystem>
+#include <future>
+
+using namespace Hyprtoolkit;
+using namespace Hyprutils::Math;
+
+TEST(Image, decodeOutlivesItsElement) {
+    // decodes finish into idles, which nothing runs here
+    Tests::Tricks::createBackend();
+
+    const auto SCHEDULER = g_decodeScheduler;
+    g_decodeScheduler    = Asset::CDecodeScheduler::create(1);
+
+    const std::string PATH    = "/tmp/hyprtoolkit-image-test.png";
+    const auto        SURFACE = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, 16, 16);
+    ASSERT_EQ(cairo_surface_write_to_png(SURFACE, PATH.c_str()), CAIRO_STATUS_SUCCESS);
+    cairo_surface_destroy(SURFACE);
+
+    const SImageData DATA = {
+        .path = PATH,
+        .size = CDynamicSize{CDynamicSize::HT_SIZE_ABSOLUTE, CDynamicSize::HT_SIZE_ABSOLUTE, {16, 16}},
+    };
+
+    auto element                  = CImageElement::create(DATA);
+    element->impl->position       = {{}, {16, 16}};
+    element->m_impl->lastScale    = 1.F;
+    element->m_impl->decodeTarget = makeShared<SImageDecodeTarget>(SImageDecodeTarget{.box = element->m_impl->decodeBox()});
+
+    const auto KEY = element->m_impl->getCacheString();
+
+    // the decode of an element that's gone by now, still running. It decodes into that element's resource.
+    std::promise<void> started, release;
+    auto               releaseFuture = release.get_future().share();
+    auto               gone          = g_decodeScheduler->submit(
+        KEY, Asset::DECODE_PRIORITY_VISIBLE,
+        [&started, releaseFuture] {
+            started.set_value();
+            releaseFuture.wait();
+        },
+        nullptr);
+    started.get_future().wait();
+    gone.reset();
+
+    // the same image shown again, e.g. scrolled back to
+    element->renderTex();
+    release.set_value();
+    g_decodeScheduler->flush();
+
+    // it got a decode of its own
+    EXPECT_EQ(g_decodeScheduler->stats().deduplicated, 0);
+    ASSERT_TRUE(element->m_impl->resource);
+    EXPECT_TRUE(element->m_impl->resource->m_asset.cairoSurface);
+
+    g_decodeScheduler = SCHEDULER;
+    std::filesystem::remove(PATH);
+}
@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+
+#include <element/listView/ListView.hpp>
+#include <element/Element.hpp>
+#include <layout/Positioner.hpp>
+#include <hyprtoolkit/element/Null.hpp>
+#include <hyprtoolkit/element/ScrollArea.hpp>
+
+#include <unordered_map>
+
+using namespace Hyprtoolkit;
+
+namespace {
+    // items of a fixed height, and which index each shows
+    struct SItems {
+        size_t                                   count   = 0;
+        float                                    height  = 30;
+        size_t                                   created = 0;
+        std::unordered_map<size_t, SP<IElement>> bound;
+
+        SListViewDataSource                      source() {
+            return {
+                .count  = [this] { return count; },
+                .create = [this]() -> SP<IElement> {
+                    created++;
+                    return CNullBuilder::begin()->size({CDynamicSize::HT_SIZE_ABSOLUTE, CDynamicSize::HT_SIZE_ABSOLUTE, {10, height}})->commence();
+                },
+                .bind   = [this](SP<IElement> e, size_t idx) { bound[idx] = e; },
+                .unbind = [this](SP<IElement> e, size_t idx) { bound.erase(idx); },
+            };
+        }
+    };
+
+    SP<CScrollAreaElement> scrollArea() {
+        return CScrollAreaBuilder::begin()->scrollY(true)->size({CDynamicSize::HT_SIZE_ABSOLUTE, CDynamicSize::HT_SIZE_ABSOLUTE, {200, 300}})->commence();
+    }
+}
+
+TEST(ListView, rowHeights) {
+    CRowHeights heights;
+    heights.reset(10, 20, 5);
+
+    EXPECT_EQ(heights.offset(3), 75);
+    EXPECT_EQ(heights.total(), 245);
+    EXPECT_EQ(heights.rowAt(0), 0);
+    EXPECT_EQ(heights.rowAt(24.9), 0);
+    EXPECT_EQ(heights.rowAt(25), 1);
+    EXPECT_EQ(heights.rowAt(100000), 9);
+
+    heights.set(1, 45);
+    EXPECT_EQ(heights.offset(3), 100);
+    EXPECT_EQ(heights.rowAt(74), 1);
+    EXPECT_EQ(heights.rowAt(75), 2);
+    EXPECT_TRUE(heights.measured(1));
+    EXPECT_FALSE(heights.measured(2));
+
+    // more rows, the measured one stays measured
+    heights.resize(12);
+    EXPECT_EQ(heights.total(), 320);
+    EXPECT_TRUE(heights.measured(1));
+    EXPECT_EQ(heights.height(1), 45);
+}
+
+TEST(ListView, recycles) {
+    SItems items{.count = 100000};
+
+    auto   area = scrollArea();
+    auto   list = CListViewBuilder::begin()->source(items.source())->estimatedHeight(30)->overscan(2)->commence();
+    area->addChild(list);
+
+    // 10 visible rows and 2 below
+    g_positioner->position(area, {{}, {200, 300}});
+    EXPECT_EQ(items.created, 12);
+    EXPECT_EQ(list->impl->children.size(), 12);
+    EXPECT_EQ(list->impl->position.h, 99999999);
+
+    // far down, the same items show other rows, and 2 more for the overscan above
+    area->setScroll({0, 30 * 50000});
+    g_positioner->position(area, {{}, {200, 300}});
+    EXPECT_EQ(items.created, 14);
+    EXPECT_EQ(list->impl->children.size(), 14);
+    ASSERT_TRUE(items.bound.contains(50000));
+    EXPECT_EQ(items.bound.at(50000)->impl->position.y, 0);
+    EXPECT_FALSE(items.bound.contains(0));
+
+    // a grid of 4 columns has 4 items a row
+    list->rebuild()->columns(4)->gap(4)->commence();
+    area->setScroll({0, 0});
+    g_positioner->position(area, {{}, {200, 300}});
+    EXPECT_EQ(list->impl->children.size(), 4 * 11);
+    EXPECT_EQ(items.bound.at(5)->impl->position.x, 51);
+    EXPECT_EQ(items.bound.at(5)->impl->position.y, 34);
+}
+
+TEST(ListView, keepsScroll) {
+    // estimated shorter than they are
+    SItems items{.count = 100000, .height = 30};
+
+    auto   area = scrollArea();
+    auto   list = CListViewBuilder::begin()->source(items.source())->estimatedHeight(20)->overscan(2)->commence();
+    area->addChild(list);
+
+    g_positioner->position(area, {{}, {200, 300}});
+    list->scrollToItem(1000);
+
+    // the overscan above measures taller than estimated, the scroll follows so item 1000 stays on top
+    g_positioner->position(area, {{}, {200, 300}});
+    const auto SCROLL = area->getCurrentScroll();
+    ASSERT_TRUE(items.bound.contains(1000));
+    EXPECT_EQ(items.bound.at(1000)->impl->position.y, 0);
+
+    g_positioner->position(area, {{}, {200, 300}});
+    EXPECT_EQ(area->getCurrentScroll(), SCROLL);
+    EXPECT_EQ(items.bound.at(1000)->impl->position.y, 0);
+    EXPECT_EQ(items.bound.at(1001)->impl->position.y, 30);
+}
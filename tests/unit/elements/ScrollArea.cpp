@@ -0,0 +1,74 @@
+#include <gtest/gtest.h>
+
+#include <element/Element.hpp>
+#include <layout/Positioner.hpp>
+#include <hyprtoolkit/element/Null.hpp>
+#include <hyprtoolkit/element/ColumnLayout.hpp>
+#include <hyprtoolkit/element/ScrollArea.hpp>
+
+#include "../tricks/SizedElement.hpp"
+
+using namespace Hyprtoolkit;
+using namespace Hyprutils::Math;
+using namespace Hyprtoolkit::Tests::Tricks;
+
+namespace {
+    SP<CScrollAreaElement> scrollArea() {
+        return CScrollAreaBuilder::begin()->scrollY(true)->size({CDynamicSize::HT_SIZE_ABSOLUTE, CDynamicSize::HT_SIZE_ABSOLUTE, {200, 300}})->commence();
+    }
+}
+
+TEST(ScrollArea, scrollMovesContent) {
+    auto                          area   = scrollArea();
+    auto                          column = CColumnLayoutBuilder::begin()->size({CDynamicSize::HT_SIZE_PERCENT, CDynamicSize::HT_SIZE_AUTO, {1, 1}})->commence();
+    std::vector<SP<CNullElement>> items;
+    size_t                        layouts = 0;
+
+    for (size_t i = 0; i < 100; ++i) {
+        items.emplace_back(CNullBuilder::begin()->size({CDynamicSize::HT_SIZE_ABSOLUTE, CDynamicSize::HT_SIZE_ABSOLUTE, {200, 50}})->commence());
+        column->addChild(items.back());
+    }
+
+    column->impl->userFns.repositioned = [&layouts] { layouts++; };
+    area->addChild(column);
+
+    g_positioner->position(area, {{}, {200, 300}});
+    EXPECT_EQ(layouts, 1);
+
+    // the content moves as it's laid out, it isn't laid out again
+    area->setScroll({0, 120});
+    EXPECT_EQ(layouts, 1);
+    EXPECT_EQ(column->impl->position.y, -120);
+    EXPECT_EQ(items.at(3)->impl->position.y, 30);
+
+    // right where a layout puts it
+    g_positioner->position(area, {{}, {200, 300}});
+    EXPECT_EQ(layouts, 2);
+    EXPECT_EQ(items.at(3)->impl->position.y, 30);
+
+    area->setScroll({0, 99999});
+    EXPECT_EQ(area->getCurrentScroll().y, (100 * 50) - 300);
+    EXPECT_EQ(items.back()->impl->position.y, 250);
+}
+
+TEST(ScrollArea, extentMeasuredOnce) {
+    auto area    = scrollArea();
+    auto content = CSizedElement::create({200, 5000});
+    area->addChild(content);
+
+    g_positioner->position(area, {{}, {200, 300}});
+
+    // a scroll clamps to what the content measured, until it changes
+    area->setScroll({0, 10});
+    const auto MEASURED = content->m_measured;
+    for (size_t i = 0; i < 100; ++i) {
+        area->setScroll({0, 10.F * i});
+    }
+    EXPECT_EQ(content->m_measured, MEASURED);
+    EXPECT_EQ(content->impl->position.y, -990);
+
+    content->setSize({200, 500});
+    area->setScroll({0, 99999});
+    EXPECT_EQ(content->m_measured, MEASURED + 1);
+    EXPECT_EQ(area->getCurrentScroll().y, 200);
+}
@@ -1,11 +1,16 @@
 #include <gtest/gtest.h>
 
 #include <element/text/Text.hpp>
+#include <element/Element.hpp>
+#include <layout/Positioner.hpp>
+#include <hyprtoolkit/element/ColumnLayout.hpp>
 #include <hyprtoolkit/core/Backend.hpp>
 
 #include "../tricks/Tricks.hpp"
+#include "../tricks/TestWindow.hpp"
 
 using namespace Hyprtoolkit;
+using namespace Hyprtoolkit::Tests::Tricks;
 
 TEST(Element, text) {
     Tests::Tricks::createBackendSupport();
@@ -15,4 +20,47 @@ TEST(Element, text) {
     EXPECT_EQ(text->m_impl->parsedText, "Hello <u><span foreground=\"#4eecf8ff\">link</span></u>! Hi <u><span foreground=\"#4eecf8ff\">link2</span></u>!");
 
     text.reset();
-}
\ No newline at end of file
+}
+
+TEST(Element, textHeightForWidth) {
+    Tests::Tricks::createBackendSupport();
+
+    auto       text    = CTextBuilder::begin()->text("a few words that will have to wrap when there isn't much room for them")->commence();
+    const auto NATURAL = *text->preferredSize({-1, -1});
+
+    // narrower, taller
+    const auto FITTED = *text->preferredSize({NATURAL.x / 3, 1000});
+    EXPECT_LE(FITTED.x, (NATURAL.x / 3) + 1);
+    EXPECT_GT(FITTED.y, NATURAL.y);
+
+    // the box a layout gives it is what it needs, nothing to do again once laid out
+    auto column = CColumnLayoutBuilder::begin()->size({CDynamicSize::HT_SIZE_ABSOLUTE, CDynamicSize::HT_SIZE_ABSOLUTE, {NATURAL.x / 3, 1000}})->commence();
+    column->addChild(text);
+    g_positioner->position(column, {{}, {NATURAL.x / 3, 1000}});
+
+    EXPECT_EQ(text->impl->position.h, FITTED.y);
+    EXPECT_LE(text->m_impl->preferred.y, text->impl->position.h + 2);
+
+    column.reset();
+    text.reset();
+}
+
+TEST(Element, textRasterQueueDropped) {
+    Tests::Tricks::createBackendSupport();
+
+    auto text   = CTextBuilder::begin()->text("blurry")->commence();
+    auto window = CTestWindow::create();
+
+    text->impl->setWindow(window);
+    text->impl->rasterQueued = true;
+    window->scheduleRaster(text->impl->self, [] { ; });
+
+    // the window goes away with its queue, the next one has to be able to queue it again
+    window.reset();
+    window = CTestWindow::create();
+    text->impl->setWindow(window);
+
+    EXPECT_FALSE(text->impl->rasterQueued);
+
+    text.reset();
+}
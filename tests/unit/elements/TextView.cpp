@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+
+#include <format>
+
+#include <element/textView/TextView.hpp>
+#include <element/Element.hpp>
+#include <hyprtoolkit/element/TextView.hpp>
+
+#include "../tricks/Tricks.hpp"
+
+using namespace Hyprtoolkit;
+using namespace Hyprutils::Math;
+
+namespace {
+    SP<CTextViewElement> textView(size_t lines) {
+        std::string text;
+        for (size_t i = 0; i < lines; ++i) {
+            text += std::format("line {}\n", i);
+        }
+
+        auto view = CTextViewBuilder::begin()->text(std::move(text))->overscan(4)->cacheSize(8)->commence();
+
+        // rows at a known height, independent of the fonts around
+        view->m_impl->lineHeight = 20.F;
+        view->impl->position     = {0, 0, 200, view->lines() * 20.F};
+        return view;
+    }
+}
+
+TEST(TextView, visibleRange) {
+    Tests::Tricks::createBackendSupport();
+
+    auto view = textView(1000);
+
+    // what's shown, and overscan on both sides
+    EXPECT_EQ(view->m_impl->visibleRange({0, 2000, 200, 200}), (std::pair<size_t, size_t>{96, 114}));
+
+    // not past either end
+    EXPECT_EQ(view->m_impl->visibleRange({0, 0, 200, 200}), (std::pair<size_t, size_t>{0, 14}));
+    EXPECT_EQ(view->m_impl->visibleRange({0, 19900, 200, 200}), (std::pair<size_t, size_t>{991, 1000}));
+
+    // partially shown lines count
+    EXPECT_EQ(view->m_impl->visibleRange({0, 2010, 200, 200}), (std::pair<size_t, size_t>{96, 115}));
+}
+
+TEST(TextView, trimCache) {
+    Tests::Tricks::createBackendSupport();
+
+    auto        view = textView(100);
+    const auto& IMPL = view->m_impl;
+
+    // rendered lines, without rendering them
+    const auto ADD = [&IMPL](size_t idx) {
+        auto line = makeShared<STextViewLine>();
+        line->idx = idx;
+        IMPL->lru.emplace_front(line);
+        IMPL->lines[idx] = IMPL->lru.begin();
+    };
+
+    for (size_t i = 0; i < 12; ++i) {
+        ADD(i);
+    }
+
+    // used again, so it's kept over older ones
+    IMPL->lineFor(0);
+
+    IMPL->trimCache(0);
+    EXPECT_EQ(IMPL->lru.size(), 8);
+    EXPECT_EQ(IMPL->lines.size(), 8);
+    EXPECT_TRUE(IMPL->lines.contains(0));
+    EXPECT_FALSE(IMPL->lines.contains(1));
+    EXPECT_FALSE(IMPL->lines.contains(4));
+    EXPECT_TRUE(IMPL->lines.contains(5));
+    EXPECT_TRUE(IMPL->lines.contains(11));
+
+    // never below what's visible
+    for (size_t i = 12; i < 20; ++i) {
+        ADD(i);
+    }
+
+    IMPL->trimCache(10);
+    EXPECT_EQ(IMPL->lru.size(), 10);
+    EXPECT_TRUE(IMPL->lines.contains(19));
+    EXPECT_FALSE(IMPL->lines.contains(9));
+}
@@ -77,3 +77,56 @@ TEST(Element, textboxEditing) {
 
     textbox.reset();
 }
+
+TEST(Element, textboxMultiline) {
+    Tests::Tricks::createBackendSupport();
+
+    auto textbox = CTextboxBuilder::begin()->defaultText("first\nsecond")->commence();
+
+    for (size_t i = 0; i < 5; ++i) {
+        textbox->impl->m_externalEvents.key.emit(Input::SKeyboardKeyEvent{.xkbKeysym = XKB_KEY_Right});
+    }
+
+    textbox->impl->m_externalEvents.key.emit(Input::SKeyboardKeyEvent{.utf8 = "\nnew"});
+    EXPECT_EQ(textbox->currentText(), "first\nnew\nsecond");
+    EXPECT_EQ(textbox->cursorPos(), 9);
+
+    textbox->impl->m_externalEvents.key.emit(Input::SKeyboardKeyEvent{.xkbKeysym = XKB_KEY_BackSpace, .modMask = Input::HT_MODIFIER_CTRL_SHIFT});
+    EXPECT_EQ(textbox->currentText(), "first\n\nsecond");
+    EXPECT_EQ(textbox->cursorPos(), 6);
+
+    textbox->impl->m_externalEvents.key.emit(Input::SKeyboardKeyEvent{.xkbKeysym = XKB_KEY_BackSpace});
+    EXPECT_EQ(textbox->currentText(), "first\nsecond");
+
+    textbox->impl->m_externalEvents.key.emit(Input::SKeyboardKeyEvent{.xkbKeysym = XKB_KEY_Right});
+    textbox->impl->m_externalEvents.key.emit(Input::SKeyboardKeyEvent{.xkbKeysym = XKB_KEY_Delete, .modMask = Input::HT_MODIFIER_CTRL_SHIFT});
+    EXPECT_EQ(textbox->currentText(), "first\n");
+
+    // words don't run across the newline
+    textbox->impl->m_externalEvents.key.emit(Input::SKeyboardKeyEvent{.xkbKeysym = XKB_KEY_Left, .modMask = Input::HT_MODIFIER_CTRL});
+    EXPECT_EQ(textbox->cursorPos(), 0);
+    textbox->impl->m_externalEvents.key.emit(Input::SKeyboardKeyEvent{.xkbKeysym = XKB_KEY_Right, .modMask = Input::HT_MODIFIER_CTRL});
+    EXPECT_EQ(textbox->cursorPos(), 5);
+    textbox->impl->m_externalEvents.key.emit(Input::SKeyboardKeyEvent{.xkbKeysym = XKB_KEY_Right, .modMask = Input::HT_MODIFIER_CTRL});
+    EXPECT_EQ(textbox->cursorPos(), 6);
+
+    textbox.reset();
+}
+
+TEST(Element, textboxPassword) {
+    Tests::Tricks::createBackendSupport();
+
+    auto textbox = CTextboxBuilder::begin()->defaultText("a🌾b")->password(true)->commence();
+
+    // masked per codepoint, not per byte
+    EXPECT_EQ(textbox->m_impl->paragraphLabel(0), "***");
+    EXPECT_EQ(textbox->m_impl->labelOffset(0, 5), 2);
+    EXPECT_EQ(textbox->m_impl->bufferOffset(0, 2), 5);
+
+    textbox->impl->m_externalEvents.key.emit(Input::SKeyboardKeyEvent{.xkbKeysym = XKB_KEY_End});
+    textbox->impl->m_externalEvents.key.emit(Input::SKeyboardKeyEvent{.utf8 = "🧑"});
+    EXPECT_EQ(textbox->m_impl->paragraphLabel(0), "****");
+    EXPECT_EQ(textbox->m_impl->bufferOffset(0, 4), 10);
+
+    textbox.reset();
+}
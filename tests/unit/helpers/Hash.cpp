@@ -0,0 +1,35 @@
+#include <gtest/gtest.h>
+
+#include <helpers/Hash.hpp>
+
+#include <string_view>
+#include <vector>
+
+using namespace Hyprtoolkit;
+
+static uint64_t hashOf(std::string_view s, uint64_t seed = 0) {
+    return Hash::xxh64(s.data(), s.size(), seed);
+}
+
+TEST(Hash, xxh64) {
+    // reference values
+    EXPECT_EQ(hashOf(""), 0xEF46DB3751D8E999ULL);
+    EXPECT_EQ(hashOf("a"), 0xD24EC4F1A98C6E5BULL);
+    EXPECT_EQ(hashOf("abc"), 0x44BC2CF5AD770999ULL);
+    EXPECT_EQ(hashOf("Nobody inspects the spammish repetition"), 0xFBCEA83C8A378BF1ULL);
+
+    EXPECT_NE(hashOf("abc", 1), hashOf("abc"));
+}
+
+TEST(Hash, contentNotAddress) {
+    // the same bytes in different buffers, what image data is keyed by
+    std::vector<uint8_t> a(4096), b(4096);
+    for (size_t i = 0; i < a.size(); ++i) {
+        a[i] = b[i] = i * 7;
+    }
+
+    EXPECT_EQ(Hash::xxh64(a.data(), a.size()), Hash::xxh64(b.data(), b.size()));
+
+    b[2048] ^= 1;
+    EXPECT_NE(Hash::xxh64(a.data(), a.size()), Hash::xxh64(b.data(), b.size()));
+}
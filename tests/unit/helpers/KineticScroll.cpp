@@ -0,0 +1,83 @@
+#include <helpers/KineticScroll.hpp>
+
+#include <gtest/gtest.h>
+
+using namespace Hyprtoolkit;
+using namespace Hyprutils::Math;
+using namespace std::chrono_literals;
+
+TEST(KineticScroll, oneScrollAFrame) {
+    CKineticScroll scroll;
+
+    scroll.push({0, 10}, 0, false);
+    scroll.push({0, 5}, 1, false);
+    scroll.push({3, 0}, 2, false);
+    EXPECT_TRUE(scroll.active());
+
+    EXPECT_EQ(scroll.frame(), Vector2D(3, 15));
+    EXPECT_FALSE(scroll.active());
+    EXPECT_EQ(scroll.frame(), Vector2D());
+
+    // a wheel doesn't fling
+    scroll.push({0, 10}, 10, false);
+    scroll.push({0, 10}, 20, false);
+    scroll.lift(25);
+    scroll.frame();
+    EXPECT_FALSE(scroll.active());
+}
+
+TEST(KineticScroll, flings) {
+    CKineticScroll scroll;
+    const auto     START = CKineticScroll::clock::now();
+
+    // 1px/ms, the time wrapping in between
+    for (uint32_t i = 0; i < 5; ++i) {
+        scroll.push({0, 10}, UINT32_MAX - 20 + (i * 10), true);
+    }
+
+    scroll.frame(START);
+    scroll.lift(25, START);
+    ASSERT_TRUE(scroll.flinging());
+
+    // slowing down, frame by frame, going about as far as the velocity times the time constant
+    auto   now  = START;
+    double last = 99999, total = 0;
+    for (size_t i = 0; i < 1000 && scroll.flinging(); ++i) {
+        now += 16ms;
+        const auto DELTA = scroll.frame(now);
+        EXPECT_EQ(DELTA.x, 0);
+        EXPECT_LT(DELTA.y, last);
+        last = DELTA.y;
+        total += DELTA.y;
+    }
+
+    EXPECT_FALSE(scroll.active());
+    EXPECT_GT(total, 300);
+    EXPECT_LT(total, 325);
+}
+
+TEST(KineticScroll, stops) {
+    CKineticScroll scroll;
+
+    // fingers rested before lifting
+    scroll.push({0, 10}, 0, true);
+    scroll.push({0, 10}, 10, true);
+    scroll.lift(200);
+    scroll.frame();
+    EXPECT_FALSE(scroll.active());
+
+    // scrolling again, or a click, stops a fling
+    scroll.push({0, 10}, 300, true);
+    scroll.push({0, 10}, 310, true);
+    scroll.lift(310);
+    EXPECT_TRUE(scroll.flinging());
+    scroll.push({0, -5}, 400, false);
+    EXPECT_FALSE(scroll.flinging());
+    EXPECT_EQ(scroll.frame(), Vector2D(0, 15));
+
+    scroll.push({0, 10}, 500, true);
+    scroll.push({0, 10}, 510, true);
+    scroll.lift(510);
+    scroll.cancel();
+    EXPECT_FALSE(scroll.active());
+}
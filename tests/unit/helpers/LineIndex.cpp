@@ -0,0 +1,45 @@
+#include <helpers/LineIndex.hpp>
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+
+using namespace Hyprtoolkit;
+
+TEST(LineIndex, fromString) {
+    auto index = CLineIndex::fromString("first\nsecond\r\n\nlast\n");
+    ASSERT_TRUE(index);
+    EXPECT_EQ(index->lines(), 4);
+    EXPECT_EQ(index->line(0), "first");
+    EXPECT_EQ(index->line(1), "second");
+    EXPECT_EQ(index->line(2), "");
+    EXPECT_EQ(index->line(3), "last");
+    EXPECT_EQ(index->line(4), "");
+
+    EXPECT_EQ(CLineIndex::fromString("")->lines(), 0);
+    EXPECT_EQ(CLineIndex::fromString("no newline")->lines(), 1);
+    EXPECT_EQ(CLineIndex::fromString("\n")->lines(), 1);
+}
+
+TEST(LineIndex, fromFile) {
+    const auto PATH = std::filesystem::temp_directory_path() / "hyprtoolkit-lineindex-test.txt";
+
+    {
+        std::ofstream ofs(PATH, std::ios::trunc);
+        for (size_t i = 0; i < 10000; ++i) {
+            ofs << "line " << i << "\n";
+        }
+    }
+
+    auto index = CLineIndex::fromFile(PATH);
+    ASSERT_TRUE(index);
+    EXPECT_EQ(index->lines(), 10000);
+    EXPECT_EQ(index->line(0), "line 0");
+    EXPECT_EQ(index->line(4242), "line 4242");
+    EXPECT_EQ(index->line(9999), "line 9999");
+
+    std::filesystem::remove(PATH);
+
+    EXPECT_FALSE(CLineIndex::fromFile("/this/does/not/exist"));
+}
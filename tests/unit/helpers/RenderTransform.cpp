@@ -0,0 +1,47 @@
+#include <helpers/RenderTransform.hpp>
+
+#include <gtest/gtest.h>
+
+#include <numbers>
+
+using namespace Hyprtoolkit;
+using namespace Hyprutils::Math;
+
+TEST(RenderTransform, aroundPivot) {
+    // twice the size around the center of {10, 10, 20, 20}, then 5 to the right
+    const auto T = SRenderTransform::make({5, 0}, 2.0, 0.0, 1.F, {20, 20});
+    EXPECT_FALSE(T.identity());
+    EXPECT_TRUE(SRenderTransform{}.identity());
+
+    EXPECT_EQ(T.apply(Vector2D{20, 20}), Vector2D(25, 20));
+    EXPECT_EQ(T.apply(CBox{10, 10, 20, 20}), CBox(5, 0, 40, 40));
+
+    // a quarter turn around the pivot
+    const auto R = SRenderTransform::make({}, 1.0, std::numbers::pi / 2.0, 1.F, {0, 0});
+    const auto P = R.apply(Vector2D{10, 0});
+    EXPECT_NEAR(P.x, 0, 0.0001);
+    EXPECT_NEAR(P.y, 10, 0.0001);
+
+    const auto BOUNDS = R.bounds(CBox{0, 0, 20, 10});
+    EXPECT_NEAR(BOUNDS.x, -10, 0.0001);
+    EXPECT_NEAR(BOUNDS.y, 0, 0.0001);
+    EXPECT_NEAR(BOUNDS.w, 10, 0.0001);
+    EXPECT_NEAR(BOUNDS.h, 20, 0.0001);
+}
+
+TEST(RenderTransform, composes) {
+    const auto INNER = SRenderTransform::make({10, 0}, 0.5, 0.0, 0.5F, {50, 50});
+    const auto OUTER = SRenderTransform::make({0, 20}, 2.0, 0.3, 0.5F, {0, 0});
+    const auto BOTH  = INNER.then(OUTER);
+
+    // the same as applying one, then the other
+    for (const auto& p : {Vector2D{0, 0}, Vector2D{50, 50}, Vector2D{-13, 7}}) {
+        const auto ONE_BY_ONE = OUTER.apply(INNER.apply(p));
+        const auto AT_ONCE    = BOTH.apply(p);
+        EXPECT_NEAR(ONE_BY_ONE.x, AT_ONCE.x, 0.0001);
+        EXPECT_NEAR(ONE_BY_ONE.y, AT_ONCE.y, 0.0001);
+    }
+
+    EXPECT_EQ(BOTH.opacity, 0.25F);
+    EXPECT_NEAR(BOTH.rotation, 0.3, 0.0001);
+}
@@ -0,0 +1,124 @@
+#include <helpers/TextBuffer.hpp>
+
+#include <gtest/gtest.h>
+
+using namespace Hyprtoolkit;
+
+TEST(TextBuffer, assign) {
+    CTextBuffer buf("hello\nworld\n\n!");
+    EXPECT_EQ(buf.paragraphs(), 4);
+    EXPECT_EQ(buf.length(), 14);
+    EXPECT_EQ(buf.str(), "hello\nworld\n\n!");
+    EXPECT_EQ(buf.paragraph(1), "world");
+    EXPECT_EQ(buf.paragraph(2), "");
+    EXPECT_EQ(buf.paragraphStart(3), 13);
+
+    CTextBuffer empty;
+    EXPECT_EQ(empty.paragraphs(), 1);
+    EXPECT_TRUE(empty.empty());
+}
+
+TEST(TextBuffer, locate) {
+    CTextBuffer buf("ab\ncd");
+    EXPECT_EQ(buf.locate(0), std::make_pair(0UL, 0UL));
+    EXPECT_EQ(buf.locate(2), std::make_pair(0UL, 2UL));
+    EXPECT_EQ(buf.locate(3), std::make_pair(1UL, 0UL));
+    EXPECT_EQ(buf.locate(5), std::make_pair(1UL, 2UL));
+    EXPECT_EQ(buf.locate(99), std::make_pair(1UL, 2UL));
+}
+
+TEST(TextBuffer, insert) {
+    CTextBuffer buf("ab\ncd");
+    buf.takeDamage();
+
+    buf.insert(4, "X");
+    EXPECT_EQ(buf.str(), "ab\ncXd");
+
+    auto dmg = buf.takeDamage();
+    ASSERT_TRUE(dmg.has_value());
+    EXPECT_EQ(dmg->first, 1);
+    EXPECT_EQ(dmg->removed, 1);
+    EXPECT_EQ(dmg->added, 1);
+    EXPECT_FALSE(buf.takeDamage().has_value());
+
+    buf.insert(1, "1\n2\n3");
+    EXPECT_EQ(buf.str(), "a1\n2\n3b\ncXd");
+    EXPECT_EQ(buf.paragraphs(), 4);
+    EXPECT_EQ(buf.paragraphStart(3), 8);
+
+    dmg = buf.takeDamage();
+    ASSERT_TRUE(dmg.has_value());
+    EXPECT_EQ(dmg->first, 0);
+    EXPECT_EQ(dmg->removed, 1);
+    EXPECT_EQ(dmg->added, 3);
+}
+
+TEST(TextBuffer, erase) {
+    CTextBuffer buf("one\ntwo\nthree\nfour");
+    buf.takeDamage();
+
+    buf.erase(5, 6);
+    EXPECT_EQ(buf.str(), "one\nto\nthree\nfour");
+
+    buf.takeDamage();
+
+    // "o" of "to" up to "th" of "three"
+    buf.erase(5, 9);
+    EXPECT_EQ(buf.str(), "one\ntree\nfour");
+    EXPECT_EQ(buf.paragraphs(), 3);
+    EXPECT_EQ(buf.length(), 13);
+
+    auto dmg = buf.takeDamage();
+    ASSERT_TRUE(dmg.has_value());
+    EXPECT_EQ(dmg->first, 1);
+    EXPECT_EQ(dmg->removed, 2);
+    EXPECT_EQ(dmg->added, 1);
+
+    buf.erase(0, 999);
+    EXPECT_TRUE(buf.empty());
+    EXPECT_EQ(buf.paragraphs(), 1);
+}
+
+TEST(TextBuffer, damageMerge) {
+    CTextBuffer buf("a\nb\nc\nd\ne");
+    buf.takeDamage();
+
+    // split b into 3, then edit e (now paragraph 6)
+    buf.insert(3, "\n\n");
+    buf.insert(buf.length(), "!");
+
+    auto dmg = buf.takeDamage();
+    ASSERT_TRUE(dmg.has_value());
+    EXPECT_EQ(dmg->first, 1);
+    EXPECT_EQ(dmg->removed, 4);
+    EXPECT_EQ(dmg->added, 6);
+    EXPECT_EQ(buf.str(), "a\nb\n\n\nc\nd\ne!");
+
+    // join a and b, then edit the joined one
+    buf.erase(1, 2);
+    buf.insert(0, "x");
+
+    dmg = buf.takeDamage();
+    ASSERT_TRUE(dmg.has_value());
+    EXPECT_EQ(dmg->first, 0);
+    EXPECT_EQ(dmg->removed, 2);
+    EXPECT_EQ(dmg->added, 1);
+    EXPECT_EQ(buf.str(), "xab\n\n\nc\nd\ne!");
+}
+
+TEST(TextBuffer, materialized) {
+    CTextBuffer buf("one\ntwo");
+    EXPECT_TRUE(buf.matches("one\ntwo"));
+    EXPECT_FALSE(buf.matches("one two"));
+    EXPECT_FALSE(buf.matches("one\ntw"));
+
+    // edits after str() are applied to the materialized text
+    EXPECT_EQ(buf.str(), "one\ntwo");
+    buf.insert(3, "!\nthree");
+    buf.erase(0, 1);
+    EXPECT_EQ(buf.str(), "ne!\nthree\ntwo");
+    EXPECT_TRUE(buf.matches("ne!\nthree\ntwo"));
+
+    buf.assign("four");
+    EXPECT_EQ(buf.str(), "four");
+}
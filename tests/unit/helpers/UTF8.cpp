@@ -34,6 +34,8 @@ TEST(UTF8, substr) {
     EXPECT_EQ(UTF8::substr("世界", 1, 1), "界");
     EXPECT_EQ(UTF8::substr("世界is酷薄", 1), "界is酷薄");
     EXPECT_EQ(UTF8::substr("ハイパーランド", 1, 2), "イパ");
+    EXPECT_EQ(UTF8::substr("ハイパーランド", 0), "ハイパーランド");
+    EXPECT_EQ(UTF8::substr("ハイパーランド", 5, 20), "ンド");
 }
 
 TEST(UTF8, utf8ToOffset) {
@@ -119,3 +121,28 @@ TEST(UTF8, findLastNotOf) {
     EXPECT_EQ(UTF8::findLastNotOf("bbbbb", "b"), std::string::npos);
     EXPECT_EQ(UTF8::findLastNotOf("🧑🧑🌾🌾🧑", "🧑"), 12);
 }
+
+TEST(UTF8, codepointIndex) {
+    std::string str;
+    for (size_t i = 0; i < 100; ++i) {
+        str += "a世界🧑é";
+    }
+
+    UTF8::CCodepointIndex index(str);
+    EXPECT_EQ(index.length(), 500);
+    EXPECT_EQ(index.length(), UTF8::length(str));
+
+    for (size_t i = 0; i <= 510; i += 7) {
+        EXPECT_EQ(index.utf8ToOffset(str, i), UTF8::utf8ToOffset(str, i));
+        EXPECT_EQ(index.substr(str, i, 3), UTF8::substr(str, i, 3));
+    }
+
+    for (size_t i = 0; i <= str.size() + 10; i += 5) {
+        EXPECT_EQ(index.offsetToUTF8Len(str, i), UTF8::offsetToUTF8Len(str, i));
+    }
+
+    index.rebuild("");
+    EXPECT_EQ(index.length(), 0);
+    EXPECT_EQ(index.utf8ToOffset("", 3), 0);
+    EXPECT_EQ(index.offsetToUTF8Len("", 3), 0);
+}
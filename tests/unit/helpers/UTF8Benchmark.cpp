@@ -0,0 +1,168 @@
+#include <helpers/UTF8.hpp>
+#include <helpers/UTF8Simd.hpp>
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <chrono>
+#include <print>
+#include <random>
+
+using namespace Hyprtoolkit;
+
+// the byte-walking implementations the vectorized ones replaced
+namespace Reference {
+    static size_t length(const std::string& s) {
+        const char* c    = s.c_str();
+        size_t      len  = 0;
+        auto        endp = s.c_str() + s.length();
+        while (c < endp) {
+            c += UTF8::codepointLen(c, endp - c);
+            len++;
+        }
+        return len;
+    }
+
+    static size_t offsetToUTF8Len(const std::string& s, size_t offset) {
+        const char* c    = s.c_str();
+        size_t      len  = 0;
+        auto        endp = std::min(s.c_str() + s.length(), s.c_str() + offset);
+        while (c < endp) {
+            c += UTF8::codepointLen(c, endp - c);
+            len++;
+        }
+        return len;
+    }
+
+    static size_t utf8ToOffset(const std::string& s, size_t utf8) {
+        const char* c    = s.c_str();
+        size_t      len  = 0;
+        auto        endp = s.c_str() + s.length();
+        while (c < endp) {
+            if (len >= utf8)
+                return c - s.c_str();
+
+            c += UTF8::codepointLen(c, endp - c);
+            len++;
+        }
+        return s.size();
+    }
+
+    static size_t findFirstOf(const std::string& s, const std::string& ch, size_t offset) {
+        while (offset < s.length()) {
+            const auto c     = s.data() + offset;
+            const auto cpLen = UTF8::codepointLen(c, s.length() - offset);
+            if (std::string_view{c, cpLen} == ch)
+                return offset;
+            offset += cpLen;
+        }
+        return std::string::npos;
+    }
+}
+
+static std::string makeText(size_t bytes, std::mt19937& rng) {
+    static const std::array<std::string, 8> PIECES = {"a", "hello ", " ", "\n", "é", "世界", "ハイパー", "🧑‍🌾"};
+
+    std::string                             str;
+    str.reserve(bytes + 16);
+
+    while (str.size() < bytes) {
+        str += PIECES[rng() % PIECES.size()];
+    }
+
+    return str;
+}
+
+template <typename F>
+static double secondsFor(F&& fn) {
+    const auto BEGIN = std::chrono::steady_clock::now();
+    fn();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - BEGIN).count();
+}
+
+TEST(UTF8Benchmark, kernelsMatchScalar) {
+    std::mt19937 rng(0x48797072);
+    const auto   TEXT = makeText(4096, rng);
+
+    for (const auto IMPL : UTF8::SIMD::supportedImplementations()) {
+        // odd sizes and alignments, to hit the tails
+        for (size_t i = 0; i < 200; ++i) {
+            const size_t BEGIN = rng() % 64;
+            const size_t LEN   = rng() % (TEXT.size() - BEGIN);
+            const auto   DATA  = TEXT.data() + BEGIN;
+
+            const size_t STARTS = UTF8::SIMD::countStarts(DATA, LEN, UTF8::SIMD::IMPL_SCALAR);
+            EXPECT_EQ(UTF8::SIMD::countStarts(DATA, LEN, IMPL), STARTS) << UTF8::SIMD::implementationName(IMPL);
+
+            const size_t N = rng() % (STARTS + 2);
+            EXPECT_EQ(UTF8::SIMD::findNthStart(DATA, LEN, N, IMPL), UTF8::SIMD::findNthStart(DATA, LEN, N, UTF8::SIMD::IMPL_SCALAR))
+                << UTF8::SIMD::implementationName(IMPL);
+        }
+    }
+}
+
+TEST(UTF8Benchmark, throughput) {
+    std::mt19937 rng(0x746b);
+
+    for (const size_t SIZE : {1024UL, 64UL * 1024, 1024UL * 1024, 10UL * 1024 * 1024}) {
+        const auto TEXT = makeText(SIZE, rng);
+        const auto MB   = TEXT.size() / 1024.0 / 1024.0;
+
+        // results have to match what the byte walk gives
+        const size_t LENGTH = Reference::length(TEXT);
+        ASSERT_EQ(UTF8::length(TEXT), LENGTH);
+
+        for (size_t i = 0; i < 16; ++i) {
+            const size_t CP   = rng() % (LENGTH + 1);
+            const size_t BYTE = rng() % (TEXT.size() + 1);
+            EXPECT_EQ(UTF8::utf8ToOffset(TEXT, CP), Reference::utf8ToOffset(TEXT, CP));
+            EXPECT_EQ(UTF8::offsetToUTF8Len(TEXT, BYTE), Reference::offsetToUTF8Len(TEXT, BYTE));
+            EXPECT_EQ(UTF8::findFirstOf(TEXT, "🧑", BYTE), Reference::findFirstOf(TEXT, "🧑", BYTE));
+        }
+
+        // repeat small inputs, so that the timer has something to measure
+        const size_t ROUNDS = std::max<size_t>(1, (16UL * 1024 * 1024) / TEXT.size());
+        size_t       sink   = 0;
+
+        const double REFERENCE = secondsFor([&] {
+            for (size_t r = 0; r < ROUNDS; ++r) {
+                sink += Reference::length(TEXT);
+            }
+        });
+        std::println("UTF8 length, {:>9} B: {:>8} {:10.1f} MB/s", TEXT.size(), "walk", MB * ROUNDS / REFERENCE);
+
+        for (const auto IMPL : UTF8::SIMD::supportedImplementations()) {
+            const double SECONDS = secondsFor([&] {
+                for (size_t r = 0; r < ROUNDS; ++r) {
+                    sink += UTF8::SIMD::countStarts(TEXT.data(), TEXT.size(), IMPL);
+                }
+            });
+            std::println("UTF8 length, {:>9} B: {:>8} {:10.1f} MB/s", TEXT.size(), UTF8::SIMD::implementationName(IMPL), MB * ROUNDS / SECONDS);
+        }
+
+        // random access on the same text, with and without an index
+        constexpr size_t QUERIES = 1000;
+
+        UTF8::CCodepointIndex index;
+        const double          BUILD   = secondsFor([&] { index.rebuild(TEXT); });
+        const double          INDEXED = secondsFor([&] {
+            for (size_t q = 0; q < QUERIES; ++q) {
+                sink += index.utf8ToOffset(TEXT, (q * 7919) % LENGTH);
+            }
+        });
+        const double          PLAIN   = secondsFor([&] {
+            for (size_t q = 0; q < QUERIES; ++q) {
+                sink += UTF8::utf8ToOffset(TEXT, (q * 7919) % LENGTH);
+            }
+        });
+
+        for (size_t q = 0; q < QUERIES; q += 97) {
+            EXPECT_EQ(index.utf8ToOffset(TEXT, (q * 7919) % LENGTH), UTF8::utf8ToOffset(TEXT, (q * 7919) % LENGTH));
+        }
+
+        std::println("UTF8 {} x utf8ToOffset, {:>9} B: {:.3f}ms plain, {:.3f}ms indexed (+{:.3f}ms to build)", QUERIES, TEXT.size(), PLAIN * 1000, INDEXED * 1000,
+                     BUILD * 1000);
+
+        EXPECT_NE(sink, 0);
+    }
+}
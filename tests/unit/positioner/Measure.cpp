@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+
+#include <layout/Positioner.hpp>
+#include <element/Element.hpp>
+#include <hyprtoolkit/element/RowLayout.hpp>
+#include <hyprtoolkit/element/ColumnLayout.hpp>
+
+#include "../tricks/SizedElement.hpp"
+
+using namespace Hyprtoolkit;
+using namespace Hyprutils::Math;
+using namespace Hyprtoolkit::Tests::Tricks;
+
+TEST(Measure, nested) {
+    constexpr size_t LEVELS = 10;
+
+    // columns and rows in turn, every one sized by what's in it
+    std::vector<SP<IElement>> layouts;
+    for (size_t i = 0; i < LEVELS; ++i) {
+        if (i % 2 == 0)
+            layouts.emplace_back(CColumnLayoutBuilder::begin()->size({CDynamicSize::HT_SIZE_AUTO, CDynamicSize::HT_SIZE_AUTO, {1, 1}})->commence());
+        else
+            layouts.emplace_back(CRowLayoutBuilder::begin()->size({CDynamicSize::HT_SIZE_AUTO, CDynamicSize::HT_SIZE_AUTO, {1, 1}})->commence());
+
+        if (i > 0)
+            layouts.at(i - 1)->addChild(layouts.at(i));
+    }
+
+    auto leaf = CSizedElement::create({30, 20}, Vector2D{});
+    layouts.back()->addChild(leaf);
+
+    const auto ROOT = layouts.front();
+
+    // every layout measures each child a few times, without memoization that's thousands for the leaf
+    g_positioner->position(ROOT, {{}, {1000, 1000}});
+    EXPECT_LE(leaf->m_measured, LEVELS * 2);
+    EXPECT_EQ(leaf->impl->position.size(), Vector2D(30, 20));
+
+    // nothing changed, nothing to measure
+    leaf->m_measured = 0;
+    g_positioner->position(ROOT, {{}, {1000, 1000}});
+    EXPECT_EQ(leaf->m_measured, 0);
+
+    // a change is measured again, all the way up
+    leaf->setSize({50, 40});
+    EXPECT_FALSE(ROOT->impl->measureCache.preferred.valid);
+
+    g_positioner->position(ROOT, {{}, {1000, 1000}});
+    EXPECT_GT(leaf->m_measured, 0);
+    EXPECT_LE(leaf->m_measured, LEVELS * 2);
+    EXPECT_EQ(leaf->impl->position.size(), Vector2D(50, 40));
+}
+
+TEST(Measure, keyedOnParent) {
+    auto leaf = CSizedElement::create({30, 20}, Vector2D{});
+
+    EXPECT_EQ(*leaf->impl->measurePreferred({100, 100}), Vector2D(30, 20));
+    EXPECT_EQ(*leaf->impl->measurePreferred({100, 100}), Vector2D(30, 20));
+    EXPECT_EQ(leaf->m_measured, 1);
+
+    // another constraint might give another size
+    leaf->impl->measurePreferred({50, 100});
+    EXPECT_EQ(leaf->m_measured, 2);
+
+    // children change what a parent measures
+    auto column = CColumnLayoutBuilder::begin()->size({CDynamicSize::HT_SIZE_AUTO, CDynamicSize::HT_SIZE_AUTO, {1, 1}})->commence();
+    column->addChild(leaf);
+    EXPECT_EQ(*column->impl->measurePreferred({100, 100}), Vector2D(30, 20));
+
+    column->addChild(CSizedElement::create({10, 5}, Vector2D{}));
+    EXPECT_EQ(*column->impl->measurePreferred({100, 100}), Vector2D(30, 25));
+}
+
+TEST(Measure, resizeKeepsAncestors) {
+    auto outer = CColumnLayoutBuilder::begin()->size({CDynamicSize::HT_SIZE_AUTO, CDynamicSize::HT_SIZE_AUTO, {1, 1}})->commence();
+    auto inner = CColumnLayoutBuilder::begin()->size({CDynamicSize::HT_SIZE_AUTO, CDynamicSize::HT_SIZE_AUTO, {1, 1}})->commence();
+    auto leaf  = CSizedElement::create({30, 20}, Vector2D{});
+
+    outer->addChild(inner);
+    inner->addChild(leaf);
+
+    outer->impl->measurePreferred({1000, 1000});
+    const auto MEASURES = leaf->m_measured;
+
+    // placed at another size, like a layout pass does
+    inner->impl->setPosition({0, 0, 500, 500});
+    EXPECT_FALSE(inner->impl->measureCache.preferred.valid);
+    EXPECT_TRUE(outer->impl->measureCache.preferred.valid);
+
+    EXPECT_EQ(*outer->impl->measurePreferred({1000, 1000}), Vector2D(30, 20));
+    EXPECT_EQ(leaf->m_measured, MEASURES);
+}
@@ -0,0 +1,125 @@
+#include <gtest/gtest.h>
+
+#include <layout/Positioner.hpp>
+#include <element/Element.hpp>
+#include <hyprtoolkit/element/Null.hpp>
+#include <hyprtoolkit/element/ColumnLayout.hpp>
+
+#include "../tricks/SizedElement.hpp"
+
+using namespace Hyprtoolkit;
+using namespace Hyprutils::Math;
+using namespace Hyprtoolkit::Tests::Tricks;
+
+namespace {
+    // what a window does on a change
+    void resize(const SP<CSizedElement>& label, const Vector2D& size, std::vector<WP<IElement>>& changed) {
+        label->setSize(size);
+        changed.emplace_back(label->impl->self);
+    }
+
+    SP<CColumnLayoutElement> autoColumn() {
+        return CColumnLayoutBuilder::begin()->size({CDynamicSize::HT_SIZE_AUTO, CDynamicSize::HT_SIZE_AUTO, {1, 1}})->commence();
+    }
+}
+
+TEST(Relayout, boundaries) {
+    constexpr size_t CARDS = 10, LABELS = 100;
+
+    // an auto column of fixed size cards, each with an auto column of labels
+    auto                                  root = autoColumn();
+    std::vector<SP<CColumnLayoutElement>> columns;
+    std::vector<SP<CSizedElement>>        labels;
+    std::vector<size_t>                   columnLayouts(CARDS, 0);
+    size_t                                rootLayouts = 0;
+
+    root->impl->userFns.repositioned = [&rootLayouts] { rootLayouts++; };
+
+    for (size_t i = 0; i < CARDS; ++i) {
+        auto card   = CNullBuilder::begin()->size({CDynamicSize::HT_SIZE_ABSOLUTE, CDynamicSize::HT_SIZE_ABSOLUTE, {500, 2000}})->commence();
+        auto column = autoColumn();
+
+        column->impl->userFns.repositioned = [&columnLayouts, i] { columnLayouts.at(i)++; };
+
+        for (size_t j = 0; j < LABELS; ++j) {
+            labels.emplace_back(CSizedElement::create({100, 10}));
+            column->addChild(labels.back());
+        }
+
+        card->addChild(column);
+        root->addChild(card);
+        columns.emplace_back(column);
+    }
+
+    g_positioner->position(root, {{}, {1000, 20000}});
+    EXPECT_EQ(labels.back()->impl->position.y, ((CARDS - 1) * 2000) + ((LABELS - 1) * 10));
+
+    const auto RESET = [&] {
+        rootLayouts = 0;
+        std::ranges::fill(columnLayouts, 0);
+    };
+
+    // same size: every label is its own root, nothing around it moves
+    RESET();
+    std::vector<WP<IElement>> changed;
+    for (const auto& l : labels) {
+        resize(l, {100, 10}, changed);
+    }
+    g_positioner->relayout(changed);
+    EXPECT_EQ(rootLayouts, 0);
+    EXPECT_EQ(std::ranges::count(columnLayouts, 0), CARDS);
+
+    // taller: each column is laid out once, the cards keep their size so the root isn't
+    RESET();
+    changed.clear();
+    for (const auto& l : labels) {
+        resize(l, {100, 15}, changed);
+    }
+    g_positioner->relayout(changed);
+    EXPECT_EQ(rootLayouts, 0);
+    EXPECT_EQ(std::ranges::count(columnLayouts, 1), CARDS);
+    EXPECT_EQ(labels.back()->impl->position.y, ((CARDS - 1) * 2000) + ((LABELS - 1) * 15));
+    EXPECT_EQ(columns.front()->impl->position.h, LABELS * 15);
+
+    // a change in one card stays in that card
+    RESET();
+    changed.clear();
+    resize(labels.front(), {120, 20}, changed);
+    g_positioner->relayout(changed);
+    EXPECT_EQ(columnLayouts.front(), 1);
+    EXPECT_EQ(std::ranges::count(columnLayouts, 0), CARDS - 1);
+    EXPECT_EQ(labels.at(1)->impl->position.y, 20);
+}
+
+TEST(Relayout, stress) {
+    constexpr size_t LABELS = 1000, FRAMES = 100;
+
+    auto root   = CNullBuilder::begin()->size({CDynamicSize::HT_SIZE_ABSOLUTE, CDynamicSize::HT_SIZE_ABSOLUTE, {1000, 1000}})->commence();
+    auto column = autoColumn();
+
+    std::vector<SP<CSizedElement>> labels;
+    for (size_t i = 0; i < LABELS; ++i) {
+        labels.emplace_back(CSizedElement::create({100, 1}));
+        column->addChild(labels.back());
+    }
+    root->addChild(column);
+
+    g_positioner->position(root, {{}, {1000, 1000}});
+
+    // every label changes every frame, alternately keeping its size and not
+    std::vector<WP<IElement>> changed;
+    changed.reserve(LABELS);
+
+    for (size_t frame = 0; frame < FRAMES; ++frame) {
+        changed.clear();
+        for (size_t i = 0; i < LABELS; ++i) {
+            resize(labels.at(i), {100.F + ((frame / 2) % 2), 1}, changed);
+        }
+        g_positioner->relayout(changed);
+    }
+
+    for (size_t i = 0; i < LABELS; ++i) {
+        ASSERT_EQ(labels.at(i)->impl->position.y, i);
+        ASSERT_EQ(labels.at(i)->impl->position.w, 100.F + (((FRAMES - 1) / 2) % 2));
+    }
+}
@@ -0,0 +1,284 @@
+#include <gtest/gtest.h>
+
+#include <layout/StackSolver.hpp>
+#include <layout/Positioner.hpp>
+#include <element/Element.hpp>
+#include <hyprtoolkit/element/ColumnLayout.hpp>
+
+#include <random>
+
+#include "../tricks/SizedElement.hpp"
+
+using namespace Hyprtoolkit;
+using namespace Hyprutils::Math;
+using namespace Hyprtoolkit::Tests::Tricks;
+
+// what CColumnLayoutElement and CRowLayoutElement did before the stack solver, one adjustment at a time
+namespace Reference {
+    struct SResult {
+        std::vector<size_t>              sizes;
+        std::vector<std::optional<bool>> failed; // empty where it was left as it was
+
+        // false where the old arithmetic went below zero, the solver shrinks as intended there
+        bool exact = true;
+    };
+
+    // nearest first, false if the nearest that can shrink can't give enough
+    static bool shrink(const std::vector<SStackChild>& C, std::vector<size_t>& sizes, size_t i, float& needs) {
+        for (int j = i - 1; j >= 0; --j) {
+            const auto MIN = C.at(j).min;
+            if (!MIN) {
+                if (needs > sizes.at(j))
+                    return false;
+
+                sizes.at(j) -= needs;
+                needs = 0;
+                break;
+            } else if (*MIN < sizes.at(j)) {
+                if (needs > (sizes.at(j) - *MIN))
+                    return false;
+
+                sizes.at(j) -= needs;
+                needs = 0;
+                break;
+            }
+        }
+
+        return true;
+    }
+
+    static SResult column(const std::vector<SStackChild>& C, size_t MAX_Y, size_t gap) {
+        SResult r{.sizes = std::vector<size_t>(C.size()), .failed = std::vector<std::optional<bool>>(C.size())};
+        auto&   heights = r.sizes;
+        size_t  usedY   = 0;
+
+        for (size_t i = 0; i < C.size(); ++i) {
+            const double cSize = C.at(i).size;
+
+            if (usedY + cSize > MAX_Y + 1) {
+                float needs = (usedY + cSize) - (MAX_Y + 1);
+                if (!shrink(C, heights, i, needs)) {
+                    r.exact = false;
+                    return r;
+                }
+
+                if (needs > 0) {
+                    r.failed.at(i) = true;
+                    if (i != 0) {
+                        if (usedY > heights.at(i - 1) + MAX_Y) {
+                            r.exact = false;
+                            return r;
+                        }
+
+                        if (C.at(i - 1).max && heights.at(i - 1) + MAX_Y - usedY > *C.at(i - 1).max)
+                            continue;
+
+                        heights.at(i - 1) += MAX_Y - usedY;
+                    }
+                    continue;
+                }
+
+                r.failed.at(i) = false;
+                heights.at(i)  = cSize;
+
+                usedY = 0;
+                for (const auto& h : heights) {
+                    usedY += h + gap;
+                }
+                continue;
+            }
+
+            heights.at(i)  = cSize;
+            r.failed.at(i) = false;
+            usedY += cSize + gap;
+        }
+
+        if (!C.empty())
+            usedY -= gap;
+
+        if (usedY < MAX_Y) {
+            for (size_t i = 0; i < C.size(); ++i) {
+                if (!C.at(i).grow)
+                    continue;
+
+                heights.at(i) += MAX_Y - usedY;
+                break;
+            }
+        }
+
+        return r;
+    }
+
+    static SResult row(const std::vector<SStackChild>& C, float MAX_X, size_t gap) {
+        SResult r{.sizes = std::vector<size_t>(C.size()), .failed = std::vector<std::optional<bool>>(C.size())};
+        auto&   widths = r.sizes;
+        float   usedX  = 0;
+
+        for (size_t i = 0; i < C.size(); ++i) {
+            double cSize = C.at(i).size;
+
+            if (usedX + cSize > MAX_X + 2) {
+                if (!C.at(i).min) {
+                    r.failed.at(i) = true;
+                    continue;
+                }
+
+                cSize = *C.at(i).min;
+
+                if (usedX + cSize > MAX_X + 1) {
+                    float needs = (usedX + cSize) - (MAX_X + 1);
+                    if (!shrink(C, widths, i, needs)) {
+                        r.exact = false;
+                        return r;
+                    }
+
+                    if (needs > 0) {
+                        r.failed.at(i) = true;
+                        if (i != 0) {
+                            if (widths.at(i - 1) + MAX_X - usedX < 0) {
+                                r.exact = false;
+                                return r;
+                            }
+
+                            if (C.at(i - 1).max && widths.at(i - 1) + MAX_X - usedX > *C.at(i - 1).max)
+                                continue;
+
+                            widths.at(i - 1) += MAX_X - usedX;
+                        }
+                        continue;
+                    }
+
+                    r.failed.at(i) = false;
+                    widths.at(i)   = cSize;
+
+                    usedX = 0;
+                    for (const auto& w : widths) {
+                        usedX += w + gap;
+                    }
+                    continue;
+                }
+
+                if (MAX_X < usedX) {
+                    r.exact = false;
+                    return r;
+                }
+
+                widths.at(i) = MAX_X - usedX;
+                continue;
+            }
+
+            widths.at(i)   = cSize;
+            r.failed.at(i) = false;
+            usedX += cSize + gap;
+        }
+
+        if (!C.empty())
+            usedX -= gap;
+
+        if (usedX < MAX_X) {
+            for (size_t i = 0; i < C.size(); ++i) {
+                if (!C.at(i).grow)
+                    continue;
+
+                widths.at(i) += MAX_X - usedX;
+                break;
+            }
+        }
+
+        return r;
+    }
+}
+
+namespace {
+    std::vector<SStackChild> randomChildren(std::mt19937& rng) {
+        const auto               RANDOM = [&rng](int min, int max) { return std::uniform_int_distribution<int>(min, max)(rng); };
+
+        std::vector<SStackChild> children(RANDOM(1, 40));
+        for (auto& c : children) {
+            c.size = RANDOM(0, 60);
+            if (RANDOM(0, 1))
+                c.min = RANDOM(0, c.size + 10);
+            if (RANDOM(0, 4) == 0)
+                c.max = c.size + RANDOM(0, 100);
+            c.grow = RANDOM(0, 9) == 0;
+        }
+
+        return children;
+    }
+
+    // the boxes of what's laid out, and what's left out
+    void expectSame(const Reference::SResult& reference, const SStackSolution& solved) {
+        for (size_t i = 0; i < solved.sizes.size(); ++i) {
+            if (reference.failed.at(i).has_value())
+                ASSERT_EQ(*reference.failed.at(i), solved.failed.at(i)) << "child " << i;
+
+            if (!solved.failed.at(i))
+                ASSERT_EQ(reference.sizes.at(i), solved.sizes.at(i)) << "child " << i;
+        }
+    }
+}
+
+TEST(StackSolver, matchesReference) {
+    std::mt19937 rng(42);
+
+    size_t       compared = 0;
+    for (size_t round = 0; round < 4000; ++round) {
+        const auto   CHILDREN = randomChildren(rng);
+        const size_t MAX      = std::uniform_int_distribution<size_t>(0, 1200)(rng);
+        const size_t GAP      = std::uniform_int_distribution<size_t>(0, 2)(rng) * 2;
+
+        const auto   COLUMN = Reference::column(CHILDREN, MAX, GAP);
+        if (COLUMN.exact) {
+            compared++;
+            expectSame(COLUMN, solveStack(CHILDREN, MAX, GAP, {.overflowSlack = 1, .wholePixels = true}));
+        }
+
+        const auto ROW = Reference::row(CHILDREN, MAX, GAP);
+        if (ROW.exact) {
+            compared++;
+            expectSame(ROW, solveStack(CHILDREN, MAX, GAP, {.overflowSlack = 2, .tryMinimum = true}));
+        }
+    }
+
+    // about half, the rest made the old one shrink more than one child
+    EXPECT_GT(compared, 3000);
+}
+
+TEST(StackSolver, shrinksSeveral) {
+    // the old solver's arithmetic went below zero here
+    const std::vector<SStackChild> CHILDREN = {{.size = 30, .min = 20}, {.size = 30, .min = 25}, {.size = 30}};
+
+    const auto                     SOLVED = solveStack(CHILDREN, 80, 0, {.overflowSlack = 1, .wholePixels = true});
+    EXPECT_EQ(SOLVED.sizes, (std::vector<size_t>{26, 25, 30}));
+    EXPECT_EQ(SOLVED.failed, (std::vector<bool>{false, false, false}));
+
+    // nothing shrinks for a child that won't fit anyway
+    const auto TOO_BIG = solveStack({{.size = 30, .min = 20}, {.size = 30}, {.size = 100}}, 80, 0, {.overflowSlack = 1, .wholePixels = true});
+    EXPECT_EQ(TOO_BIG.sizes, (std::vector<size_t>{30, 50, 0}));
+    EXPECT_EQ(TOO_BIG.failed, (std::vector<bool>{false, false, true}));
+}
+
+TEST(StackSolver, manyChildren) {
+    constexpr size_t         CHILDREN = 10000;
+
+    // half fill it, the other half each shrinks the one before
+    std::vector<SStackChild> children(CHILDREN, SStackChild{.size = 2, .min = 0});
+
+    const auto               REFERENCE = Reference::column(children, CHILDREN, 0);
+    const auto               SOLVED    = solveStack(children, CHILDREN, 0, {.overflowSlack = 1, .wholePixels = true});
+
+    ASSERT_TRUE(REFERENCE.exact);
+    expectSame(REFERENCE, SOLVED);
+
+    // and the whole column
+    auto column = CColumnLayoutBuilder::begin()->size({CDynamicSize::HT_SIZE_ABSOLUTE, CDynamicSize::HT_SIZE_ABSOLUTE, {100, CHILDREN}})->commence();
+    for (size_t i = 0; i < CHILDREN; ++i) {
+        column->addChild(CSizedElement::create({100, 2}, Vector2D{0, 0}));
+    }
+
+    g_positioner->position(column, {{}, {100, CHILDREN}});
+
+    EXPECT_EQ(column->impl->children.front()->impl->position.h, 2);
+    EXPECT_EQ(column->impl->children.at(CHILDREN / 2)->impl->position.h, 0);
+    EXPECT_EQ(column->impl->children.back()->impl->position.h, 2);
+}
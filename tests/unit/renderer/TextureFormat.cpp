@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+
+#include <renderer/TextureFormat.hpp>
+
+#include <cmath>
+
+using namespace Hyprtoolkit;
+
+namespace {
+    // cairo ARGB32, BGRA in memory and premultiplied, with a padded stride like cairo would
+    class CPixels {
+      public:
+        CPixels(size_t w, size_t h) : m_w(w), m_h(h), m_stride((w * 4) + 8), m_data(m_stride * h, 0) {
+            ;
+        }
+
+        void set(size_t x, size_t y, uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
+            uint8_t* px = m_data.data() + (y * m_stride) + (x * 4);
+            px[0]       = std::round(b * a / 255.F);
+            px[1]       = std::round(g * a / 255.F);
+            px[2]       = std::round(r * a / 255.F);
+            px[3]       = a;
+        }
+
+        void fill(uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
+            for (size_t y = 0; y < m_h; ++y) {
+                for (size_t x = 0; x < m_w; ++x) {
+                    set(x, y, r, g, b, a);
+                }
+            }
+        }
+
+        SPackedPixels pack(bool lossy = false) {
+            return packPixels(m_data.data(), {static_cast<double>(m_w), static_cast<double>(m_h)}, m_stride, lossy);
+        }
+
+        size_t               m_w = 0, m_h = 0, m_stride = 0;
+        std::vector<uint8_t> m_data;
+    };
+}
+
+TEST(TextureFormat, mask) {
+    // antialiased text: one color at varying coverage
+    CPixels text(5, 3);
+    for (size_t x = 0; x < 5; ++x) {
+        text.set(x, 1, 200, 100, 50, x * 60);
+    }
+
+    const auto PACKED = text.pack();
+    ASSERT_EQ(PACKED.format, TEXTURE_FORMAT_MASK8);
+    ASSERT_EQ(PACKED.data.size(), 15);
+    EXPECT_EQ(PACKED.data[5 + 4], 240);
+    EXPECT_EQ(PACKED.data[0], 0);
+    EXPECT_NEAR(PACKED.color.r, 200 / 255.F, 0.01);
+    EXPECT_NEAR(PACKED.color.g, 100 / 255.F, 0.01);
+    EXPECT_NEAR(PACKED.color.b, 50 / 255.F, 0.01);
+
+    // nothing at all is a mask too
+    EXPECT_EQ(CPixels(4, 4).pack().format, TEXTURE_FORMAT_MASK8);
+}
+
+TEST(TextureFormat, gray) {
+    CPixels photo(4, 2);
+    for (size_t x = 0; x < 4; ++x) {
+        photo.set(x, 0, x * 30, x * 30, x * 30, 255);
+        photo.set(x, 1, 255 - x, 255 - x, 255 - x, 255);
+    }
+
+    const auto PACKED = photo.pack();
+    ASSERT_EQ(PACKED.format, TEXTURE_FORMAT_GRAY8);
+    ASSERT_EQ(PACKED.data.size(), 8);
+    EXPECT_EQ(PACKED.data[3], 90);
+    EXPECT_EQ(PACKED.data[4], 255);
+}
+
+TEST(TextureFormat, color) {
+    CPixels icon(2, 2);
+    icon.set(0, 0, 255, 0, 0, 255);
+    icon.set(1, 0, 0, 255, 0, 128);
+    icon.set(0, 1, 0, 0, 255, 255);
+    icon.set(1, 1, 10, 20, 30, 0);
+
+    // colorful stays as it is unless it may lose precision
+    const auto PACKED = icon.pack();
+    EXPECT_EQ(PACKED.format, TEXTURE_FORMAT_RGBA8);
+    EXPECT_TRUE(PACKED.data.empty());
+
+    const auto LOSSY = icon.pack(true);
+    ASSERT_EQ(LOSSY.format, TEXTURE_FORMAT_RGBA4);
+    ASSERT_EQ(LOSSY.data.size(), 8);
+    EXPECT_EQ(reinterpret_cast<const uint16_t*>(LOSSY.data.data())[0], 0xF00F);
+
+    CPixels opaque(2, 1);
+    opaque.set(0, 0, 255, 0, 0, 255);
+    opaque.set(1, 0, 0, 0, 255, 255);
+
+    const auto OPAQUE = opaque.pack(true);
+    ASSERT_EQ(OPAQUE.format, TEXTURE_FORMAT_RGB565);
+    EXPECT_EQ(reinterpret_cast<const uint16_t*>(OPAQUE.data.data())[0], 0xF800);
+    EXPECT_EQ(reinterpret_cast<const uint16_t*>(OPAQUE.data.data())[1], 0x001F);
+
+    EXPECT_EQ(textureFormatBytesPerPixel(OPAQUE.format), 2);
+}
@@ -0,0 +1,48 @@
+#include <gtest/gtest.h>
+
+#include <renderer/TextureRegistry.hpp>
+
+using namespace Hyprtoolkit;
+
+TEST(TextureRegistry, accounting) {
+    CTextureRegistry registry;
+    int              texA = 0, texB = 0, texC = 0;
+    int              windowA = 0, windowB = 0;
+
+    registry.set(&texA, 1000);
+    registry.set(&texB, 200);
+    registry.set(&texC, 30);
+    registry.setPooledBytes(4);
+
+    auto stats = registry.stats();
+    EXPECT_EQ(stats.textures, 3);
+    EXPECT_EQ(stats.bytes, 1234);
+    EXPECT_EQ(stats.pooledBytes, 4);
+
+    // respecified storage replaces what was there
+    registry.set(&texA, 500);
+    EXPECT_EQ(registry.stats().bytes, 734);
+
+    registry.setOwner(&texA, &windowA);
+    registry.setOwner(&texB, &windowA);
+    registry.setOwner(&texC, &windowB);
+    EXPECT_EQ(registry.bytesFor(&windowA), 700);
+    EXPECT_EQ(registry.bytesFor(&windowB), 30);
+
+    // drawn by another window since
+    registry.setOwner(&texB, &windowB);
+    EXPECT_EQ(registry.bytesFor(&windowA), 500);
+    EXPECT_EQ(registry.bytesFor(&windowB), 230);
+
+    registry.remove(&texB);
+    EXPECT_EQ(registry.bytesFor(&windowB), 30);
+    EXPECT_EQ(registry.stats().textures, 2);
+
+    registry.forgetOwner(&windowA);
+    EXPECT_EQ(registry.bytesFor(&windowA), 0);
+    EXPECT_EQ(registry.stats().bytes, 534);
+
+    // not registered, nothing to attribute
+    registry.setOwner(&texB, &windowA);
+    EXPECT_EQ(registry.bytesFor(&windowA), 0);
+}
@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+
+#include <resource/assetCache/AssetCache.hpp>
+
+#include "../tricks/Tricks.hpp"
+#include "../tricks/FakeTexture.hpp"
+
+using namespace Hyprtoolkit;
+using namespace Hyprtoolkit::Asset;
+using namespace Hyprtoolkit::Tests::Tricks;
+
+static SP<CAssetCacheEntry> makeEntry(const std::string& source) {
+    return makeShared<CAssetCacheEntry>(source, makeShared<CFakeTexture>(Hyprutils::Math::Vector2D{64, 64}));
+}
+
+constexpr size_t ENTRY_BYTES = 64 * 64 * 4;
+
+TEST(AssetCache, lru) {
+    Tests::Tricks::createBackendSupport();
+
+    auto cache = makeShared<CAssetCache>();
+    cache->setBudget(1024 * 1024, ENTRY_BYTES * 3);
+
+    for (const auto& s : {"a", "b", "c", "d"}) {
+        cache->cache(makeEntry(s));
+    }
+
+    // nobody holds these, only the 3 most recent are left
+    auto stats = cache->stats();
+    EXPECT_EQ(stats.retained, 3);
+    EXPECT_EQ(stats.evictions, 1);
+    EXPECT_EQ(stats.gpuBytes, ENTRY_BYTES * 3);
+
+    EXPECT_FALSE(cache->get("a"));
+    EXPECT_TRUE(cache->get("b"));
+
+    // b is now the most recent, so c goes first
+    cache->cache(makeEntry("e"));
+    EXPECT_TRUE(cache->get("b"));
+    EXPECT_FALSE(cache->get("c"));
+
+    stats = cache->stats();
+    EXPECT_EQ(stats.hits, 2);
+    EXPECT_EQ(stats.misses, 2);
+    EXPECT_EQ(stats.evictions, 2);
+}
+
+TEST(AssetCache, trim) {
+    Tests::Tricks::createBackendSupport();
+
+    auto cache = makeShared<CAssetCache>();
+    auto inUse = makeEntry("used");
+
+    cache->cache(inUse);
+    cache->cache(makeEntry("unused"));
+
+    cache->trim();
+
+    EXPECT_EQ(cache->stats().retained, 0);
+    EXPECT_EQ(cache->stats().gpuBytes, 0);
+
+    // still alive thanks to us, so still findable
+    EXPECT_EQ(cache->get("used"), inUse);
+    EXPECT_FALSE(cache->get("unused"));
+}
+
+TEST(AssetCache, pending) {
+    Tests::Tricks::createBackendSupport();
+
+    auto cache = makeShared<CAssetCache>();
+    auto entry = makeShared<CAssetCacheEntry>("pending");
+
+    cache->cache(entry);
+    EXPECT_EQ(cache->stats().gpuBytes, 0);
+
+    entry->texDone(makeShared<CFakeTexture>(Hyprutils::Math::Vector2D{64, 64}));
+    EXPECT_EQ(cache->stats().gpuBytes, ENTRY_BYTES);
+
+    // not retained entries are only findable while in use
+    auto data = makeEntry("data");
+    cache->cache(data, false);
+    EXPECT_EQ(cache->stats().retained, 1);
+    EXPECT_EQ(cache->get("data"), data);
+    data.reset();
+    EXPECT_FALSE(cache->get("data"));
+}
@@ -0,0 +1,149 @@
+#include <gtest/gtest.h>
+
+#include <resource/decode/DecodeScheduler.hpp>
+
+#include "../tricks/Tricks.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <format>
+#include <mutex>
+
+using namespace Hyprtoolkit;
+using namespace Hyprtoolkit::Asset;
+
+namespace {
+    // keeps the workers busy until opened, so that everything after it queues up
+    class CGate {
+      public:
+        void wait() {
+            std::unique_lock<std::mutex> lk(m_mutex);
+            m_cv.wait(lk, [this] { return m_open; });
+        }
+
+        void open() {
+            {
+                std::lock_guard<std::mutex> lg(m_mutex);
+                m_open = true;
+            }
+            m_cv.notify_all();
+        }
+
+      private:
+        std::mutex              m_mutex;
+        std::condition_variable m_cv;
+        bool                    m_open = false;
+    };
+}
+
+TEST(DecodeScheduler, visibleFirst) {
+    Tests::Tricks::createBackendSupport();
+
+    constexpr size_t    ITEMS = 2000, ROW = 10;
+
+    auto                scheduler = CDecodeScheduler::create(1);
+    CGate               gate;
+
+    std::mutex          orderMutex;
+    std::vector<size_t> order;
+    std::atomic<size_t> ran = 0;
+
+    auto                gateTicket = scheduler->submit("gate", DECODE_PRIORITY_VISIBLE, [&gate] { gate.wait(); }, nullptr);
+
+    // a grid of thumbnails, the first rows on screen and the next ones close to it, the way they'd be when it's opened
+    std::vector<SP<CDecodeTicket>> tickets;
+    for (size_t i = 0; i < ITEMS; ++i) {
+        const auto PRIORITY = i < ROW * 4 ? DECODE_PRIORITY_VISIBLE : i < ROW * 10 ? DECODE_PRIORITY_NEAR : DECODE_PRIORITY_PREFETCH;
+        tickets.emplace_back(scheduler->submit(
+            std::format("thumb-{}", i), PRIORITY, [&ran] { ran++; },
+            [&, i] {
+                std::lock_guard<std::mutex> lg(orderMutex);
+                order.emplace_back(i);
+            }));
+    }
+
+    // scrolled to the middle before any of it got done: what was on screen is gone, the middle is visible now
+    constexpr size_t FIRST_VISIBLE = 1000, VISIBLE = ROW * 4, NEAR = ROW * 6;
+
+    for (size_t i = 0; i < ROW * 10; ++i) {
+        tickets[i].reset();
+    }
+
+    for (size_t i = FIRST_VISIBLE; i < FIRST_VISIBLE + VISIBLE + NEAR; ++i) {
+        tickets[i]->setPriority(i < FIRST_VISIBLE + VISIBLE ? DECODE_PRIORITY_VISIBLE : DECODE_PRIORITY_NEAR);
+    }
+
+    gate.open();
+    scheduler->flush();
+
+    ASSERT_EQ(order.size(), ITEMS - ROW * 10);
+    EXPECT_EQ(ran, ITEMS - ROW * 10);
+
+    for (size_t i = 0; i < VISIBLE; ++i) {
+        EXPECT_GE(order[i], FIRST_VISIBLE);
+        EXPECT_LT(order[i], FIRST_VISIBLE + VISIBLE);
+    }
+
+    for (size_t i = VISIBLE; i < VISIBLE + NEAR; ++i) {
+        EXPECT_GE(order[i], FIRST_VISIBLE + VISIBLE);
+        EXPECT_LT(order[i], FIRST_VISIBLE + VISIBLE + NEAR);
+    }
+
+    // what was scrolled away never ran
+    for (const auto& i : order) {
+        EXPECT_GE(i, ROW * 10);
+    }
+
+    const auto STATS = scheduler->stats();
+    EXPECT_EQ(STATS.cancelled, ROW * 10);
+    EXPECT_EQ(STATS.decoded, ITEMS - ROW * 10 + 1);
+}
+
+TEST(DecodeScheduler, deduplicate) {
+    Tests::Tricks::createBackendSupport();
+
+    auto                scheduler = CDecodeScheduler::create(2);
+    CGate               gate;
+    std::atomic<size_t> ran = 0, done = 0;
+
+    auto gateTicket = scheduler->submit("gate", DECODE_PRIORITY_VISIBLE, [&gate] { gate.wait(); }, nullptr);
+    auto gate2      = scheduler->submit("gate2", DECODE_PRIORITY_VISIBLE, [&gate] { gate.wait(); }, nullptr);
+
+    auto a = scheduler->submit("same", DECODE_PRIORITY_PREFETCH, [&ran] { ran++; }, [&done] { done++; });
+    auto b = scheduler->submit("same", DECODE_PRIORITY_VISIBLE, [&ran] { ran++; }, [&done] { done++; });
+    auto c = scheduler->submit("same", DECODE_PRIORITY_NEAR, [&ran] { ran++; }, [&done] { done++; });
+
+    // one of three cancelled, the others still get it
+    c.reset();
+
+    gate.open();
+    scheduler->flush();
+
+    EXPECT_EQ(ran, 1);
+    EXPECT_EQ(done, 2);
+    EXPECT_EQ(scheduler->stats().deduplicated, 2);
+    EXPECT_EQ(scheduler->stats().cancelled, 0);
+
+    // all of them cancelled, it never runs
+    CGate gate3;
+    auto  gate3Ticket = scheduler->submit("gate3", DECODE_PRIORITY_VISIBLE, [&gate3] { gate3.wait(); }, nullptr);
+    auto  gate4Ticket = scheduler->submit("gate4", DECODE_PRIORITY_VISIBLE, [&gate3] { gate3.wait(); }, nullptr);
+    auto  d           = scheduler->submit("other", DECODE_PRIORITY_VISIBLE, [&ran] { ran++; }, [&done] { done++; });
+    auto  e           = scheduler->submit("other", DECODE_PRIORITY_VISIBLE, [&ran] { ran++; }, [&done] { done++; });
+    d.reset();
+    e.reset();
+
+    gate3.open();
+    scheduler->flush();
+
+    EXPECT_EQ(ran, 1);
+    EXPECT_EQ(done, 2);
+    EXPECT_EQ(scheduler->stats().cancelled, 1);
+}
+
+TEST(DecodeScheduler, workers) {
+    Tests::Tricks::createBackendSupport();
+
+    EXPECT_EQ(CDecodeScheduler::create(3)->workers(), 3);
+    EXPECT_GE(CDecodeScheduler::create()->workers(), 1);
+}
@@ -0,0 +1,186 @@
+#include <gtest/gtest.h>
+
+#include <resource/diskCache/ImageDiskCache.hpp>
+#include <hyprutils/memory/Casts.hpp>
+
+#include "../tricks/Tricks.hpp"
+
+#include <cstring>
+#include <format>
+#include <fstream>
+#include <unistd.h>
+
+using namespace Hyprtoolkit;
+using namespace Hyprtoolkit::Asset;
+
+namespace {
+    // a scratch cache directory and a fake source image in it
+    class CScratch {
+      public:
+        CScratch() {
+            m_dir = std::filesystem::temp_directory_path() / std::format("hyprtoolkit-disk-cache-test-{}", getpid());
+            std::filesystem::remove_all(m_dir);
+            std::filesystem::create_directories(m_dir / "cache");
+
+            m_source = m_dir / "source.png";
+            touchSource("v1");
+        }
+
+        ~CScratch() {
+            std::filesystem::remove_all(m_dir);
+        }
+
+        void touchSource(const std::string& contents) {
+            std::ofstream ofs(m_source, std::ios::trunc);
+            ofs << contents;
+        }
+
+        std::filesystem::path m_dir, m_source;
+    };
+}
+
+static std::vector<uint8_t> makePixels(size_t w, size_t h, uint8_t seed) {
+    std::vector<uint8_t> pixels(w * h * 4);
+    for (size_t i = 0; i < pixels.size(); ++i) {
+        pixels[i] = sc<uint8_t>(i * 31 + seed);
+    }
+    return pixels;
+}
+
+static std::vector<std::filesystem::path> cacheFiles(const std::filesystem::path& dir) {
+    std::vector<std::filesystem::path> files;
+    for (const auto& e : std::filesystem::directory_iterator(dir)) {
+        files.emplace_back(e.path());
+    }
+    return files;
+}
+
+TEST(ImageDiskCache, coldAndWarm) {
+    Tests::Tricks::createBackendSupport();
+
+    CScratch             scratch;
+    CImageDiskCache      cache(scratch.m_dir / "cache", 64 * 1024 * 1024);
+
+    const SImageCacheKey KEY    = {.path = scratch.m_source.string(), .pixelSize = {64, 48}, .scale = 2.F};
+    const auto           PIXELS = makePixels(64, 48, 7);
+
+    // cold
+    EXPECT_FALSE(cache.load(KEY));
+
+    ASSERT_TRUE(cache.store(KEY, PIXELS.data(), {64, 48}, 64 * 4));
+    EXPECT_GT(cache.bytes(), PIXELS.size());
+
+    // warm, and the same pixels come back
+    const auto MAPPED = cache.load(KEY);
+
+    ASSERT_TRUE(MAPPED);
+    EXPECT_EQ(MAPPED->size(), Hyprutils::Math::Vector2D(64, 48));
+    EXPECT_EQ(MAPPED->stride(), 64 * 4);
+    EXPECT_EQ(std::memcmp(MAPPED->pixels(), PIXELS.data(), PIXELS.size()), 0);
+    EXPECT_EQ(rc<uintptr_t>(MAPPED->pixels()) % 64, 0);
+    EXPECT_TRUE(cache.verify(*MAPPED));
+
+    // a different size or scale is a different entry
+    EXPECT_FALSE(cache.load({.path = KEY.path, .pixelSize = {64, 48}, .scale = 1.F}));
+    EXPECT_FALSE(cache.load({.path = KEY.path, .pixelSize = {32, 24}, .scale = 2.F}));
+
+    // and so is a new cache on the same directory, i.e. the next start
+    CImageDiskCache cache2(scratch.m_dir / "cache", 64 * 1024 * 1024);
+    EXPECT_EQ(cache2.bytes(), cache.bytes());
+    EXPECT_TRUE(cache2.load(KEY));
+
+    // storing it again replaces it, it's not counted twice
+    const auto BYTES = cache.bytes();
+    ASSERT_TRUE(cache.store(KEY, PIXELS.data(), {64, 48}, 64 * 4));
+    EXPECT_EQ(cache.bytes(), BYTES);
+}
+
+TEST(ImageDiskCache, sourceChanged) {
+    Tests::Tricks::createBackendSupport();
+
+    CScratch             scratch;
+    CImageDiskCache      cache(scratch.m_dir / "cache", 64 * 1024 * 1024);
+
+    const SImageCacheKey KEY    = {.path = scratch.m_source.string()};
+    const auto           PIXELS = makePixels(16, 16, 1);
+
+    ASSERT_TRUE(cache.store(KEY, PIXELS.data(), {16, 16}, 16 * 4));
+    EXPECT_TRUE(cache.load(KEY));
+
+    // a different size is enough, even within the same mtime granularity
+    scratch.touchSource("version two");
+    EXPECT_FALSE(cache.load(KEY));
+
+    // sources that don't exist are never cached
+    EXPECT_FALSE(cache.store({.path = (scratch.m_dir / "nope.png").string()}, PIXELS.data(), {16, 16}, 16 * 4));
+}
+
+TEST(ImageDiskCache, corrupt) {
+    Tests::Tricks::createBackendSupport();
+
+    CScratch             scratch;
+    CImageDiskCache      cache(scratch.m_dir / "cache", 64 * 1024 * 1024);
+
+    const SImageCacheKey KEY    = {.path = scratch.m_source.string()};
+    const auto           PIXELS = makePixels(16, 16, 2);
+
+    ASSERT_TRUE(cache.store(KEY, PIXELS.data(), {16, 16}, 16 * 4));
+
+    auto files = cacheFiles(scratch.m_dir / "cache");
+    ASSERT_EQ(files.size(), 1);
+
+    // flip a byte in the last pixel
+    {
+        std::fstream fs(files[0], std::ios::in | std::ios::out | std::ios::binary);
+        fs.seekp(-1, std::ios::end);
+        fs.put('\x42' ^ PIXELS.back());
+    }
+
+    // the header is still fine, the pixels are only checked by verify
+    const auto MAPPED = cache.load(KEY);
+    ASSERT_TRUE(MAPPED);
+    EXPECT_FALSE(cache.verify(*MAPPED));
+
+    // and it's gone
+    EXPECT_TRUE(cacheFiles(scratch.m_dir / "cache").empty());
+    EXPECT_FALSE(cache.load(KEY));
+
+    // truncated
+    ASSERT_TRUE(cache.store(KEY, PIXELS.data(), {16, 16}, 16 * 4));
+    files = cacheFiles(scratch.m_dir / "cache");
+    ASSERT_EQ(files.size(), 1);
+    std::filesystem::resize_file(files[0], 100);
+
+    EXPECT_FALSE(cache.load(KEY));
+}
+
+TEST(ImageDiskCache, eviction) {
+    Tests::Tricks::createBackendSupport();
+
+    CScratch         scratch;
+
+    const auto       PIXELS = makePixels(64, 64, 3);
+    constexpr size_t CAP    = 64 * 64 * 4 * 3 + 1024;
+
+    CImageDiskCache  cache(scratch.m_dir / "cache", CAP);
+
+    const auto       KEY = [&](int i) { return SImageCacheKey{.path = scratch.m_source.string(), .pixelSize = {sc<double>(i), 64}}; };
+
+    for (int i = 1; i <= 3; ++i) {
+        ASSERT_TRUE(cache.store(KEY(i), PIXELS.data(), {64, 64}, 64 * 4));
+    }
+
+    EXPECT_LE(cache.bytes(), CAP);
+    EXPECT_TRUE(cache.load(KEY(1)));
+
+    // mtime is what orders entries, make sure 1 is the most recently used one
+    usleep(20000);
+    EXPECT_TRUE(cache.load(KEY(1)));
+
+    ASSERT_TRUE(cache.store(KEY(4), PIXELS.data(), {64, 64}, 64 * 4));
+
+    EXPECT_LE(cache.bytes(), CAP);
+    EXPECT_TRUE(cache.load(KEY(1)));
+    EXPECT_TRUE(cache.load(KEY(4)));
+    EXPECT_LT(cacheFiles(scratch.m_dir / "cache").size(), 4);
+}
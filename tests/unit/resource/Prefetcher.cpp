@@ -0,0 +1,52 @@
+#include <gtest/gtest.h>
+
+#include <resource/prefetch/Prefetcher.hpp>
+#include <resource/assetCache/AssetCache.hpp>
+#include <resource/decode/DecodeScheduler.hpp>
+#include <element/image/Image.hpp>
+#include <element/Element.hpp>
+#include <core/InternalBackend.hpp>
+
+#include "../tricks/Tricks.hpp"
+
+using namespace Hyprtoolkit;
+using namespace Hyprutils::Math;
+
+TEST(Prefetcher, imageIsACacheHit) {
+    // decodes finish into idles, which nothing runs here, so the load stays pending
+    Tests::Tricks::createBackend();
+
+    const auto SCHEDULER = g_decodeScheduler;
+    g_decodeScheduler    = Asset::CDecodeScheduler::create(1);
+
+    const SImageData DATA = {
+        .path = "/tmp/hyprtoolkit-prefetch-test.png",
+        .size = CDynamicSize{CDynamicSize::HT_SIZE_ABSOLUTE, CDynamicSize::HT_SIZE_ABSOLUTE, {64, 64}},
+    };
+
+    CPrefetcher prefetcher;
+    prefetcher.prefetch(SPrefetchRequest{
+        .type   = SPrefetchRequest::HT_PREFETCH_IMAGE,
+        .source = DATA.path,
+        .size   = {64, 64},
+    });
+
+    EXPECT_EQ(prefetcher.pending(), 1);
+    EXPECT_EQ(g_decodeScheduler->stats().submitted, 1);
+
+    const auto HITS = Asset::assetCache()->stats().hits;
+
+    // later, an element showing it, laid out at the size it was prefetched for
+    auto element               = CImageElement::create(DATA);
+    element->impl->position    = {{}, {64, 64}};
+    element->m_impl->lastScale = 1.F;
+    element->renderTex();
+
+    // it's the prefetch's entry, and nothing was decoded again
+    EXPECT_EQ(Asset::assetCache()->stats().hits, HITS + 1);
+    EXPECT_TRUE(element->m_impl->waitingForTex);
+    EXPECT_EQ(g_decodeScheduler->stats().submitted, 1);
+
+    g_decodeScheduler->flush();
+    g_decodeScheduler = SCHEDULER;
+}
@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+
+#include <resource/assetCache/SvgRasterCache.hpp>
+
+#include "../tricks/Tricks.hpp"
+#include "../tricks/FakeTexture.hpp"
+
+#include <algorithm>
+
+using namespace Hyprtoolkit;
+using namespace Hyprtoolkit::Asset;
+using namespace Hyprtoolkit::Tests::Tricks;
+using namespace Hyprutils::Math;
+
+static SP<CAssetCacheEntry> makeRaster(const Vector2D& size) {
+    return makeShared<CAssetCacheEntry>("raster", makeShared<CFakeTexture>(size));
+}
+
+TEST(SvgRasterCache, rasterSize) {
+    Tests::Tricks::createBackendSupport();
+
+    // the usual icon sizes are exact
+    for (const auto& s : {16.0, 24.0, 32.0, 48.0, 64.0, 128.0, 256.0}) {
+        EXPECT_EQ(CSvgRasterCache::rasterSizeFor({s, s}), Vector2D(s, s));
+    }
+
+    EXPECT_EQ(CSvgRasterCache::rasterSizeFor({22, 22}), Vector2D(24, 24));
+    EXPECT_EQ(CSvgRasterCache::rasterSizeFor({24.0000001, 24.0000001}), Vector2D(24, 24));
+    EXPECT_EQ(CSvgRasterCache::rasterSizeFor({0, 24}), Vector2D{});
+
+    // aspect ratio is kept, not squared
+    EXPECT_EQ(CSvgRasterCache::rasterSizeFor({200, 100}), Vector2D(215, 108));
+    EXPECT_EQ(CSvgRasterCache::rasterSizeFor({30, 60}), Vector2D(30, 60));
+
+    // never smaller than asked, at most a step above, and stable
+    for (double s = 1; s < 4096; s += 7) {
+        const auto SIZE = CSvgRasterCache::rasterSizeFor({s, s / 2});
+        EXPECT_GE(SIZE.x, s);
+        EXPECT_LE(SIZE.x, std::max(s * 1.1, s + 4));
+        EXPECT_EQ(CSvgRasterCache::rasterSizeFor(SIZE), SIZE);
+    }
+
+    // small resizes land on the same raster
+    EXPECT_EQ(CSvgRasterCache::rasterSizeFor({300, 300}), CSvgRasterCache::rasterSizeFor({303, 303}));
+}
+
+TEST(SvgRasterCache, nearest) {
+    Tests::Tricks::createBackendSupport();
+
+    CSvgRasterCache cache;
+
+    EXPECT_FALSE(cache.nearest("a.svg", {32, 32}));
+
+    auto small = makeRaster({32, 32}), medium = makeRaster({64, 64}), large = makeRaster({128, 128});
+    cache.add("a.svg", large);
+    cache.add("a.svg", small);
+    cache.add("a.svg", medium);
+
+    // the smallest one that covers it
+    EXPECT_EQ(cache.nearest("a.svg", {40, 40}), medium);
+    EXPECT_EQ(cache.nearest("a.svg", {64, 64}), medium);
+    EXPECT_EQ(cache.nearest("a.svg", {100, 60}), large);
+    EXPECT_EQ(cache.nearest("a.svg", {16, 16}), small);
+
+    // otherwise the largest there is
+    EXPECT_EQ(cache.nearest("a.svg", {512, 512}), large);
+
+    // other svgs don't mix in
+    EXPECT_FALSE(cache.nearest("b.svg", {32, 32}));
+
+    // gone once nobody holds them anymore
+    large.reset();
+    EXPECT_EQ(cache.nearest("a.svg", {100, 100}), medium);
+    EXPECT_EQ(cache.count("a.svg"), 2);
+}
+
+TEST(SvgRasterCache, fewPerSvg) {
+    Tests::Tricks::createBackendSupport();
+
+    CSvgRasterCache                   cache;
+    std::vector<SP<CAssetCacheEntry>> rasters;
+
+    for (const auto& s : {16.0, 24.0, 32.0, 48.0, 64.0, 96.0}) {
+        rasters.emplace_back(makeRaster({s, s}));
+        cache.add("a.svg", rasters.back());
+    }
+
+    EXPECT_EQ(cache.count("a.svg"), 4);
+
+    // 16 and 24 were the least recently used
+    EXPECT_EQ(cache.nearest("a.svg", {16, 16}), rasters[2]);
+
+    // the same size again replaces the old one
+    auto again = makeRaster({32, 32});
+    cache.add("a.svg", again);
+    EXPECT_EQ(cache.count("a.svg"), 4);
+    EXPECT_EQ(cache.nearest("a.svg", {32, 32}), again);
+}
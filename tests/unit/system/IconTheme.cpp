@@ -0,0 +1,194 @@
+#include <gtest/gtest.h>
+
+#include <system/IconTheme.hpp>
+#include <helpers/Memory.hpp>
+
+#include "../tricks/Tricks.hpp"
+
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <thread>
+#include <poll.h>
+#include <unistd.h>
+
+using namespace Hyprtoolkit;
+
+namespace {
+    // two base dirs, a theme spread over both of them inheriting another one, and hicolor
+    class CScratch {
+      public:
+        CScratch() {
+            m_dir = std::filesystem::temp_directory_path() / std::format("hyprtoolkit-icon-theme-test-{}", getpid());
+            std::filesystem::remove_all(m_dir);
+
+            m_user   = (m_dir / "user").string();
+            m_system = (m_dir / "system").string();
+            m_cache  = (m_dir / "cache").string();
+
+            write(m_system + "/MyTheme/index.theme", "[Icon Theme]\n"
+                                                     "Name=MyTheme\n"
+                                                     "Inherits=Parent\n"
+                                                     "Directories=16x16/apps,48x48/apps,scalable/apps\n"
+                                                     "ScaledDirectories=16x16@2/apps\n"
+                                                     "\n"
+                                                     "[16x16/apps]\nSize=16\nType=Fixed\n\n"
+                                                     "[16x16@2/apps]\nSize=16\nScale=2\nType=Fixed\n\n"
+                                                     "[48x48/apps]\nSize=48\nType=Fixed\n\n"
+                                                     "[scalable/apps]\nSize=64\nMinSize=56\nMaxSize=512\nType=Scalable\n");
+
+            write(m_system + "/Parent/index.theme", "[Icon Theme]\n"
+                                                    "Name=Parent\n"
+                                                    "Directories=32x32/apps\n"
+                                                    "\n"
+                                                    "[32x32/apps]\nSize=32\n");
+
+            write(m_system + "/hicolor/index.theme", "[Icon Theme]\n"
+                                                     "Name=Hicolor\n"
+                                                     "Directories=48x48/apps\n"
+                                                     "\n"
+                                                     "[48x48/apps]\nSize=48\nType=Threshold\n");
+
+            write(m_system + "/MyTheme/16x16/apps/app.png");
+            write(m_system + "/MyTheme/16x16@2/apps/app.png");
+            write(m_system + "/MyTheme/48x48/apps/app.png");
+            write(m_system + "/MyTheme/scalable/apps/app.svg");
+            write(m_user + "/MyTheme/48x48/apps/app.png");
+
+            write(m_system + "/MyTheme/16x16/apps/small.png");
+            write(m_system + "/MyTheme/48x48/apps/small.png");
+
+            write(m_system + "/Parent/32x32/apps/inherited.svg");
+            write(m_system + "/Parent/32x32/apps/app.svg");
+            write(m_system + "/hicolor/48x48/apps/fallback.png");
+            write(m_user + "/unthemed.png");
+            write(m_user + "/undecodable.xpm");
+        }
+
+        ~CScratch() {
+            std::filesystem::remove_all(m_dir);
+        }
+
+        void write(const std::string& path, const std::string& contents = "") {
+            std::filesystem::create_directories(std::filesystem::path{path}.parent_path());
+            std::ofstream ofs(path, std::ios::trunc);
+            ofs << contents;
+        }
+
+        UP<CIconThemeIndex> makeIndex(bool persist = false) {
+            return makeUnique<CIconThemeIndex>("MyTheme", std::vector<std::string>{m_user, m_system}, persist ? m_cache : "");
+        }
+
+        std::filesystem::path m_dir;
+        std::string           m_user, m_system, m_cache;
+    };
+}
+
+static std::string bestPath(const std::vector<SIconFile>& files, int size, int scale = 1) {
+    const auto BEST = CIconThemeIndex::bestFile(files, size, scale);
+    return BEST ? BEST->path : "";
+}
+
+TEST(IconTheme, inheritance) {
+    Tests::Tricks::createBackendSupport();
+
+    CScratch scratch;
+    auto     index = scratch.makeIndex();
+
+    EXPECT_EQ(index->themes(), (std::vector<std::string>{"MyTheme", "Parent", "hicolor"}));
+
+    // the first theme that has it wins, even if a parent has a better size
+    auto app = index->lookup("app");
+    ASSERT_EQ(app.size(), 5);
+    for (const auto& f : app) {
+        EXPECT_TRUE(f.path.starts_with(scratch.m_system + "/MyTheme") || f.path.starts_with(scratch.m_user + "/MyTheme"));
+    }
+
+    EXPECT_EQ(bestPath(index->lookup("inherited"), 32), scratch.m_system + "/Parent/32x32/apps/inherited.svg");
+    EXPECT_EQ(bestPath(index->lookup("fallback"), 48), scratch.m_system + "/hicolor/48x48/apps/fallback.png");
+
+    // not in any theme
+    auto unthemed = index->lookup("unthemed");
+    ASSERT_EQ(unthemed.size(), 1);
+    EXPECT_EQ(unthemed[0].format, ICON_FORMAT_PNG);
+    EXPECT_FALSE(unthemed[0].directory);
+    EXPECT_EQ(bestPath(unthemed, 48), scratch.m_user + "/unthemed.png");
+
+    EXPECT_TRUE(index->lookup("missing").empty());
+    EXPECT_TRUE(index->lookup("undecodable").empty());
+}
+
+TEST(IconTheme, sizes) {
+    Tests::Tricks::createBackendSupport();
+
+    CScratch   scratch;
+    auto       index = scratch.makeIndex();
+    const auto APP   = index->lookup("app");
+
+    EXPECT_EQ(bestPath(APP, 16), scratch.m_system + "/MyTheme/16x16/apps/app.png");
+    EXPECT_EQ(bestPath(APP, 16, 2), scratch.m_system + "/MyTheme/16x16@2/apps/app.png");
+
+    // the user's base dir comes first
+    EXPECT_EQ(bestPath(APP, 48), scratch.m_user + "/MyTheme/48x48/apps/app.png");
+
+    // in the scalable range
+    EXPECT_EQ(bestPath(APP, 128), scratch.m_system + "/MyTheme/scalable/apps/app.svg");
+    EXPECT_EQ(bestPath(APP, 1024), scratch.m_system + "/MyTheme/scalable/apps/app.svg");
+
+    // nothing made for it, the closest one
+    EXPECT_EQ(bestPath(APP, 20), scratch.m_system + "/MyTheme/16x16/apps/app.png");
+    EXPECT_EQ(bestPath(APP, 40), scratch.m_user + "/MyTheme/48x48/apps/app.png");
+
+    // 24 at 2x is 48 pixels, which is closer than 16 at 2x
+    EXPECT_EQ(bestPath(index->lookup("small"), 24, 2), scratch.m_system + "/MyTheme/48x48/apps/small.png");
+}
+
+TEST(IconTheme, persisted) {
+    Tests::Tricks::createBackendSupport();
+
+    CScratch scratch;
+
+    auto     cold = scratch.makeIndex(true);
+    EXPECT_FALSE(cold->loadedFromCache());
+
+    auto warm = scratch.makeIndex(true);
+    EXPECT_TRUE(warm->loadedFromCache());
+    EXPECT_EQ(warm->icons(), cold->icons());
+    EXPECT_EQ(bestPath(warm->lookup("app"), 16, 2), bestPath(cold->lookup("app"), 16, 2));
+    EXPECT_EQ(bestPath(warm->lookup("unthemed"), 16), scratch.m_user + "/unthemed.png");
+
+    // a directory changed, what was persisted can't be trusted anymore
+    scratch.write(scratch.m_system + "/Parent/32x32/apps/new.svg");
+
+    auto changed = scratch.makeIndex(true);
+    EXPECT_FALSE(changed->loadedFromCache());
+    EXPECT_EQ(changed->lookup("new").size(), 1);
+}
+
+TEST(IconTheme, invalidate) {
+    Tests::Tricks::createBackendSupport();
+
+    CScratch scratch;
+    auto     index = scratch.makeIndex();
+
+    EXPECT_TRUE(index->lookup("late").empty());
+
+    // icon dirs aren't watched, a miss notices them changing once it's allowed to look again
+    scratch.write(scratch.m_system + "/MyTheme/48x48/apps/late.png");
+    EXPECT_TRUE(index->lookup("late").empty());
+
+    std::this_thread::sleep_for(CIconThemeIndex::RECHECK_INTERVAL);
+    EXPECT_EQ(index->lookup("late").size(), 1);
+
+    // a theme getting installed is picked up by itself
+    scratch.write(scratch.m_user + "/Other/index.theme", "[Icon Theme]\nName=Other\n");
+
+    if (index->watchFD() >= 0) {
+        pollfd pfd = {.fd = index->watchFD(), .events = POLLIN};
+        ASSERT_EQ(poll(&pfd, 1, 1000), 1);
+        index->onWatchEvent();
+    } else
+        index->invalidate();
+
+    EXPECT_EQ(index->lookup("late").size(), 1);
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <renderer/RendererTexture.hpp>
+
+namespace Hyprtoolkit::Tests::Tricks {
+
+    // a texture that was never uploaded, for code that only cares about its size
+    class CFakeTexture : public IRendererTexture {
+      public:
+        CFakeTexture(const Hyprutils::Math::Vector2D& size) : m_size(size) {
+            ;
+        }
+
+        virtual size_t id() {
+            return 0;
+        }
+
+        virtual eTextureType type() {
+            return TEXTURE_GL;
+        }
+
+        virtual void destroy() {
+            ;
+        }
+
+        virtual eImageFitMode fitMode() {
+            return IMAGE_FIT_MODE_STRETCH;
+        }
+
+        virtual Hyprutils::Math::Vector2D size() {
+            return m_size;
+        }
+
+        virtual size_t bytes() {
+            return static_cast<size_t>(m_size.x) * static_cast<size_t>(m_size.y) * 4;
+        }
+
+      private:
+        Hyprutils::Math::Vector2D m_size;
+    };
+};
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <element/Element.hpp>
+
+namespace Hyprtoolkit::Tests::Tricks {
+
+    // a leaf of a given size, e.g. a text as far as layout cares. Counts how often it's measured.
+    class CSizedElement : public IElement {
+      public:
+        static SP<CSizedElement> create(const Hyprutils::Math::Vector2D& size, std::optional<Hyprutils::Math::Vector2D> min = std::nullopt) {
+            auto p        = SP<CSizedElement>(new CSizedElement());
+            p->impl->self = p;
+            p->m_size     = size;
+            p->m_min      = min;
+            return p;
+        }
+
+        virtual void paint() {
+            ;
+        }
+
+        virtual Hyprutils::Math::Vector2D size() {
+            return impl->position.size();
+        }
+
+        virtual std::optional<Hyprutils::Math::Vector2D> preferredSize(const Hyprutils::Math::Vector2D& parent) {
+            m_measured++;
+            return m_size;
+        }
+
+        virtual std::optional<Hyprutils::Math::Vector2D> minimumSize(const Hyprutils::Math::Vector2D& parent) {
+            m_measured++;
+            return m_min;
+        }
+
+        // like a text changing
+        void setSize(const Hyprutils::Math::Vector2D& size) {
+            m_size = size;
+            impl->invalidateMeasure();
+        }
+
+        Hyprutils::Math::Vector2D                m_size;
+        std::optional<Hyprutils::Math::Vector2D> m_min;
+        size_t                                   m_measured = 0;
+
+      private:
+        CSizedElement() = default;
+    };
+};
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <window/ToolkitWindow.hpp>
+
+namespace Hyprtoolkit::Tests::Tricks {
+
+    // a 1000x1000 window without a surface, frames are only scheduled
+    class CTestWindow : public IToolkitWindow {
+      public:
+        static SP<CTestWindow> create() {
+            auto p    = makeShared<CTestWindow>();
+            p->m_self = p;
+            p->m_damageRing.setSize({1000, 1000});
+
+            // forget the initial full damage
+            for (size_t i = 0; i <= DAMAGE_RING_PREVIOUS_LEN; ++i) {
+                p->m_damageRing.rotate();
+            }
+
+            return p;
+        }
+
+        virtual Hyprutils::Math::Vector2D pixelSize() {
+            return {1000, 1000};
+        }
+
+        virtual float scale() {
+            return 1.F;
+        }
+
+        virtual void close() {
+            ;
+        }
+
+        virtual void open() {
+            ;
+        }
+
+        virtual void render() {
+            ;
+        }
+
+        virtual SP<IWindow> openPopup(const SWindowCreationData& data) {
+            return nullptr;
+        }
+
+        virtual void setCursor(ePointerShape shape) {
+            ;
+        }
+    };
+};
@@ -3,6 +3,8 @@
 #include <core/InternalBackend.hpp>
 #include <palette/ConfigManager.hpp>
 #include <system/Icons.hpp>
+#include <system/Fonts.hpp>
+#include <core/Backend.hpp>
 
 using namespace Hyprtoolkit::Tests::Tricks;
 using namespace Hyprtoolkit::Tests;
@@ -15,4 +17,18 @@ void Tricks::createBackendSupport() {
     g_palette          = CPalette::palette();
     g_iconFactory      = SP<CSystemIconFactory>(new CSystemIconFactory());
     g_animationManager = makeShared<CHTAnimationManager>();
+    g_fontManager      = makeShared<CFontManager>();
+}
+
+void Tricks::createBackend() {
+    if (g_backend)
+        return;
+
+    createBackendSupport();
+
+    g_backend = makeShared<CBackend>();
+
+    // never let go of
+    static const auto* KEEP = new CSharedPointer<CBackend>(g_backend);
+    (void)KEEP;
 }
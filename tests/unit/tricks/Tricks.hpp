@@ -4,4 +4,8 @@ namespace Hyprtoolkit::Tests::Tricks {
 
     // doesn't make a backend but initializes needed stuff for elements to work
     void createBackendSupport();
+
+    // the above, plus a backend without a platform or a loop. Idles queue up, nothing runs them.
+    // Made once, and kept until the process exits, destroying it would take the other globals with it
+    void createBackend();
 };
\ No newline at end of file
@@ -0,0 +1,59 @@
+#include <gtest/gtest.h>
+
+#include <window/ToolkitWindow.hpp>
+#include <element/Element.hpp>
+#include <core/InternalBackend.hpp>
+#include <hyprtoolkit/element/Null.hpp>
+
+#include "../tricks/Tricks.hpp"
+#include "../tricks/TestWindow.hpp"
+
+using namespace Hyprtoolkit;
+using namespace Hyprutils::Math;
+using namespace Hyprtoolkit::Tests::Tricks;
+
+TEST(Window, batchOneFrame) {
+    Tests::Tricks::createBackend();
+
+    auto       window = CTestWindow::create();
+    const auto IDLES  = g_backend->m_idles.size();
+
+    g_backend->batch([&] {
+        window->damage(CRegion{CBox{0, 0, 10, 10}});
+
+        g_backend->batch([&] {
+            window->damage(CRegion{CBox{100, 100, 10, 10}});
+            window->scheduleFrame();
+        });
+
+        // the inner one doesn't let go
+        EXPECT_EQ(g_backend->m_idles.size(), IDLES);
+        EXPECT_FALSE(window->m_damageRing.hasChanged());
+    });
+
+    // one frame, with everything damaged in it
+    EXPECT_EQ(g_backend->m_idles.size(), IDLES + 1);
+
+    const auto DAMAGE = window->m_damageRing.getBufferDamage(1);
+    EXPECT_TRUE(DAMAGE.containsPoint({5, 5}));
+    EXPECT_TRUE(DAMAGE.containsPoint({105, 105}));
+    EXPECT_FALSE(DAMAGE.containsPoint({50, 50}));
+}
+
+TEST(Window, batchScrollMovesDamage) {
+    Tests::Tricks::createBackend();
+
+    auto window = CTestWindow::create();
+    auto area   = CNullBuilder::begin()->commence();
+
+    area->impl->position = {0, 0, 200, 200};
+
+    g_backend->batch([&] {
+        window->damage(CRegion{CBox{0, 50, 10, 10}});
+        window->damageScroll(area, {0, 20});
+    });
+
+    // painted again where the content went, not where it was copied from
+    const auto DAMAGE = window->m_damageRing.getBufferDamage(1);
+    EXPECT_TRUE(DAMAGE.containsPoint({5, 75}));
+}
@@ -0,0 +1,120 @@
+#include <gtest/gtest.h>
+
+#include <window/ToolkitWindow.hpp>
+#include <element/Element.hpp>
+#include <element/listView/ListView.hpp>
+#include <layout/Positioner.hpp>
+#include <hyprtoolkit/element/Null.hpp>
+#include <hyprtoolkit/element/ColumnLayout.hpp>
+#include <hyprtoolkit/element/ScrollArea.hpp>
+
+#include "../tricks/Tricks.hpp"
+#include "../tricks/TestWindow.hpp"
+
+using namespace Hyprtoolkit;
+using namespace Hyprutils::Math;
+using namespace Hyprtoolkit::Tests::Tricks;
+
+namespace {
+    SP<CScrollAreaElement> scrollArea(SP<CTestWindow> window) {
+        auto area = CScrollAreaBuilder::begin()->scrollY(true)->size({CDynamicSize::HT_SIZE_ABSOLUTE, CDynamicSize::HT_SIZE_ABSOLUTE, {200, 300}})->commence();
+        window->m_rootElement = area;
+        return area;
+    }
+
+    // laid out in the window, with nothing damaged yet
+    void show(SP<CTestWindow> window, SP<IElement> root) {
+        root->impl->breadthfirst([&window](SP<IElement> e) { e->impl->setWindow(window); });
+        g_positioner->position(root, {{}, {200, 300}});
+        window->m_damageRing.rotate();
+    }
+
+    SP<IElement> item() {
+        return CNullBuilder::begin()->size({CDynamicSize::HT_SIZE_ABSOLUTE, CDynamicSize::HT_SIZE_ABSOLUTE, {200, 30}})->commence();
+    }
+}
+
+TEST(Window, scrollCopiesWhatStays) {
+    Tests::Tricks::createBackend();
+
+    auto window = CTestWindow::create();
+    auto area   = scrollArea(window);
+    auto column = CColumnLayoutBuilder::begin()->size({CDynamicSize::HT_SIZE_PERCENT, CDynamicSize::HT_SIZE_AUTO, {1, 1}})->commence();
+    for (size_t i = 0; i < 100; ++i) {
+        column->addChild(item());
+    }
+    area->addChild(column);
+
+    show(window, area);
+
+    area->setScroll({0, 20});
+
+    // only what came into view is painted
+    auto damage = window->m_damageRing.getBufferDamage(1);
+    EXPECT_TRUE(damage.containsPoint({100, 290}));
+    EXPECT_FALSE(damage.containsPoint({100, 100}));
+    EXPECT_FALSE(damage.containsPoint({100, 279}));
+
+    // the rest is copied up from where it was
+    window->prepareScrollCopies(true);
+    ASSERT_EQ(window->m_scrollCopies.size(), 1);
+
+    const auto& COPY = window->m_scrollCopies.front();
+    EXPECT_EQ(COPY.box, CBox(0, 0, 200, 300));
+    EXPECT_EQ(COPY.delta, Vector2D(0, -20));
+    EXPECT_EQ(COPY.copyTo(1.F), CBox(0, 0, 200, 280));
+    EXPECT_EQ(COPY.copyFrom(1.F), CBox(0, 20, 200, 280));
+    EXPECT_EQ(COPY.copyTo(2.F), CBox(0, 0, 400, 560));
+    EXPECT_EQ(COPY.copyFrom(2.F), CBox(0, 40, 400, 560));
+
+    // scrolled again before that frame: it's one copy, by both
+    area->setScroll({0, 50});
+    ASSERT_EQ(window->m_scrollCopies.size(), 1);
+    EXPECT_EQ(window->m_scrollCopies.front().delta, Vector2D(0, -50));
+
+    // without a last frame to copy from, all of it is painted
+    window->prepareScrollCopies(false);
+    EXPECT_TRUE(window->m_scrollCopies.empty());
+
+    damage = window->m_damageRing.getBufferDamage(1);
+    EXPECT_TRUE(damage.containsPoint({100, 100}));
+}
+
+TEST(Window, scrollRelayoutDoesntRepaint) {
+    Tests::Tricks::createBackend();
+
+    size_t              count = 1000;
+    SListViewDataSource source{
+        .count  = [&count] { return count; },
+        .create = [] { return item(); },
+    };
+
+    auto window = CTestWindow::create();
+    auto area   = scrollArea(window);
+    auto list   = CListViewBuilder::begin()->source(source)->estimatedHeight(30)->overscan(2)->commence();
+    area->addChild(list);
+
+    show(window, area);
+
+    // the list lays out what's visible again, its items stay where the scroll moved them
+    area->setScroll({0, 30});
+    window->layoutPending();
+
+    auto damage = window->m_damageRing.getBufferDamage(1);
+    EXPECT_TRUE(damage.containsPoint({100, 290}));
+    EXPECT_FALSE(damage.containsPoint({100, 100}));
+
+    window->prepareScrollCopies(true);
+    EXPECT_EQ(window->m_scrollCopies.size(), 1);
+
+    // the list changing is painted, even right after a scroll
+    window->m_damageRing.rotate();
+    window->m_scrollCopies.clear();
+
+    area->setScroll({0, 60});
+    list->reload();
+    window->layoutPending();
+
+    damage = window->m_damageRing.getBufferDamage(1);
+    EXPECT_TRUE(damage.containsPoint({100, 100}));
+}